@@ -35,6 +35,7 @@
 #include <ignition/common/Console.hh>
 #include <ignition/math/graph/Graph.hh>
 #include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityComponentManagerSnapshot.hh"
 #include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/Types.hh"
 
@@ -114,6 +115,69 @@ namespace ignition
       /// \return Entity count.
       public: size_t EntityCount() const;
 
+      /// \brief Get the number of components on all entities, not counting
+      /// removed components.
+      /// \return Component count.
+      public: size_t ComponentCount() const;
+
+      /// \brief Get the number of views, which are created to cache the
+      /// entities matching each combination of component types queried with
+      /// functions such as Each.
+      /// \return View count.
+      public: size_t ViewCount() const;
+
+      /// \brief Get an immutable snapshot of all entities and components,
+      /// which can be read from other threads while this entity component
+      /// manager keeps changing, for example by rendering or logging threads.
+      ///
+      /// The first call copies all components. Afterwards, the latest snapshot
+      /// is kept, and the next one only copies the entities and components
+      /// which were created, removed or marked as changed with SetChanged
+      /// since then, sharing everything else. Changes to component data
+      /// which aren't marked with SetChanged are not seen. If nothing changed,
+      /// the latest snapshot is returned again.
+      ///
+      /// This can be called from a system's PostUpdate, also by several
+      /// systems at once, but not while the entity component manager is
+      /// being modified.
+      /// \return The snapshot.
+      public: std::shared_ptr<const EntityComponentManagerSnapshot>
+          Snapshot() const;
+
+      /// \brief Update this entity component manager to mirror a snapshot of
+      /// another one, so that a copy of the simulation can be read on another
+      /// thread with the usual API, such as Each, EachNew and EachRemoved.
+      ///
+      /// The changes seen by the previous call are cleared first: newly
+      /// created entities stop being new, entities marked for removal are
+      /// removed and components are marked as unchanged. Then only what
+      /// differs from the previously mirrored snapshot is copied. Entities
+      /// and components which were added are created, those which were
+      /// removed are marked for removal, and changed components are marked
+      /// as changed.
+      /// \param[in] _snapshot Snapshot of the entity component manager to
+      /// mirror.
+      /// \param[in] _source Entity component manager which took the
+      /// snapshot. If given, changed components get the same change state
+      /// they have in it, otherwise they're marked as OneTimeChange. Only
+      /// pass it if it isn't being modified during this call.
+      public: void Mirror(
+          const std::shared_ptr<const EntityComponentManagerSnapshot>
+          &_snapshot, const EntityComponentManager *_source = nullptr);
+
+      /// \brief Restore the entities and components of a snapshot taken from
+      /// this entity component manager, such as the state right after a world
+      /// was loaded.
+      ///
+      /// Entities created after the snapshot are marked for removal, and
+      /// entities removed after it are created again with the same IDs, as
+      /// new entities. Components are restored to their value in the
+      /// snapshot and marked as changed, and components created after it
+      /// are removed. This must be called between iterations, when there
+      /// are no pending removals.
+      /// \param[in] _snapshot Snapshot to restore.
+      public: void ResetTo(const EntityComponentManagerSnapshot &_snapshot);
+
       /// \brief Request an entity deletion. This will insert the request
       /// into a queue. The queue is processed toward the end of a simulation
       /// update step.
@@ -481,6 +545,46 @@ namespace ignition
                   bool(const Entity &_entity,
                        ComponentTypeTs *...)>>::type _f);
 
+      /// \brief Same as Each(), but skips entities which have a
+      /// components::Sleeping component set to true. This is useful for
+      /// systems which only need to process entities that are moving.
+      /// It iterates over the same view as Each(), so newly created entities
+      /// and entities marked for removal are included in the same way.
+      /// Entities without a components::Sleeping component, such as ones
+      /// created since the last physics step, are considered awake. The
+      /// Sleeping component is looked up for each matching entity, so this
+      /// is only cheaper than Each() when the callback does enough work.
+      /// \param[in] _f Callback function to be called for each matching entity
+      /// which is awake.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      /// \sa Each
+      public: template<typename ...ComponentTypeTs>
+              void EachAwake(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       const ComponentTypeTs *...)>>::type _f) const;
+
+      /// \brief Same as Each(), but skips entities which have a
+      /// components::Sleeping component set to true. This is useful for
+      /// systems which only need to process entities that are moving.
+      /// It iterates over the same view as Each(), so newly created entities
+      /// and entities marked for removal are included in the same way.
+      /// Entities without a components::Sleeping component, such as ones
+      /// created since the last physics step, are considered awake. The
+      /// Sleeping component is looked up for each matching entity, so this
+      /// is only cheaper than Each() when the callback does enough work.
+      /// \param[in] _f Callback function to be called for each matching entity
+      /// which is awake.
+      /// \tparam ComponentTypeTs All the desired mutable component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      /// \sa Each
+      public: template<typename ...ComponentTypeTs>
+              void EachAwake(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       ComponentTypeTs *...)>>::type _f);
+
       /// \brief Call a function for each parameter in a pack.
       /// \param[in] _f Function to be called.
       /// \param[in] _components Parameters which should be passed to the
@@ -596,6 +700,16 @@ namespace ignition
       public: std::unordered_set<ComponentTypeId>
           ComponentTypesWithPeriodicChanges() const;
 
+      /// \brief Get how many times a component of the given type was
+      /// created, removed or marked as changed. The count only grows, unlike
+      /// the changes which are cleared at the end of every iteration, so
+      /// comparing it with a previous value tells whether there were changes
+      /// in between, at any point of any iteration.
+      /// \param[in] _typeId Component type ID.
+      /// \return Number of changes to components of that type.
+      public: uint64_t ComponentChangeCount(
+                  const ComponentTypeId _typeId) const;
+
       /// \brief Set the absolute state of the ECM from a serialized message.
       /// Entities / components that are in the new state but not in the old
       /// one will be created.
@@ -638,6 +752,24 @@ namespace ignition
       /// responsibility of the caller to timestamp it before use.
       public: void ChangedState(msgs::SerializedStateMap &_state) const;
 
+      /// \brief Get a message with the serialized state of the given entities
+      /// and components that are changing in the current iteration.
+      ///
+      /// This is equivalent to ChangedState, but components and entities which
+      /// are filtered out are never serialized, which makes it cheaper than
+      /// filtering the resulting message.
+      ///
+      /// \param[out] _state New serialized state.
+      /// \param[in] _entities Entities to be serialized. Leave empty to get
+      /// all changed entities.
+      /// \param[in] _types Type ID of components to be serialized. Leave empty
+      /// to get all changed components.
+      /// \details The header of the message will not be populated, it is the
+      /// responsibility of the caller to timestamp it before use.
+      public: void ChangedState(msgs::SerializedStateMap &_state,
+                  const std::unordered_set<Entity> &_entities,
+                  const std::unordered_set<ComponentTypeId> &_types) const;
+
       /// \brief Set the absolute state of the ECM from a serialized message.
       /// Entities / components that are in the new state but not in the old
       /// one will be created.
@@ -801,6 +933,13 @@ namespace ignition
       /// otherwise.
       private: bool LockAddingEntitiesToViews() const;
 
+      /// \brief Get a snapshot of all entities and components, copying all of
+      /// them. Unlike Snapshot, this doesn't track changes for the next
+      /// snapshot, so it has no cost afterwards.
+      /// \return The snapshot.
+      private: std::shared_ptr<const EntityComponentManagerSnapshot>
+          FullSnapshot() const;
+
       // Make runners friends so that they can manage entity creation and
       // removal. This should be safe since runners are internal
       // to Gazebo.
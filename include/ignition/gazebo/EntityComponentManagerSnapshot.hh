@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ENTITYCOMPONENTMANAGERSNAPSHOT_HH_
+#define IGNITION_GAZEBO_ENTITYCOMPONENTMANAGERSNAPSHOT_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/Types.hh>
+#include <ignition/gazebo/components/Component.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN EntityComponentManagerSnapshotPrivate;
+
+    /// \class EntityComponentManagerSnapshot EntityComponentManagerSnapshot.hh
+    /// ignition/gazebo/EntityComponentManagerSnapshot.hh
+    /// \brief Immutable copy of all entities and components of an
+    /// EntityComponentManager at a given point in time, created with
+    /// EntityComponentManager::Snapshot.
+    ///
+    /// A snapshot can be held and read from any thread while simulation
+    /// continues, without locking. Consecutive snapshots share the entities
+    /// and components which didn't change between them, so creating a
+    /// snapshot only copies what changed since the previous one.
+    class IGNITION_GAZEBO_VISIBLE EntityComponentManagerSnapshot
+    {
+      /// \brief Destructor
+      public: ~EntityComponentManagerSnapshot();
+
+      /// \brief Version of the snapshot. It's incremented every time the
+      /// entity component manager creates a snapshot with different content.
+      /// \return Snapshot version.
+      public: uint64_t Version() const;
+
+      /// \brief Number of entities in the snapshot.
+      /// \return Entity count.
+      public: size_t EntityCount() const;
+
+      /// \brief Check whether an entity is in the snapshot.
+      /// \param[in] _entity Entity to check.
+      /// \return True if the entity exists.
+      public: bool HasEntity(const Entity _entity) const;
+
+      /// \brief Get the parent of an entity.
+      /// \param[in] _entity Entity whose parent we want.
+      /// \return The parent entity, or kNullEntity if it has none.
+      public: Entity ParentEntity(const Entity _entity) const;
+
+      /// \brief Get the types of all components of an entity.
+      /// \param[in] _entity Entity to check.
+      /// \return Component type IDs.
+      public: std::unordered_set<ComponentTypeId> ComponentTypes(
+                  const Entity _entity) const;
+
+      /// \brief Get a component of an entity.
+      /// \param[in] _entity Entity which has the component.
+      /// \return Pointer to the component, or nullptr if the entity doesn't
+      /// have it. The pointer is valid as long as the snapshot is.
+      public: template<typename ComponentTypeT>
+              const ComponentTypeT *Component(const Entity _entity) const
+      {
+        return static_cast<const ComponentTypeT *>(
+            this->ComponentImplementation(_entity, ComponentTypeT::typeId));
+      }
+
+      /// \brief Get a component of an entity by type ID.
+      /// \param[in] _entity Entity which has the component.
+      /// \param[in] _type Component type ID.
+      /// \return Pointer to the component, or nullptr if the entity doesn't
+      /// have it. The pointer is valid as long as the snapshot is.
+      public: const components::BaseComponent *ComponentImplementation(
+                  const Entity _entity, const ComponentTypeId _type) const;
+
+      /// \brief Get all entities, in ascending order.
+      /// \return All entities in the snapshot.
+      public: std::vector<Entity> Entities() const;
+
+      /// \brief Prevents deduction of template parameters from the callback
+      /// of Each, so they can be listed explicitly.
+      private: template <typename T>
+               struct Identity
+               {
+                 using type = T;
+               };
+
+      /// \brief Call a function for each entity which has all the given
+      /// components, in ascending entity order.
+      /// \param[in] _f Function to call. Return false to stop iterating.
+      /// \tparam ComponentTypeTs All the desired component types.
+      public: template<typename ...ComponentTypeTs>
+              void Each(typename Identity<std::function<
+                  bool(const Entity &_entity,
+                       const ComponentTypeTs *...)>>::type _f) const
+      {
+        this->EachEntity([&](const Entity _entity)
+        {
+          const std::tuple<const ComponentTypeTs *...> comps{
+              this->Component<ComponentTypeTs>(_entity)...};
+          bool hasAll{true};
+          std::apply([&](const auto *..._comp)
+          {
+            hasAll = ((nullptr != _comp) && ...);
+          }, comps);
+          if (!hasAll)
+            return true;
+          return std::apply([&](const auto *..._comp)
+          {
+            return _f(_entity, _comp...);
+          }, comps);
+        });
+      }
+
+      /// \brief Call a function for each entity, in ascending order.
+      /// \param[in] _f Function to call. Return false to stop iterating.
+      private: void EachEntity(
+                   const std::function<bool(const Entity)> &_f) const;
+
+      /// \brief Constructor, snapshots are created by the entity component
+      /// manager.
+      private: EntityComponentManagerSnapshot();
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<EntityComponentManagerSnapshotPrivate> dataPtr;
+
+      // Snapshots are created by the entity component manager
+      friend class EntityComponentManager;
+    };
+    }
+  }
+}
+#endif
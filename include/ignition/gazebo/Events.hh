@@ -17,6 +17,8 @@
 #ifndef IGNITION_GAZEBO_EVENTS_HH_
 #define IGNITION_GAZEBO_EVENTS_HH_
 
+#include <memory>
+
 #include <sdf/Element.hh>
 
 #include <ignition/common/Event.hh>
@@ -30,6 +32,9 @@ namespace ignition
   {
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class SimTimer;
+
     /// \brief Namespace for all events. Refer to the EventManager class for
     /// more information about events.
     namespace events
@@ -58,6 +63,16 @@ namespace ignition
       /// the entity, which may contain multiple `<plugin>` tags.
       using LoadPlugins = common::EventT<void(Entity, sdf::ElementPtr),
           struct LoadPluginsTag>;
+
+      /// \brief Event used to add a sim time timer to simulation. The timer
+      /// runs until all shared pointers to it are released. See SimTimer.
+      ///
+      /// For example:
+      /// \code
+      /// eventManager.Emit<ignition::gazebo::events::AddSimTimer>(timer);
+      /// \endcode
+      using AddSimTimer = common::EventT<void(std::shared_ptr<SimTimer>),
+          struct AddSimTimerTag>;
       }
     }  // namespace events
   }  // namespace gazebo
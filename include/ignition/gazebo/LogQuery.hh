@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_LOGQUERY_HH_
+#define IGNITION_GAZEBO_LOGQUERY_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Export.hh"
+#include "ignition/gazebo/Types.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN LogQueryPrivate;
+
+    /// \class LogQuery LogQuery.hh ignition/gazebo/LogQuery.hh
+    /// \brief Extract component time series from a state log recorded by
+    /// the LogRecord system, without playing it back through a server.
+    ///
+    /// Both state log formats are supported: `state.mlog`, written by the
+    /// `mmap` state backend or when compressing, and `state.tlog`. Opening a
+    /// log only loads the time of each state message, without parsing any
+    /// of them. For `state.mlog`, that's the index stored in the file, so
+    /// messages are accessed at random without scanning the log.
+    ///
+    /// Messages are parsed lazily. Entity names are resolved by parsing
+    /// states from the start of the log only until the name is found, and
+    /// queries parse each state in their time range once, only deserializing
+    /// the requested components instead of setting the full state on an
+    /// entity-component manager.
+    ///
+    /// For example, to print the pose of a model over time:
+    ///
+    ///     LogQuery query("/path/to/log");
+    ///     query.WriteCsv(std::cout, "my_model", {"Pose"});
+    class IGNITION_GAZEBO_VISIBLE LogQuery
+    {
+      /// \brief Callback for each changed component.
+      /// \param[in] _simTime Simulation time of the iteration.
+      /// \param[in] _component Deserialized component.
+      /// \return True to continue iterating, false to stop.
+      public: using Callback = std::function<bool(
+          const std::chrono::steady_clock::duration &_simTime,
+          const components::BaseComponent &_component)>;
+
+      /// \brief Constructor. Opens and indexes the log.
+      /// \param[in] _path Path to a log directory, or to its state.mlog or
+      /// state.tlog file. If a directory has both, state.mlog is used.
+      public: explicit LogQuery(const std::string &_path);
+
+      /// \brief Destructor
+      public: ~LogQuery();
+
+      /// \brief Whether the log was opened and indexed successfully.
+      /// \return True if valid.
+      public: bool Valid() const;
+
+      /// \brief Number of state messages in the log.
+      /// \return Message count.
+      public: std::size_t Count() const;
+
+      /// \brief Simulation time of a state message.
+      /// \param[in] _index Index of the message, less than Count().
+      /// \return Simulation time, or zero if out of range.
+      public: std::chrono::steady_clock::duration Time(
+          std::size_t _index) const;
+
+      /// \brief Find the first state message at or after a given time.
+      /// \param[in] _time Simulation time.
+      /// \return Index of the message, or Count() if there are no messages
+      /// at or after that time.
+      public: std::size_t LowerBound(
+          const std::chrono::steady_clock::duration &_time) const;
+
+      /// \brief Find an entity given its name.
+      /// \param[in] _name Scoped name without the world, such as
+      /// `model::link`, or an unscoped name. If an unscoped name is shared by
+      /// multiple entities, the first one created is returned.
+      /// \return The entity, or kNullEntity if not found.
+      public: Entity EntityByName(const std::string &_name) const;
+
+      /// \brief Get the scoped name of an entity, without the world.
+      /// \param[in] _entity Entity
+      /// \return Scoped name, or empty if the entity isn't in the log.
+      public: std::string ScopedName(const Entity _entity) const;
+
+      /// \brief Get the type ID of a component given its name.
+      /// \param[in] _name Component name, with or without the
+      /// `ign_gazebo_components.` prefix.
+      /// \return Type ID, or kComponentTypeIdInvalid if no component with that
+      /// name has been registered.
+      public: static ComponentTypeId ComponentTypeIdFromName(
+          const std::string &_name);
+
+      /// \brief Call a function for every recorded change of the given
+      /// components of an entity, in chronological order.
+      /// \param[in] _entity Entity to query.
+      /// \param[in] _types Component types to query.
+      /// \param[in] _callback Function called for each changed component.
+      /// \return False if the log isn't valid or a component type is unknown.
+      public: bool Each(const Entity _entity,
+          const std::vector<ComponentTypeId> &_types,
+          const Callback &_callback) const;
+
+      /// \brief Call a function for every recorded change of the given
+      /// components of an entity within a time range, in chronological
+      /// order. Only the states in the range are parsed.
+      /// \param[in] _entity Entity to query.
+      /// \param[in] _types Component types to query.
+      /// \param[in] _start Start of the range, inclusive.
+      /// \param[in] _end End of the range, inclusive.
+      /// \param[in] _callback Function called for each changed component.
+      /// \return False if the log isn't valid or a component type is unknown.
+      public: bool Each(const Entity _entity,
+          const std::vector<ComponentTypeId> &_types,
+          const std::chrono::steady_clock::duration &_start,
+          const std::chrono::steady_clock::duration &_end,
+          const Callback &_callback) const;
+
+      /// \brief Write the time series of components of an entity as comma
+      /// separated values. Each row holds the simulation time in seconds, the
+      /// component name and the component's values.
+      ///
+      /// Components holding numeric types such as poses, vectors, scalars
+      /// and joint states are supported.
+      /// \param[out] _out Stream to write to.
+      /// \param[in] _entityName Name of the entity, see EntityByName.
+      /// \param[in] _componentNames Names of the components to write.
+      /// \return True if successful.
+      public: bool WriteCsv(std::ostream &_out,
+          const std::string &_entityName,
+          const std::vector<std::string> &_componentNames) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogQueryPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_MAPPEDSTATELOG_HH_
+#define IGNITION_GAZEBO_MAPPEDSTATELOG_HH_
+
+#include <google/protobuf/message_lite.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN MappedStateLogWriterPrivate;
+    class IGNITION_GAZEBO_HIDDEN StreamedStateLogWriterPrivate;
+    class IGNITION_GAZEBO_HIDDEN MappedStateLogReaderPrivate;
+
+    /// \brief Entry of the index stored at the end of a mapped state log.
+    struct MappedStateLogIndexEntry
+    {
+      /// \brief Sim time of the state, in nanoseconds.
+      int64_t time;
+
+      /// \brief Offset of the record from the start of the file.
+      uint64_t offset;
+    };
+
+    /// \class MappedStateLogWriter MappedStateLog.hh
+    /// ignition/gazebo/MappedStateLog.hh
+    /// \brief Writes serialized states to an append-only memory-mapped file.
+    /// This is the format of the `state.mlog` files written by the LogRecord
+    /// system, and read by the LogPlayback system and LogQuery.
+    ///
+    /// The file starts with a header, followed by one record per state, each
+    /// holding its sim time, size and serialized message. When the writer is
+    /// closed, an index with the time and offset of each record is appended,
+    /// so that readers can seek without parsing records. If the writer is not
+    /// closed cleanly, readers rebuild the index by scanning the records.
+    ///
+    /// Messages are serialized straight into the mapped memory, so appending
+    /// doesn't need any system calls unless the file has to grow.
+    ///
+    /// \note Only supported on POSIX systems.
+    class IGNITION_GAZEBO_VISIBLE MappedStateLogWriter
+    {
+      /// \brief Constructor
+      public: MappedStateLogWriter();
+
+      /// \brief Destructor. Closes the file.
+      public: ~MappedStateLogWriter();
+
+      /// \brief Create a new log file, overwriting any existing file.
+      /// \param[in] _path Path to the file.
+      /// \return True if successful.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Whether the file is open for writing.
+      /// \return True if open.
+      public: bool IsOpen() const;
+
+      /// \brief Append a message to the log.
+      /// \param[in] _time Sim time of the message. Must not be earlier than the
+      /// time of the previous message.
+      /// \param[in] _msg Message to append.
+      /// \return True if successful.
+      public: bool Append(const std::chrono::steady_clock::duration &_time,
+          const google::protobuf::MessageLite &_msg);
+
+      /// \brief Write the index and close the file.
+      /// \return True if successful.
+      public: bool Close();
+
+      /// \brief Make sure the mapping can fit a number of extra bytes, growing
+      /// the file if needed.
+      /// \param[in] _bytes Number of bytes to be written.
+      /// \return True if successful.
+      private: bool Reserve(std::size_t _bytes);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MappedStateLogWriterPrivate> dataPtr;
+    };
+
+    /// \class StreamedStateLogWriter MappedStateLog.hh
+    /// ignition/gazebo/MappedStateLog.hh
+    /// \brief Writes serialized states in the same format as
+    /// MappedStateLogWriter, but hands the bytes to a sink in chunks instead
+    /// of writing them to a mapped file. This is used to compress the state
+    /// while it's recorded. Once the chunks are written to a file, in order,
+    /// it can be read with MappedStateLogReader.
+    class IGNITION_GAZEBO_VISIBLE StreamedStateLogWriter
+    {
+      /// \brief Function that receives each chunk of the log, in order.
+      /// It returns false if the chunk couldn't be written.
+      public: using Sink = std::function<bool(std::string &&_chunk)>;
+
+      /// \brief Constructor. Writes the header of the log.
+      /// \param[in] _sink Function that receives the chunks.
+      /// \param[in] _chunkSize Chunks are handed to the sink once they reach
+      /// this many bytes.
+      public: explicit StreamedStateLogWriter(Sink _sink,
+          std::size_t _chunkSize = 4u * 1024u * 1024u);
+
+      /// \brief Destructor. Closes the log.
+      public: ~StreamedStateLogWriter();
+
+      /// \brief Append a message to the log.
+      /// \param[in] _time Sim time of the message. Must not be earlier than the
+      /// time of the previous message.
+      /// \param[in] _msg Message to append.
+      /// \return True if successful.
+      public: bool Append(const std::chrono::steady_clock::duration &_time,
+          const google::protobuf::MessageLite &_msg);
+
+      /// \brief Write the index and hand the last chunk to the sink.
+      /// \return True if successful and all chunks were written.
+      public: bool Close();
+
+      /// \brief Hand the current chunk to the sink.
+      /// \return True if successful.
+      private: bool Flush();
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StreamedStateLogWriterPrivate> dataPtr;
+    };
+
+    /// \class MappedStateLogReader MappedStateLog.hh
+    /// ignition/gazebo/MappedStateLog.hh
+    /// \brief Reads serialized states from a file written by
+    /// MappedStateLogWriter. The whole file is memory-mapped, so seeking is a
+    /// binary search over the index and messages are parsed directly from the
+    /// mapped memory.
+    class IGNITION_GAZEBO_VISIBLE MappedStateLogReader
+    {
+      /// \brief Constructor
+      public: MappedStateLogReader();
+
+      /// \brief Destructor. Unmaps the file.
+      public: ~MappedStateLogReader();
+
+      /// \brief Open a log file for reading.
+      /// \param[in] _path Path to the file.
+      /// \return True if successful.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Number of messages in the log.
+      /// \return Message count.
+      public: std::size_t Count() const;
+
+      /// \brief Sim time of a message.
+      /// \param[in] _index Index of the message, less than Count().
+      /// \return Sim time.
+      public: std::chrono::steady_clock::duration Time(
+          std::size_t _index) const;
+
+      /// \brief Parse a message.
+      /// \param[in] _index Index of the message, less than Count().
+      /// \param[out] _msg Message to parse into.
+      /// \return True if successful.
+      public: bool Message(std::size_t _index,
+          google::protobuf::MessageLite &_msg) const;
+
+      /// \brief Find the first message at or after a given time.
+      /// \param[in] _time Sim time.
+      /// \return Index of the message, or Count() if there are no messages at
+      /// or after that time.
+      public: std::size_t LowerBound(
+          const std::chrono::steady_clock::duration &_time) const;
+
+      /// \brief Sim time of the first message, or zero if empty.
+      /// \return Start time.
+      public: std::chrono::steady_clock::duration StartTime() const;
+
+      /// \brief Sim time of the last message, or zero if empty.
+      /// \return End time.
+      public: std::chrono::steady_clock::duration EndTime() const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MappedStateLogReaderPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -72,6 +72,14 @@ namespace ignition
     /// a world from the command line. If simulation starts running, the
     /// GUI client may miss the first few simulation iterations.
     ///
+    /// An SDF file may contain multiple worlds. Each world is independent,
+    /// with its own entity-component manager and systems, including its own
+    /// physics engine instance. When there's more than one world, each one is
+    /// stepped in its own thread, so batches of worlds can be simulated
+    /// concurrently in a single process, sharing loaded plugin libraries and
+    /// the transport node. Functions which take a `_worldIndex` act on a
+    /// single world.
+    ///
     /// ## Services
     ///
     /// The following are services provided by the Server.
@@ -109,6 +117,16 @@ namespace ignition
     /// 3. `/gazebo/resource_paths` : ignition::msgs::StringMsg_V
     ///   + Updated list of resource paths.
     ///
+    /// 4. `/world/<world_name>/performance` : ignition::msgs::Param_V
+    ///   + Published once per second of wall time, with the wall time taken
+    ///     by each system's PreUpdate, Update and PostUpdate in that second.
+    ///     The first parameter has the world's entity, component and view
+    ///     counts and the timing of whole steps. Each following parameter
+    ///     is one system. Each callback has `<callback>_count`, `_mean_us`,
+    ///     `_max_us` and `_total_us` values, and `_bucket_<i>` values with
+    ///     the number of calls shorter than 2^i microseconds and at least
+    ///     2^(i-1) microseconds. Try `ign gazebo --performance`.
+    ///
     class IGNITION_GAZEBO_VISIBLE Server
     {
       /// \brief Construct the server using the parameters specified in a
@@ -333,6 +333,60 @@ namespace ignition
       /// \return True if headless mode is enable, false otherwise.
       public: bool HeadlessRendering() const;
 
+      /// \brief Set batch mode. In batch mode, simulation runs as fast as
+      /// possible: the update rate and real time factor are ignored, no time
+      /// is spent computing sleep times, statistics and clock messages are
+      /// published at a fixed wall clock rate instead of on every iteration,
+      /// and the throughput of each run is printed when it finishes. This is
+      /// meant for running a fixed number of iterations, such as when
+      /// generating data or training.
+      /// \param[in] _batch True to enable batch mode.
+      public: void SetBatchMode(const bool _batch);
+
+      /// \brief Get whether batch mode is enabled.
+      /// \return True if batch mode is enabled.
+      /// \sa SetBatchMode
+      public: bool BatchMode() const;
+
+      /// \brief Set precise pacing. By default, each iteration sleeps for
+      /// the remainder of the update period, corrected by an average of how
+      /// much previous sleeps overshot. With precise pacing, iterations are
+      /// scheduled at absolute deadlines. The runner sleeps until shortly
+      /// before each deadline and spins for the rest. This uses more CPU
+      /// but reduces jitter at high update rates, such as 1 kHz. Jitter and
+      /// overrun statistics are added to the world statistics messages.
+      /// \param[in] _precise True to enable precise pacing.
+      public: void SetPrecisePacing(const bool _precise);
+
+      /// \brief Get whether precise pacing is enabled.
+      /// \return True if precise pacing is enabled.
+      /// \sa SetPrecisePacing
+      public: bool PrecisePacing() const;
+
+      /// \brief Set pipelined PostUpdate. By default, each iteration waits
+      /// for all PostUpdate calls to finish before the next one starts. In
+      /// pipelined mode, systems which only implement PostUpdate read a
+      /// mirror of the entity component manager, while the next iteration's
+      /// PreUpdate and Update run on the original, so slow read-only systems
+      /// such as broadcasters overlap with physics. Systems which also
+      /// implement PreUpdate or Update keep reading the original, and their
+      /// PostUpdate finishes within the iteration.
+      ///
+      /// The mirror is updated on every iteration from a snapshot of the
+      /// original, see EntityComponentManager::Snapshot, so pipelined systems
+      /// see the entities and components which were created, removed or
+      /// marked as changed with EntityComponentManager::SetChanged. They
+      /// must not access the entity component manager passed to Configure.
+      ///
+      /// Pipelining isn't supported with distributed simulation.
+      /// \param[in] _pipelined True to enable pipelined PostUpdate.
+      public: void SetPipelinedPostUpdate(const bool _pipelined);
+
+      /// \brief Get whether pipelined PostUpdate is enabled.
+      /// \return True if pipelined PostUpdate is enabled.
+      /// \sa SetPipelinedPostUpdate
+      public: bool PipelinedPostUpdate() const;
+
       /// \brief Set the render engine server plugin library.
       /// \param[in] _renderEngineServer File containing render engine library.
       public: void SetRenderEngineServer(
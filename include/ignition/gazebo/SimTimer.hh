@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SIMTIMER_HH_
+#define IGNITION_GAZEBO_SIMTIMER_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/EntityComponentManager.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/Types.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN SimTimerPrivate;
+    class SimTimerWheel;
+
+    /// \class SimTimer SimTimer.hh ignition/gazebo/SimTimer.hh
+    /// \brief A callback called by the simulation runner after a period of
+    /// sim time, once or periodically. This replaces keeping track of the
+    /// sim time of the last publication in every system which publishes at a
+    /// given rate, and makes sure all timers with the same period fire on the
+    /// same iterations.
+    ///
+    /// Timers are added to the simulation with the events::AddSimTimer event,
+    /// and run until the last shared pointer to them is released. The first
+    /// expiration is one period after the sim time of the iteration during
+    /// which the timer was added, or of the last iteration before the
+    /// simulation was paused if it was added while paused. Callbacks are
+    /// called on the simulation thread at the beginning of the first
+    /// iteration whose sim time is at least the expiration time, before the
+    /// systems' PreUpdate, and never while paused. If sim time jumps back,
+    /// for example after a reset, all timers restart.
+    ///
+    /// For example, to publish at 10 Hz:
+    /// \code
+    /// this->timer = std::make_shared<SimTimer>(100ms,
+    ///     [this](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    ///     {
+    ///       this->Publish(_info, _ecm);
+    ///     });
+    /// _eventMgr.Emit<events::AddSimTimer>(this->timer);
+    /// \endcode
+    class IGNITION_GAZEBO_VISIBLE SimTimer
+    {
+      /// \brief Timer callback.
+      public: using Callback = std::function<void(const UpdateInfo &_info,
+                  EntityComponentManager &_ecm)>;
+
+      /// \brief Constructor
+      /// \param[in] _period Sim time between the time the timer is added and
+      /// its expiration, and between expirations of periodic timers.
+      /// \param[in] _callback Function called when the timer expires.
+      /// \param[in] _repeat True to call the function periodically, false to
+      /// call it only once.
+      public: SimTimer(const std::chrono::steady_clock::duration &_period,
+                  Callback _callback, bool _repeat = true);
+
+      /// \brief Destructor
+      public: ~SimTimer();
+
+      /// \brief Get the period.
+      /// \return Sim time between expirations.
+      public: std::chrono::steady_clock::duration Period() const;
+
+      /// \brief Whether the timer is periodic.
+      /// \return True if the timer fires periodically.
+      public: bool Repeat() const;
+
+      /// \brief Number of times the timer fired.
+      /// \return Number of calls of the callback.
+      public: uint64_t FireCount() const;
+
+      /// \brief Call the callback.
+      /// \param[in] _info Update info of the iteration.
+      /// \param[in] _ecm Entity component manager.
+      private: void Fire(const UpdateInfo &_info,
+                   EntityComponentManager &_ecm);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SimTimerPrivate> dataPtr;
+
+      // Timers are fired by the timer wheel
+      friend class SimTimerWheel;
+    };
+    }
+  }
+}
+#endif
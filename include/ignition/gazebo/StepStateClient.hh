@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_STEPSTATECLIENT_HH_
+#define IGNITION_GAZEBO_STEPSTATECLIENT_HH_
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/Types.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN StepStateClientPrivate;
+
+    /// \class StepStateClient StepStateClient.hh
+    /// ignition/gazebo/StepStateClient.hh
+    /// \brief Client of a world's step and state service,
+    /// `/world/<world_name>/control/step_state`, which runs a number of
+    /// iterations and replies with the state at the end of the last one.
+    /// This takes a single round trip per step, instead of a world control
+    /// request followed by a state request, and the returned state is
+    /// guaranteed to match the iterations which were run.
+    ///
+    /// Simulation is paused once the iterations are done. The state can be
+    /// restricted to some entities and component types, which keeps the
+    /// replies small for large worlds.
+    ///
+    /// \code
+    /// StepStateClient client("default");
+    /// client.SetComponentTypes({components::Pose::typeId});
+    /// auto res = client.Step(100);
+    /// if (res)
+    ///   std::cout << res->stats().iterations() << std::endl;
+    /// \endcode
+    class IGNITION_GAZEBO_VISIBLE StepStateClient
+    {
+      /// \brief Constructor
+      /// \param[in] _worldName Name of the world to step.
+      public: explicit StepStateClient(const std::string &_worldName);
+
+      /// \brief Destructor
+      public: ~StepStateClient();
+
+      /// \brief Set the entities whose state is returned.
+      /// \param[in] _entities Entities, empty for all entities.
+      public: void SetEntities(const std::unordered_set<Entity> &_entities);
+
+      /// \brief Set the types of the components whose state is returned.
+      /// \param[in] _types Component type IDs, empty for all types.
+      public: void SetComponentTypes(
+                  const std::unordered_set<ComponentTypeId> &_types);
+
+      /// \brief Run iterations and get the state at the end of the last one.
+      /// This blocks until the iterations are done.
+      /// \param[in] _iterations Number of iterations to run. Zero returns the
+      /// current state without stepping.
+      /// \param[in] _timeout Maximum time to wait for the reply, in
+      /// milliseconds. It's sent to the server, which cancels the iterations
+      /// which didn't run yet once it expires.
+      /// \return World statistics and state after the iterations, or nullopt
+      /// if the request failed or timed out. Requests fail when simulation
+      /// isn't running.
+      public: std::optional<msgs::SerializedStepMap> Step(
+                  uint64_t _iterations, unsigned int _timeout = 5000u);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepStateClientPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -23,6 +23,7 @@
 #include <ignition/gazebo/EntityComponentManager.hh>
 #include <ignition/gazebo/EventManager.hh>
 #include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/SystemWakeUp.hh>
 #include <ignition/gazebo/Types.hh>
 
 #include <sdf/Element.hh>
@@ -120,6 +121,40 @@ namespace ignition
       public: virtual void PostUpdate(const UpdateInfo &_info,
                                       const EntityComponentManager &_ecm) = 0;
     };
+
+    /// \class ISystemWakeUp ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface for a system whose PreUpdate only needs to be called
+    /// when something happens, such as a message arriving, a component
+    /// changing or a sim time timer firing, instead of on every iteration.
+    /// See SystemWakeUp.
+    class ISystemWakeUp {
+      /// \brief Declare when the system needs PreUpdate. Called once, right
+      /// after Configure.
+      /// \param[in] _wakeUp Wake-up conditions of the system. It may be kept
+      /// by the system, for example to call Wake from a transport callback,
+      /// or to set new timers from PreUpdate.
+      public: virtual void ConfigureWakeUp(
+                  const std::shared_ptr<SystemWakeUp> &_wakeUp) = 0;
+    };
+
+    /// \class ISystemReset ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface for a system that can be reset along with the world.
+    ///
+    /// When the world is reset, all entities and components are restored to
+    /// their state right after the world was loaded, sim time goes back to
+    /// zero, and Reset is called before the next PreUpdate. Systems should
+    /// discard the state they built from previous iterations, such as
+    /// objects created for entities which may no longer exist. Entities
+    /// created by systems during the first iteration are removed as well,
+    /// so systems which need them should create them again. Systems which
+    /// don't implement this interface keep their state.
+    class ISystemReset {
+      /// \brief Reset the system
+      /// \param[in] _info Update info of the iteration following the reset.
+      /// \param[in] _ecm The restored EntityComponentManager.
+      public: virtual void Reset(const UpdateInfo &_info,
+                                 EntityComponentManager &_ecm) = 0;
+    };
   }
   }
 }
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 
 #include <sdf/Element.hh>
@@ -66,6 +67,16 @@ namespace ignition
                   const std::string &_name,
                   const sdf::ElementPtr &_sdf);
 
+      /// \brief Find and load the libraries of plugins which will be loaded
+      /// later, for example all the plugins of a world before its entities
+      /// are created. The library search is done in parallel, and each
+      /// library is only searched for and loaded once, no matter how many
+      /// plugins are later instantiated from it. Libraries which aren't found
+      /// are searched for again when their plugins are loaded. Errors are
+      /// reported when the plugins are loaded.
+      /// \param[in] _filenames Library filenames, as given to LoadPlugin.
+      public: void PreloadLibraries(const std::set<std::string> &_filenames);
+
       /// \brief Makes a printable string with info about systems
       /// \returns A pretty string
       public: std::string PrettyStr() const;
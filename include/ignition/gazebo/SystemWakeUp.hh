@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMWAKEUP_HH_
+#define IGNITION_GAZEBO_SYSTEMWAKEUP_HH_
+
+#include <chrono>
+#include <memory>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/EntityComponentManager.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/Types.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN SystemWakeUpPrivate;
+
+    /// \class SystemWakeUp SystemWakeUp.hh ignition/gazebo/SystemWakeUp.hh
+    /// \brief Conditions under which a system's PreUpdate is called, for
+    /// systems which implement ISystemWakeUp.
+    ///
+    /// Such systems are idle by default: their PreUpdate is only called on the
+    /// first iteration and on the iterations where one of the conditions below
+    /// is met, or when sim time jumps back, for example after a reset. When
+    /// iterations are skipped, the next call is given the sim time elapsed
+    /// since the previous one as its dt.
+    ///
+    ///  * Wake: called from any thread, for example from a transport callback
+    ///    which queued work for PreUpdate.
+    ///  * WakeOnComponentChange: a component of a given type was created,
+    ///    removed, or marked as changed by another system.
+    ///  * WakeAt and WakeEvery: a sim time timer fired.
+    class IGNITION_GAZEBO_VISIBLE SystemWakeUp
+    {
+      /// \brief Constructor
+      public: SystemWakeUp();
+
+      /// \brief Destructor
+      public: ~SystemWakeUp();
+
+      /// \brief Call PreUpdate on the next iteration. This is the only
+      /// function which is safe to call from other threads.
+      public: void Wake();
+
+      /// \brief Call PreUpdate whenever a component of the given type is
+      /// created, removed or marked as changed by another system. Changes
+      /// made after the system's PreUpdate, in any phase of the iteration,
+      /// wake it up on the next iteration.
+      /// \param[in] _typeId Component type ID.
+      public: void WakeOnComponentChange(const ComponentTypeId _typeId);
+
+      /// \brief Call PreUpdate whenever a component of the given type is
+      /// created, removed or marked as changed by another system.
+      /// \tparam ComponentTypeT Component type.
+      public: template<typename ComponentTypeT>
+              void WakeOnComponentChange()
+      {
+        this->WakeOnComponentChange(ComponentTypeT::typeId);
+      }
+
+      /// \brief Call PreUpdate once, on the first iteration whose sim time is
+      /// at least the given time. If sim time jumps back, the timer is kept
+      /// at the same sim time.
+      /// \param[in] _simTime Sim time.
+      public: void WakeAt(const std::chrono::steady_clock::duration &_simTime);
+
+      /// \brief Call PreUpdate periodically.
+      /// \param[in] _period Sim time between calls. Zero disables the periodic
+      /// timer.
+      public: void WakeEvery(
+                  const std::chrono::steady_clock::duration &_period);
+
+      /// \brief Check whether PreUpdate should be called on this iteration,
+      /// and consume the conditions which were met. This is called by the
+      /// simulation runner once per iteration, before the system's PreUpdate.
+      /// \param[in] _info Update info of the iteration.
+      /// \param[in] _ecm Entity component manager.
+      /// \param[out] _wakeInfo Update info to pass to PreUpdate, with dt
+      /// covering the skipped iterations.
+      /// \return True if PreUpdate should be called.
+      public: bool Due(const UpdateInfo &_info,
+                   const EntityComponentManager &_ecm,
+                   UpdateInfo &_wakeInfo);
+
+      /// \brief Remember the component changes made up to the end of the
+      /// system's PreUpdate, so the changes made by the system itself don't
+      /// wake it up again. This is called by the simulation runner right
+      /// after the system's PreUpdate.
+      /// \param[in] _ecm Entity component manager.
+      public: void Updated(const EntityComponentManager &_ecm);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SystemWakeUpPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -31,6 +31,7 @@
 #include <ignition/math/Helpers.hh>
 
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/components/Sleeping.hh"
 
 namespace ignition
 {
@@ -412,6 +413,58 @@ void EntityComponentManager::Each(typename identity<std::function<
   }
 }
 
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachAwake(typename identity<std::function<
+    bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
+{
+  // Nothing can be sleeping if the component was never created
+  if (!this->HasComponentType(components::Sleeping::typeId))
+  {
+    this->Each<ComponentTypeTs...>(_f);
+    return;
+  }
+
+  auto view = this->FindView<ComponentTypeTs...>();
+  for (const Entity entity : view->Entities())
+  {
+    auto sleeping = this->Component<components::Sleeping>(entity);
+    if (sleeping && sleeping->Data())
+      continue;
+
+    if (!std::apply(_f, view->EntityComponentConstData(entity)))
+    {
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachAwake(typename identity<std::function<
+    bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
+{
+  // Nothing can be sleeping if the component was never created
+  if (!this->HasComponentType(components::Sleeping::typeId))
+  {
+    this->Each<ComponentTypeTs...>(_f);
+    return;
+  }
+
+  auto view = this->FindView<ComponentTypeTs...>();
+  for (const Entity entity : view->Entities())
+  {
+    auto sleeping = this->Component<components::Sleeping>(entity);
+    if (sleeping && sleeping->Data())
+      continue;
+
+    if (!std::apply(_f, view->EntityComponentData(entity)))
+    {
+      break;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 template <class Function, class... ComponentTypeTs>
 void EntityComponentManager::ForEach(Function _f,
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_PIPELINEDVIDEOENCODER_HH_
+#define IGNITION_GAZEBO_PIPELINEDVIDEOENCODER_HH_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include <ignition/common/VideoEncoder.hh>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/rendering/Export.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+// Forward declare private data class.
+class PipelinedVideoEncoderPrivate;
+
+/// \brief Feeds frames to a video encoder from a separate thread, so that
+/// the render thread can go on rendering the next frame while the current
+/// one is being encoded.
+///
+/// Frames are copied into a bounded queue. If the encoder falls behind and
+/// the queue is full, AddFrame blocks until there's room, so no frames are
+/// dropped.
+class IGNITION_GAZEBO_RENDERING_VISIBLE PipelinedVideoEncoder
+{
+  /// \brief Callback for each frame accepted by the encoder.
+  /// \param[in] _time Timestamp of the frame.
+  /// \param[in] _startTime Start time that was queued with the frame.
+  public: using FrameAddedCallback =
+      std::function<void(const std::chrono::steady_clock::time_point &_time,
+          const std::chrono::steady_clock::time_point &_startTime)>;
+
+  /// \brief Constructor
+  /// \param[in] _encoder Encoder that frames are fed to. It must outlive this
+  /// object, and must not be used by other threads while frames are being
+  /// encoded.
+  /// \param[in] _queueSize Maximum number of frames waiting to be encoded.
+  public: explicit PipelinedVideoEncoder(common::VideoEncoder &_encoder,
+      unsigned int _queueSize = 8u);
+
+  /// \brief Destructor. Encodes pending frames and stops the thread.
+  public: ~PipelinedVideoEncoder();
+
+  /// \brief Set a function to be called from the encoding thread for each
+  /// frame accepted by the encoder.
+  /// \param[in] _cb Callback function.
+  public: void SetFrameAddedCallback(const FrameAddedCallback &_cb);
+
+  /// \brief Start the encoding thread. The encoder should have been started.
+  public: void Start();
+
+  /// \brief Encode all pending frames and stop the encoding thread. The
+  /// encoder can be stopped after this returns.
+  public: void Stop();
+
+  /// \brief Whether the encoding thread is running.
+  /// \return True if running.
+  public: bool Running() const;
+
+  /// \brief Queue a frame to be encoded. The data is copied, so the buffer
+  /// can be reused as soon as this returns.
+  /// \param[in] _frame RGB frame data, 3 bytes per pixel.
+  /// \param[in] _width Frame width.
+  /// \param[in] _height Frame height.
+  /// \param[in] _time Timestamp of the frame.
+  /// \param[in] _startTime Start time of the recording, such as the time of
+  /// its first frame. It's handed back to the frame added callback, so the
+  /// callback doesn't need to read state owned by the calling thread.
+  /// \return False if the encoding thread isn't running.
+  public: bool AddFrame(const unsigned char *_frame, unsigned int _width,
+      unsigned int _height, const std::chrono::steady_clock::time_point &_time,
+      const std::chrono::steady_clock::time_point &_startTime);
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<PipelinedVideoEncoderPrivate> dataPtr;
+};
+}
+}
+}
+#endif
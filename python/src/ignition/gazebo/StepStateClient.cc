@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <optional>
+#include <string>
+
+#include <ignition/gazebo/StepStateClient.hh>
+
+#include "StepStateClient.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+namespace python
+{
+void defineGazeboStepStateClient(pybind11::object module)
+{
+  pybind11::class_<ignition::gazebo::StepStateClient>(
+    module, "StepStateClient")
+  .def(pybind11::init<const std::string &>())
+  .def(
+    "set_entities", &ignition::gazebo::StepStateClient::SetEntities,
+    "Set the entities whose state is returned, empty for all entities.")
+  .def(
+    "set_component_types",
+    &ignition::gazebo::StepStateClient::SetComponentTypes,
+    "Set the type IDs of the components whose state is returned, empty for "
+    "all types.")
+  .def(
+    "step",
+    [](ignition::gazebo::StepStateClient &_self, uint64_t _iterations,
+       unsigned int _timeout) -> pybind11::object
+    {
+      std::optional<msgs::SerializedStepMap> res;
+      {
+        pybind11::gil_scoped_release release;
+        res = _self.Step(_iterations, _timeout);
+      }
+      if (!res)
+        return pybind11::none();
+      return pybind11::bytes(res->SerializeAsString());
+    },
+    pybind11::arg("iterations"),
+    pybind11::arg("timeout") = 5000u,
+    "Run iterations and get the state at the end of the last one, as a "
+    "serialized ignition.msgs.SerializedStepMap message, or None if the "
+    "request failed or timed out.");
+}
+}  // namespace python
+}  // namespace gazebo
+}  // namespace ignition
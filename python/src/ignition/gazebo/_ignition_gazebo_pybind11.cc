@@ -20,6 +20,7 @@
 #include "EventManager.hh"
 #include "Server.hh"
 #include "ServerConfig.hh"
+#include "StepStateClient.hh"
 #include "TestFixture.hh"
 #include "UpdateInfo.hh"
 #include "Util.hh"
@@ -32,6 +33,7 @@ PYBIND11_MODULE(gazebo, m) {
   ignition::gazebo::python::defineGazeboEventManager(m);
   ignition::gazebo::python::defineGazeboServer(m);
   ignition::gazebo::python::defineGazeboServerConfig(m);
+  ignition::gazebo::python::defineGazeboStepStateClient(m);
   ignition::gazebo::python::defineGazeboTestFixture(m);
   ignition::gazebo::python::defineGazeboUpdateInfo(m);
   ignition::gazebo::python::defineGazeboWorld(m);
@@ -0,0 +1,71 @@
+# Copyright (C) 2026 Open Source Robotics Foundation
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#       http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import time
+import unittest
+
+from ignition.common import set_verbosity
+from ignition.gazebo import StepStateClient, TestFixture
+
+post_iterations = 0
+
+class TestStepStateClient(unittest.TestCase):
+
+    def test_step_state_client(self):
+        set_verbosity(4)
+
+        # Nothing serves the world yet
+        client = StepStateClient('gravity')
+        self.assertIsNone(client.step(1, timeout=100))
+
+        file_path = os.path.dirname(os.path.realpath(__file__))
+        helper = TestFixture(os.path.join(file_path, 'gravity.sdf'))
+
+        def on_post_udpate_cb(_info, _ecm):
+            global post_iterations
+            post_iterations += 1
+
+        helper.on_post_update(on_post_udpate_cb)
+        helper.finalize()
+
+        server = helper.server()
+        server.run(False, 0, True)
+
+        # Requests are only accepted once the simulation thread is running.
+        # Iterations are run before the reply, and simulation pauses again.
+        res = None
+        for _ in range(100):
+            res = client.step(10)
+            if res is not None:
+                break
+            time.sleep(0.01)
+        self.assertIsNotNone(res)
+        self.assertIsInstance(res, bytes)
+        self.assertGreater(len(res), 0)
+        self.assertEqual(10, post_iterations)
+
+        # The state can be filtered, and zero iterations don't step
+        client.set_entities({1})
+        client.set_component_types(set())
+        res = client.step(0, timeout=1000)
+        self.assertIsNotNone(res)
+        self.assertEqual(10, post_iterations)
+
+        res = client.step(5, timeout=10000)
+        self.assertIsNotNone(res)
+        self.assertEqual(15, post_iterations)
+
+if __name__ == '__main__':
+    unittest.main()
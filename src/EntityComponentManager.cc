@@ -17,8 +17,10 @@
 
 #include "ignition/gazebo/EntityComponentManager.hh"
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -42,6 +44,8 @@
 #include "ignition/gazebo/components/Recreate.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "EntityComponentManagerSnapshotPrivate.hh"
+
 using namespace ignition;
 using namespace gazebo;
 
@@ -104,6 +108,31 @@ class ignition::gazebo::EntityComponentManagerPrivate
   public: bool ComponentMarkedAsRemoved(const Entity _entity,
               const ComponentTypeId _typeId) const;
 
+  /// \brief Record that an entity was created, removed or reparented since
+  /// the last snapshot. Does nothing until the first snapshot is created.
+  /// \param[in] _entity The entity
+  public: void SnapshotEntityChanged(const Entity _entity);
+
+  /// \brief Record that a component was created, removed or changed since
+  /// the last snapshot. Does nothing until the first snapshot is created.
+  /// \param[in] _entity The entity
+  /// \param[in] _typeId The type ID of the component
+  public: void SnapshotComponentChanged(const Entity _entity,
+              const ComponentTypeId _typeId);
+
+  /// \brief Create a snapshot entity from the current state of an entity,
+  /// copying its components. Components which are in _reuse and whose type
+  /// isn't in _copy are shared instead of copied.
+  /// \param[in] _entity The entity
+  /// \param[in] _parent Parent of the entity
+  /// \param[in] _reuse Entity from the previous snapshot, may be null.
+  /// \param[in] _copy Types to copy even if they're in _reuse.
+  /// \return The new snapshot entity.
+  public: std::shared_ptr<const SnapshotEntity> MakeSnapshotEntity(
+              const Entity _entity, const Entity _parent,
+              const SnapshotEntity *_reuse,
+              const std::unordered_set<ComponentTypeId> &_copy) const;
+
   /// \brief Set a cloned joint's parent or child link name.
   /// \param[in] _joint The cloned joint.
   /// \param[in] _originalLink The original joint's parent or child link.
@@ -276,6 +305,35 @@ class ignition::gazebo::EntityComponentManagerPrivate
 
   /// \brief Set of entities that are prevented from removal.
   public: std::unordered_set<Entity> pinnedEntities;
+
+  /// \brief Number of times components of each type were created, removed
+  /// or marked as changed, see ComponentChangeCount.
+  public: std::unordered_map<ComponentTypeId, uint64_t> componentChangeCounts;
+
+  /// \brief Latest snapshot, null until Snapshot is first called.
+  public: std::shared_ptr<const EntityComponentManagerSnapshot> lastSnapshot;
+
+  /// \brief Protects the latest snapshot and the changes since then while
+  /// a snapshot is created, since several PostUpdate systems may request one
+  /// at the same time.
+  public: std::mutex snapshotMutex;
+
+  /// \brief Entities created, removed or reparented since the last snapshot.
+  public: std::unordered_set<Entity> snapshotDirtyEntities;
+
+  /// \brief Components created, removed or changed since the last snapshot,
+  /// for entities which aren't in snapshotDirtyEntities.
+  public: std::unordered_map<Entity, std::unordered_set<ComponentTypeId>>
+          snapshotDirtyComponents;
+
+  /// \brief True if all entities were removed since the last snapshot, so
+  /// the next one must be built from scratch.
+  public: bool snapshotDirtyAll{false};
+
+  /// \brief Snapshot of another entity component manager which this one
+  /// mirrors, see Mirror.
+  public: std::shared_ptr<const EntityComponentManagerSnapshot>
+          mirroredSnapshot;
 };
 
 //////////////////////////////////////////////////
@@ -293,6 +351,24 @@ size_t EntityComponentManager::EntityCount() const
   return this->dataPtr->entities.Vertices().size();
 }
 
+/////////////////////////////////////////////////
+size_t EntityComponentManager::ComponentCount() const
+{
+  size_t count{0u};
+  for (const auto &[entity, types] : this->dataPtr->componentTypeIndex)
+    count += types.size();
+  for (const auto &[entity, types] : this->dataPtr->componentsMarkedAsRemoved)
+    count -= std::min(count, types.size());
+  return count;
+}
+
+/////////////////////////////////////////////////
+size_t EntityComponentManager::ViewCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->viewsMutex);
+  return this->dataPtr->views.size();
+}
+
 /////////////////////////////////////////////////
 Entity EntityComponentManager::CreateEntity()
 {
@@ -323,6 +399,8 @@ Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity)
   // Reset descendants cache
   this->descendantCache.clear();
 
+  this->SnapshotEntityChanged(_entity);
+
   const auto result = this->componentStorage.insert({_entity,
       std::vector<std::unique_ptr<components::BaseComponent>>()});
   if (!result.second)
@@ -753,6 +831,9 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
 
     // All views are now invalid.
     this->dataPtr->views.clear();
+
+    if (this->dataPtr->lastSnapshot)
+      this->dataPtr->snapshotDirtyAll = true;
   }
   else
   {
@@ -771,6 +852,7 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
       this->dataPtr->componentStorage.erase(entity);
       this->dataPtr->componentTypeIndex.erase(entity);
       this->dataPtr->componentTypeIndexDirty = true;
+      this->dataPtr->SnapshotEntityChanged(entity);
 
       // Remove the entity from views.
       for (auto &view : this->dataPtr->views)
@@ -822,6 +904,8 @@ bool EntityComponentManager::RemoveComponent(
   }
 
   this->dataPtr->AddModifiedComponent(_entity);
+  this->dataPtr->SnapshotComponentChanged(_entity, _typeId);
+  ++this->dataPtr->componentChangeCounts[_typeId];
 
   // Add component to map of removed components
   {
@@ -947,6 +1031,14 @@ std::unordered_set<ComponentTypeId>
   return periodicComponents;
 }
 
+/////////////////////////////////////////////////
+uint64_t EntityComponentManager::ComponentChangeCount(
+    const ComponentTypeId _typeId) const
+{
+  auto it = this->dataPtr->componentChangeCounts.find(_typeId);
+  return it == this->dataPtr->componentChangeCounts.end() ? 0u : it->second;
+}
+
 /////////////////////////////////////////////////
 bool EntityComponentManager::HasEntity(const Entity _entity) const
 {
@@ -969,6 +1061,8 @@ Entity EntityComponentManager::ParentEntity(const Entity _entity) const
 bool EntityComponentManager::SetParentEntity(const Entity _child,
     const Entity _parent)
 {
+  this->dataPtr->SnapshotEntityChanged(_child);
+
   // Remove current parent(s)
   auto parents = this->Entities().AdjacentsTo(_child);
   for (const auto &parent : parents)
@@ -1019,6 +1113,8 @@ bool EntityComponentManager::CreateComponentImplementation(
 
   this->dataPtr->AddModifiedComponent(_entity);
   this->dataPtr->oneTimeChangedComponents[_componentTypeId].insert(_entity);
+  this->dataPtr->SnapshotComponentChanged(_entity, _componentTypeId);
+  ++this->dataPtr->componentChangeCounts[_componentTypeId];
 
   // make sure the entity exists
   auto typeMapIter = this->dataPtr->componentTypeIndex.find(_entity);
@@ -1412,26 +1508,40 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
   }
 
   // Insert all of the entity's components if the passed in types
-  // set is empty
-  auto types = _types;
-  if (types.empty())
-  {
-    for (auto &type : this->dataPtr->componentTypeIndex[_entity])
+  // set is empty. When a filter is given, iterate over whichever of the
+  // filter or the entity's components is smaller, so that large filters don't
+  // cost one lookup per filtered type for every entity.
+  std::vector<ComponentTypeId> types;
+  if (_types.empty())
+  {
+    types.reserve(iter->second.size());
+    for (auto &type : iter->second)
     {
       if (!this->dataPtr->ComponentMarkedAsRemoved(_entity, type.first))
-        types.insert(type.first);
+        types.push_back(type.first);
     }
   }
-
-  // Empty means all types
-  for (const ComponentTypeId type : types)
+  else if (_types.size() > iter->second.size())
   {
-    auto typeIter = iter->second.find(type);
-    if (typeIter == iter->second.end())
+    types.reserve(iter->second.size());
+    for (auto &type : iter->second)
     {
-      continue;
+      if (_types.find(type.first) != _types.end())
+        types.push_back(type.first);
+    }
+  }
+  else
+  {
+    types.reserve(_types.size());
+    for (const ComponentTypeId type : _types)
+    {
+      if (iter->second.find(type) != iter->second.end())
+        types.push_back(type);
     }
+  }
 
+  for (const ComponentTypeId type : types)
+  {
     const components::BaseComponent *compBase =
       this->ComponentImplementation(_entity, type);
 
@@ -1547,6 +1657,38 @@ void EntityComponentManager::ChangedState(
   }
 }
 
+//////////////////////////////////////////////////
+void EntityComponentManager::ChangedState(
+    ignition::msgs::SerializedStateMap &_state,
+    const std::unordered_set<Entity> &_entities,
+    const std::unordered_set<ComponentTypeId> &_types) const
+{
+  auto addEntity = [&](const Entity _entity)
+  {
+    if (!_entities.empty() && _entities.find(_entity) == _entities.end())
+      return;
+    this->AddEntityToMessage(_state, _entity, _types);
+  };
+
+  // New entities
+  for (const auto &entity : this->dataPtr->newlyCreatedEntities)
+  {
+    addEntity(entity);
+  }
+
+  // Entities being removed
+  for (const auto &entity : this->dataPtr->toRemoveEntities)
+  {
+    addEntity(entity);
+  }
+
+  // New / removed / changed components
+  for (const auto &entity : this->dataPtr->modifiedComponents)
+  {
+    addEntity(entity);
+  }
+}
+
 //////////////////////////////////////////////////
 void EntityComponentManagerPrivate::CalculateStateThreadLoad()
 {
@@ -1914,6 +2056,12 @@ void EntityComponentManager::SetChanged(
       oneTimeIter->second.erase(_entity);
   }
 
+  if (_c != ComponentState::NoChange)
+  {
+    this->dataPtr->SnapshotComponentChanged(_entity, _type);
+    ++this->dataPtr->componentChangeCounts[_type];
+  }
+
   this->dataPtr->AddModifiedComponent(_entity);
 }
 
@@ -1976,6 +2124,87 @@ void EntityComponentManagerPrivate::AddModifiedComponent(const Entity &_entity)
   this->modifiedComponents.insert(_entity);
 }
 
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SnapshotEntityChanged(const Entity _entity)
+{
+  if (!this->lastSnapshot || this->snapshotDirtyAll)
+    return;
+
+  this->snapshotDirtyEntities.insert(_entity);
+  this->snapshotDirtyComponents.erase(_entity);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SnapshotComponentChanged(
+    const Entity _entity, const ComponentTypeId _typeId)
+{
+  if (!this->lastSnapshot || this->snapshotDirtyAll ||
+      this->snapshotDirtyEntities.find(_entity) !=
+      this->snapshotDirtyEntities.end())
+  {
+    return;
+  }
+
+  this->snapshotDirtyComponents[_entity].insert(_typeId);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const SnapshotEntity>
+    EntityComponentManagerPrivate::MakeSnapshotEntity(const Entity _entity,
+    const Entity _parent, const SnapshotEntity *_reuse,
+    const std::unordered_set<ComponentTypeId> &_copy) const
+{
+  auto result = std::make_shared<SnapshotEntity>();
+  result->parent = _parent;
+
+  auto typeIter = this->componentTypeIndex.find(_entity);
+  auto storageIter = this->componentStorage.find(_entity);
+  if (typeIter == this->componentTypeIndex.end() ||
+      storageIter == this->componentStorage.end())
+  {
+    return result;
+  }
+
+  result->components.reserve(typeIter->second.size());
+  for (const auto &[type, index] : typeIter->second)
+  {
+    if (this->ComponentMarkedAsRemoved(_entity, type))
+      continue;
+
+    std::shared_ptr<const components::BaseComponent> comp;
+    if (nullptr != _reuse && _copy.find(type) == _copy.end())
+    {
+      auto it = std::lower_bound(_reuse->components.begin(),
+          _reuse->components.end(), type,
+          [](const auto &_comp, const ComponentTypeId _value)
+          {
+            return _comp.first < _value;
+          });
+      if (it != _reuse->components.end() && it->first == type)
+        comp = it->second;
+    }
+
+    if (!comp)
+    {
+      const auto *data = storageIter->second.at(index).get();
+      if (nullptr == data)
+        continue;
+      comp = components::Factory::Instance()->New(type, data);
+    }
+
+    if (comp)
+      result->components.push_back({type, std::move(comp)});
+  }
+
+  std::sort(result->components.begin(), result->components.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  return result;
+}
+
 /////////////////////////////////////////////////
 bool EntityComponentManagerPrivate::ComponentMarkedAsRemoved(
     const Entity _entity, const ComponentTypeId _typeId) const
@@ -2068,3 +2297,371 @@ void EntityComponentManager::UnpinAllEntities()
 {
   this->dataPtr->pinnedEntities.clear();
 }
+
+/////////////////////////////////////////////////
+std::shared_ptr<const EntityComponentManagerSnapshot>
+    EntityComponentManager::Snapshot() const
+{
+  IGN_PROFILE("EntityComponentManager::Snapshot");
+  std::lock_guard<std::mutex> lock(this->dataPtr->snapshotMutex);
+
+  auto &last = this->dataPtr->lastSnapshot;
+  if (last && !this->dataPtr->snapshotDirtyAll &&
+      this->dataPtr->snapshotDirtyEntities.empty() &&
+      this->dataPtr->snapshotDirtyComponents.empty())
+  {
+    return last;
+  }
+
+  std::shared_ptr<EntityComponentManagerSnapshot> snapshot(
+      new EntityComponentManagerSnapshot());
+  auto &data = *snapshot->dataPtr;
+  data.version = last ? last->dataPtr->version + 1u : 0u;
+
+  // Copy-on-write access to the page of an entity
+  std::unordered_map<std::size_t, std::shared_ptr<SnapshotPage>> copiedPages;
+  auto setEntity = [&](const Entity _entity,
+      std::shared_ptr<const SnapshotEntity> _snapshotEntity)
+  {
+    const auto pageIndex = _entity / SnapshotPage::kSize;
+    if (pageIndex >= data.pages.size())
+    {
+      if (!_snapshotEntity)
+        return;
+      data.pages.resize(pageIndex + 1u);
+    }
+
+    auto &page = copiedPages[pageIndex];
+    if (!page)
+    {
+      page = data.pages[pageIndex] ?
+          std::make_shared<SnapshotPage>(*data.pages[pageIndex]) :
+          std::make_shared<SnapshotPage>();
+      data.pages[pageIndex] = page;
+    }
+
+    auto &slot = page->entities[_entity % SnapshotPage::kSize];
+    if (slot && !_snapshotEntity)
+    {
+      --page->count;
+      --data.entityCount;
+    }
+    else if (!slot && _snapshotEntity)
+    {
+      ++page->count;
+      ++data.entityCount;
+    }
+    slot = std::move(_snapshotEntity);
+  };
+
+  if (!last || this->dataPtr->snapshotDirtyAll)
+  {
+    // Build from scratch
+    for (const auto &entityTypes : this->dataPtr->componentTypeIndex)
+    {
+      const auto entity = entityTypes.first;
+      setEntity(entity, this->dataPtr->MakeSnapshotEntity(entity,
+          this->ParentEntity(entity), nullptr, {}));
+    }
+  }
+  else
+  {
+    // Share all pages, and only copy those which changed
+    data.pages = last->dataPtr->pages;
+    data.entityCount = last->dataPtr->entityCount;
+
+    for (const auto entity : this->dataPtr->snapshotDirtyEntities)
+    {
+      if (this->dataPtr->componentTypeIndex.find(entity) ==
+          this->dataPtr->componentTypeIndex.end())
+      {
+        setEntity(entity, nullptr);
+        continue;
+      }
+
+      setEntity(entity, this->dataPtr->MakeSnapshotEntity(entity,
+          this->ParentEntity(entity), nullptr, {}));
+    }
+
+    for (const auto &[entity, types] : this->dataPtr->snapshotDirtyComponents)
+    {
+      if (this->dataPtr->componentTypeIndex.find(entity) ==
+          this->dataPtr->componentTypeIndex.end())
+      {
+        continue;
+      }
+
+      const auto *previous = last->dataPtr->Find(entity);
+      setEntity(entity, this->dataPtr->MakeSnapshotEntity(entity,
+          nullptr != previous ? previous->parent : this->ParentEntity(entity),
+          previous, types));
+    }
+  }
+
+  // Drop pages left without entities
+  for (auto &[index, page] : copiedPages)
+  {
+    if (0u == page->count)
+      data.pages[index].reset();
+  }
+  while (!data.pages.empty() && !data.pages.back())
+    data.pages.pop_back();
+
+  this->dataPtr->snapshotDirtyAll = false;
+  this->dataPtr->snapshotDirtyEntities.clear();
+  this->dataPtr->snapshotDirtyComponents.clear();
+
+  last = snapshot;
+  return last;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const EntityComponentManagerSnapshot>
+    EntityComponentManager::FullSnapshot() const
+{
+  IGN_PROFILE("EntityComponentManager::FullSnapshot");
+
+  std::shared_ptr<EntityComponentManagerSnapshot> snapshot(
+      new EntityComponentManagerSnapshot());
+  auto &data = *snapshot->dataPtr;
+
+  std::vector<std::shared_ptr<SnapshotPage>> pages;
+  for (const auto &entityTypes : this->dataPtr->componentTypeIndex)
+  {
+    const auto entity = entityTypes.first;
+    const auto pageIndex = entity / SnapshotPage::kSize;
+    if (pageIndex >= pages.size())
+      pages.resize(pageIndex + 1u);
+
+    auto &page = pages[pageIndex];
+    if (!page)
+      page = std::make_shared<SnapshotPage>();
+
+    page->entities[entity % SnapshotPage::kSize] =
+        this->dataPtr->MakeSnapshotEntity(entity, this->ParentEntity(entity),
+        nullptr, {});
+    ++page->count;
+    ++data.entityCount;
+  }
+  data.pages.assign(pages.begin(), pages.end());
+
+  return snapshot;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::ResetTo(
+    const EntityComponentManagerSnapshot &_snapshot)
+{
+  IGN_PROFILE("EntityComponentManager::ResetTo");
+  const auto &data = *_snapshot.dataPtr;
+
+  // Remove entities created after the snapshot
+  for (const auto &vertex : this->dataPtr->entities.Vertices())
+  {
+    if (nullptr == data.Find(vertex.first))
+      this->RequestRemoveEntity(vertex.first, false);
+  }
+
+  std::vector<std::pair<Entity, Entity>> parents;
+  parents.reserve(data.entityCount);
+  for (std::size_t pageIndex = 0u; pageIndex < data.pages.size(); ++pageIndex)
+  {
+    const auto &page = data.pages[pageIndex];
+    if (!page)
+      continue;
+
+    for (std::size_t i = 0u; i < SnapshotPage::kSize; ++i)
+    {
+      const auto *snapshotEntity = page->entities[i].get();
+      if (nullptr == snapshotEntity)
+        continue;
+
+      // Create entities removed after the snapshot
+      const Entity entity = pageIndex * SnapshotPage::kSize + i;
+      if (!this->HasEntity(entity))
+        this->dataPtr->CreateEntityImplementation(entity);
+      parents.push_back({entity, snapshotEntity->parent});
+
+      // Remove components created after the snapshot
+      std::vector<ComponentTypeId> toRemove;
+      for (const auto &typeIndex : this->dataPtr->componentTypeIndex[entity])
+      {
+        const auto type = typeIndex.first;
+        auto it = std::lower_bound(snapshotEntity->components.begin(),
+            snapshotEntity->components.end(), type,
+            [](const auto &_comp, const ComponentTypeId _value)
+            {
+              return _comp.first < _value;
+            });
+        if (it == snapshotEntity->components.end() || it->first != type)
+          toRemove.push_back(type);
+      }
+      for (const auto type : toRemove)
+        this->RemoveComponent(entity, type);
+
+      // Restore the others. Components are replaced with copies of the
+      // snapshot, since their type isn't known here, and views are rebuilt
+      // below so they don't keep pointers to the old ones.
+      for (const auto &[type, comp] : snapshotEntity->components)
+      {
+        if (!this->EntityHasComponentType(entity, type) &&
+            !this->CreateComponentImplementation(entity, type, comp.get()))
+        {
+          continue;
+        }
+
+        auto &storage = this->dataPtr->componentStorage[entity];
+        const auto index = this->dataPtr->componentTypeIndex[entity][type];
+        storage[index] = components::Factory::Instance()->New(type,
+            comp.get());
+        this->SetChanged(entity, type, ComponentState::OneTimeChange);
+      }
+    }
+  }
+
+  for (const auto &[entity, parent] : parents)
+  {
+    if (this->ParentEntity(entity) != parent)
+      this->SetParentEntity(entity, parent);
+  }
+
+  this->RebuildViews();
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::Mirror(
+    const std::shared_ptr<const EntityComponentManagerSnapshot> &_snapshot,
+    const EntityComponentManager *_source)
+{
+  IGN_PROFILE("EntityComponentManager::Mirror");
+
+  // Changes mirrored by the previous call have already been seen
+  this->ClearNewlyCreatedEntities();
+  this->ProcessRemoveEntityRequests();
+  this->ClearRemovedComponents();
+  this->SetAllComponentsUnchanged();
+
+  auto &previous = this->dataPtr->mirroredSnapshot;
+  if (!_snapshot || previous == _snapshot)
+    return;
+
+  const auto &data = *_snapshot->dataPtr;
+  const EntityComponentManagerSnapshotPrivate *previousData =
+      previous ? previous->dataPtr.get() : nullptr;
+
+  auto findComponent = [](const SnapshotEntity *_snapshotEntity,
+      const ComponentTypeId _type) -> const components::BaseComponent *
+  {
+    if (nullptr == _snapshotEntity)
+      return nullptr;
+    auto it = std::lower_bound(_snapshotEntity->components.begin(),
+        _snapshotEntity->components.end(), _type,
+        [](const auto &_comp, const ComponentTypeId _value)
+        {
+          return _comp.first < _value;
+        });
+    if (it == _snapshotEntity->components.end() || it->first != _type)
+      return nullptr;
+    return it->second.get();
+  };
+
+  std::vector<std::pair<Entity, Entity>> parents;
+  const std::size_t pageCount = std::max(data.pages.size(),
+      nullptr != previousData ? previousData->pages.size() : 0u);
+  for (std::size_t pageIndex = 0u; pageIndex < pageCount; ++pageIndex)
+  {
+    const SnapshotPage *page = pageIndex < data.pages.size() ?
+        data.pages[pageIndex].get() : nullptr;
+    const SnapshotPage *previousPage = nullptr;
+    if (nullptr != previousData && pageIndex < previousData->pages.size())
+      previousPage = previousData->pages[pageIndex].get();
+
+    // Pages are shared by snapshots until one of their entities changes
+    if (page == previousPage)
+      continue;
+
+    for (std::size_t i = 0u; i < SnapshotPage::kSize; ++i)
+    {
+      const auto *snapshotEntity =
+          nullptr != page ? page->entities[i].get() : nullptr;
+      const auto *previousEntity =
+          nullptr != previousPage ? previousPage->entities[i].get() : nullptr;
+      if (snapshotEntity == previousEntity)
+        continue;
+
+      const Entity entity = pageIndex * SnapshotPage::kSize + i;
+      if (nullptr == snapshotEntity)
+      {
+        this->RequestRemoveEntity(entity, false);
+        continue;
+      }
+
+      if (!this->HasEntity(entity))
+      {
+        this->dataPtr->CreateEntityImplementation(entity);
+        previousEntity = nullptr;
+      }
+      if (nullptr == previousEntity ||
+          previousEntity->parent != snapshotEntity->parent)
+      {
+        parents.push_back({entity, snapshotEntity->parent});
+      }
+
+      // Remove components which were removed from the source
+      if (nullptr != previousEntity)
+      {
+        for (const auto &typeComp : previousEntity->components)
+        {
+          if (nullptr == findComponent(snapshotEntity, typeComp.first))
+            this->RemoveComponent(entity, typeComp.first);
+        }
+      }
+
+      for (const auto &[type, comp] : snapshotEntity->components)
+      {
+        // Components are shared by snapshots until they change
+        if (comp.get() == findComponent(previousEntity, type))
+          continue;
+
+        auto &typeIndex = this->dataPtr->componentTypeIndex[entity];
+        const bool stored = typeIndex.find(type) != typeIndex.end();
+        if ((!stored || this->dataPtr->ComponentMarkedAsRemoved(entity, type))
+            && !this->CreateComponentImplementation(entity, type, comp.get()))
+        {
+          continue;
+        }
+
+        // Replace existing components with a copy, and refresh the views
+        // which cached a pointer to the old one
+        if (stored)
+        {
+          this->dataPtr->componentStorage[entity][typeIndex[type]] =
+              components::Factory::Instance()->New(type, comp.get());
+          for (auto &viewPair : this->dataPtr->views)
+          {
+            auto &view = viewPair.second.first;
+            if (!view->RequiresComponent(type))
+              continue;
+            view->RemoveEntity(entity);
+            if (this->EntityMatches(entity, view->ComponentTypes()))
+              view->MarkEntityToAdd(entity, this->IsNewEntity(entity));
+          }
+        }
+
+        auto state = nullptr != _source ?
+            _source->ComponentState(entity, type) : ComponentState::NoChange;
+        if (ComponentState::NoChange == state)
+          state = ComponentState::OneTimeChange;
+        this->SetChanged(entity, type, state);
+      }
+    }
+  }
+
+  for (const auto &[entity, parent] : parents)
+  {
+    if (this->ParentEntity(entity) != parent)
+      this->SetParentEntity(entity, parent);
+  }
+
+  previous = _snapshot;
+}
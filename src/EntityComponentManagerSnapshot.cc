@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/EntityComponentManagerSnapshot.hh"
+
+#include <algorithm>
+
+#include "EntityComponentManagerSnapshotPrivate.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+EntityComponentManagerSnapshot::EntityComponentManagerSnapshot()
+  : dataPtr(std::make_unique<EntityComponentManagerSnapshotPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+EntityComponentManagerSnapshot::~EntityComponentManagerSnapshot() = default;
+
+//////////////////////////////////////////////////
+uint64_t EntityComponentManagerSnapshot::Version() const
+{
+  return this->dataPtr->version;
+}
+
+//////////////////////////////////////////////////
+size_t EntityComponentManagerSnapshot::EntityCount() const
+{
+  return this->dataPtr->entityCount;
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManagerSnapshot::HasEntity(const Entity _entity) const
+{
+  return nullptr != this->dataPtr->Find(_entity);
+}
+
+//////////////////////////////////////////////////
+Entity EntityComponentManagerSnapshot::ParentEntity(const Entity _entity) const
+{
+  auto entity = this->dataPtr->Find(_entity);
+  return nullptr == entity ? kNullEntity : entity->parent;
+}
+
+//////////////////////////////////////////////////
+std::unordered_set<ComponentTypeId>
+    EntityComponentManagerSnapshot::ComponentTypes(const Entity _entity) const
+{
+  std::unordered_set<ComponentTypeId> result;
+  auto entity = this->dataPtr->Find(_entity);
+  if (nullptr == entity)
+    return result;
+
+  for (const auto &comp : entity->components)
+    result.insert(comp.first);
+  return result;
+}
+
+//////////////////////////////////////////////////
+const components::BaseComponent *
+    EntityComponentManagerSnapshot::ComponentImplementation(
+    const Entity _entity, const ComponentTypeId _type) const
+{
+  auto entity = this->dataPtr->Find(_entity);
+  if (nullptr == entity)
+    return nullptr;
+
+  auto it = std::lower_bound(entity->components.begin(),
+      entity->components.end(), _type,
+      [](const auto &_comp, const ComponentTypeId _value)
+      {
+        return _comp.first < _value;
+      });
+  if (it == entity->components.end() || it->first != _type)
+    return nullptr;
+  return it->second.get();
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManagerSnapshot::Entities() const
+{
+  std::vector<Entity> result;
+  result.reserve(this->dataPtr->entityCount);
+  this->EachEntity([&](const Entity _entity)
+  {
+    result.push_back(_entity);
+    return true;
+  });
+  return result;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManagerSnapshot::EachEntity(
+    const std::function<bool(const Entity)> &_f) const
+{
+  const auto &pages = this->dataPtr->pages;
+  for (std::size_t p = 0u; p < pages.size(); ++p)
+  {
+    if (!pages[p])
+      continue;
+
+    for (std::size_t i = 0u; i < SnapshotPage::kSize; ++i)
+    {
+      if (!pages[p]->entities[i])
+        continue;
+      if (!_f(static_cast<Entity>(p * SnapshotPage::kSize + i)))
+        return;
+    }
+  }
+}
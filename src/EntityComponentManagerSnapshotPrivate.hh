@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ENTITYCOMPONENTMANAGERSNAPSHOTPRIVATE_HH_
+#define IGNITION_GAZEBO_ENTITYCOMPONENTMANAGERSNAPSHOTPRIVATE_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Export.hh"
+#include "ignition/gazebo/Types.hh"
+#include "ignition/gazebo/components/Component.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief An entity and its components in a snapshot. It's never modified
+    /// after being added to a snapshot, so it can be shared by consecutive
+    /// snapshots.
+    class IGNITION_GAZEBO_HIDDEN SnapshotEntity
+    {
+      /// \brief Parent entity.
+      public: Entity parent{kNullEntity};
+
+      /// \brief Components, sorted by type.
+      public: std::vector<std::pair<ComponentTypeId,
+          std::shared_ptr<const components::BaseComponent>>> components;
+    };
+
+    /// \brief A page of consecutive entity IDs. Pages are shared between
+    /// snapshots, and copied when one of their entities changes.
+    class IGNITION_GAZEBO_HIDDEN SnapshotPage
+    {
+      /// \brief Number of entities per page.
+      public: static constexpr std::size_t kSize{64u};
+
+      /// \brief Entities, indexed by ID modulo kSize. Null for entities which
+      /// don't exist.
+      public: std::array<std::shared_ptr<const SnapshotEntity>, kSize>
+          entities;
+
+      /// \brief Number of non-null entities.
+      public: std::size_t count{0u};
+    };
+
+    /// \brief Private data for EntityComponentManagerSnapshot.
+    class IGNITION_GAZEBO_HIDDEN EntityComponentManagerSnapshotPrivate
+    {
+      /// \brief Get an entity.
+      /// \param[in] _entity Entity ID.
+      /// \return The entity, or nullptr if it's not in the snapshot.
+      public: const SnapshotEntity *Find(const Entity _entity) const
+      {
+        const auto pageIndex = _entity / SnapshotPage::kSize;
+        if (pageIndex >= this->pages.size() || !this->pages[pageIndex])
+          return nullptr;
+        return this->pages[pageIndex]->entities[
+            _entity % SnapshotPage::kSize].get();
+      }
+
+      /// \brief Version of the snapshot.
+      public: uint64_t version{0u};
+
+      /// \brief Number of entities.
+      public: std::size_t entityCount{0u};
+
+      /// \brief Pages, indexed by entity ID divided by the page size. Null
+      /// for pages without entities.
+      public: std::vector<std::shared_ptr<const SnapshotPage>> pages;
+    };
+    }
+  }
+}
+#endif
@@ -33,6 +33,7 @@
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/ParentLinkName.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/Sleeping.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/config.hh"
 #include "../test/helpers/EnvTestFixture.hh"
@@ -135,6 +136,42 @@ TEST_P(EntityComponentManagerFixture, InvalidComponentType)
   EXPECT_EQ(nullptr, manager.Component<IntComponent>(2u));
 }
 
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(ComponentAndViewCount))
+{
+  EXPECT_EQ(0u, manager.ComponentCount());
+  EXPECT_EQ(0u, manager.ViewCount());
+
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(0.2));
+  EXPECT_EQ(3u, manager.ComponentCount());
+
+  // Views are created by queries
+  std::size_t count{0u};
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(1u, manager.ViewCount());
+
+  manager.Each<IntComponent, DoubleComponent>([&](const Entity &,
+      const IntComponent *, const DoubleComponent *) -> bool
+      {
+        return true;
+      });
+  EXPECT_EQ(2u, manager.ViewCount());
+
+  // Removed components aren't counted
+  EXPECT_TRUE(manager.RemoveComponent<DoubleComponent>(e2));
+  EXPECT_EQ(2u, manager.ComponentCount());
+}
+
 /////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture,
        IGN_UTILS_TEST_DISABLED_ON_WIN32(RemoveComponent))
@@ -1993,6 +2030,71 @@ TEST_P(EntityComponentManagerFixture,
   EXPECT_EQ(1, changedStateMsg.entities_size());
 }
 
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(ChangedStateFiltered))
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<StringComponent>(e1, StringComponent("one"));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(2.0));
+
+  // No filters is the same as the unfiltered version
+  msgs::SerializedStateMap stateMsg;
+  manager.ChangedState(stateMsg, {}, {});
+  ASSERT_EQ(2, stateMsg.entities_size());
+  EXPECT_EQ(2, stateMsg.entities().at(e1).components_size());
+  EXPECT_EQ(2, stateMsg.entities().at(e2).components_size());
+
+  // Filter by entity
+  stateMsg.Clear();
+  manager.ChangedState(stateMsg, {e2}, {});
+  ASSERT_EQ(1, stateMsg.entities_size());
+  EXPECT_EQ(2, stateMsg.entities().at(e2).components_size());
+
+  // Filter by component type
+  stateMsg.Clear();
+  manager.ChangedState(stateMsg, {}, {IntComponent::typeId});
+  ASSERT_EQ(2, stateMsg.entities_size());
+  ASSERT_EQ(1, stateMsg.entities().at(e1).components_size());
+  EXPECT_EQ(IntComponent::typeId,
+      stateMsg.entities().at(e1).components().begin()->second.type());
+  ASSERT_EQ(1, stateMsg.entities().at(e2).components_size());
+  EXPECT_EQ(IntComponent::typeId,
+      stateMsg.entities().at(e2).components().begin()->second.type());
+
+  // A type filter larger than the number of components in each entity
+  stateMsg.Clear();
+  manager.ChangedState(stateMsg, {}, {IntComponent::typeId,
+      DoubleComponent::typeId, BoolComponent::typeId, Even::typeId});
+  ASSERT_EQ(2, stateMsg.entities_size());
+  EXPECT_EQ(1, stateMsg.entities().at(e1).components_size());
+  EXPECT_EQ(2, stateMsg.entities().at(e2).components_size());
+
+  // Entities whose components are all filtered out are not added
+  stateMsg.Clear();
+  manager.ChangedState(stateMsg, {e1}, {DoubleComponent::typeId});
+  EXPECT_EQ(0, stateMsg.entities_size());
+
+  // Unchanged components are never added
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  stateMsg.Clear();
+  manager.ChangedState(stateMsg, {}, {IntComponent::typeId});
+  EXPECT_EQ(0, stateMsg.entities_size());
+
+  manager.SetChanged(e2, DoubleComponent::typeId,
+      ComponentState::PeriodicChange);
+  stateMsg.Clear();
+  manager.ChangedState(stateMsg, {}, {IntComponent::typeId});
+  EXPECT_EQ(0, stateMsg.entities_size());
+  manager.ChangedState(stateMsg, {e2}, {DoubleComponent::typeId});
+  ASSERT_EQ(1, stateMsg.entities_size());
+  EXPECT_EQ(1, stateMsg.entities().at(e2).components_size());
+}
+
 /////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, Descendants)
 {
@@ -3150,6 +3252,355 @@ TEST_P(EntityComponentManagerFixture,
   EXPECT_EQ(1, foundEntities);
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(EachAwake))
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  manager.CreateComponent<IntComponent>(e3, IntComponent(3));
+
+  auto awakeEntities = [&]()
+  {
+    std::set<Entity> entities;
+    const auto &constManager = manager;
+    constManager.EachAwake<IntComponent>(
+        [&](const Entity &_entity, const IntComponent *) -> bool
+        {
+          entities.insert(_entity);
+          return true;
+        });
+
+    // The mutable version visits the same entities
+    std::set<Entity> mutableEntities;
+    manager.EachAwake<IntComponent>(
+        [&](const Entity &_entity, IntComponent *) -> bool
+        {
+          mutableEntities.insert(_entity);
+          return true;
+        });
+    EXPECT_EQ(entities, mutableEntities);
+    return entities;
+  };
+
+  // No sleeping components
+  EXPECT_EQ(std::set<Entity>({e1, e2, e3}), awakeEntities());
+
+  // Sleeping entities are skipped, awake ones are visited
+  manager.CreateComponent(e1, components::Sleeping(true));
+  manager.CreateComponent(e2, components::Sleeping(false));
+  EXPECT_EQ(std::set<Entity>({e2, e3}), awakeEntities());
+
+  // Waking up
+  manager.SetComponentData<components::Sleeping>(e1, false);
+  manager.SetComponentData<components::Sleeping>(e3, true);
+  EXPECT_EQ(std::set<Entity>({e1, e2}), awakeEntities());
+
+  // Each still visits all entities
+  EXPECT_EQ(3, eachCount<IntComponent>(manager));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(Snapshot))
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.SetParentEntity(e2, e1);
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.5));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+
+  auto snapshot1 = manager.Snapshot();
+  ASSERT_NE(nullptr, snapshot1);
+  EXPECT_EQ(2u, snapshot1->EntityCount());
+  EXPECT_TRUE(snapshot1->HasEntity(e1));
+  EXPECT_TRUE(snapshot1->HasEntity(e2));
+  EXPECT_EQ(e1, snapshot1->ParentEntity(e2));
+  EXPECT_EQ(2u, snapshot1->ComponentTypes(e1).size());
+  ASSERT_NE(nullptr, snapshot1->Component<IntComponent>(e1));
+  EXPECT_EQ(1, snapshot1->Component<IntComponent>(e1)->Data());
+
+  // Nothing changed, same snapshot
+  EXPECT_EQ(snapshot1, manager.Snapshot());
+
+  // Change a component
+  manager.SetComponentData<IntComponent>(e1, 10);
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+
+  auto snapshot2 = manager.Snapshot();
+  ASSERT_NE(nullptr, snapshot2);
+  EXPECT_NE(snapshot1, snapshot2);
+  EXPECT_EQ(snapshot1->Version() + 1u, snapshot2->Version());
+  EXPECT_EQ(10, snapshot2->Component<IntComponent>(e1)->Data());
+
+  // The old snapshot is not affected
+  EXPECT_EQ(1, snapshot1->Component<IntComponent>(e1)->Data());
+
+  // Components which didn't change are shared
+  EXPECT_EQ(snapshot1->Component<DoubleComponent>(e1),
+      snapshot2->Component<DoubleComponent>(e1));
+  EXPECT_EQ(snapshot1->Component<IntComponent>(e2),
+      snapshot2->Component<IntComponent>(e2));
+  EXPECT_NE(snapshot1->Component<IntComponent>(e1),
+      snapshot2->Component<IntComponent>(e1));
+
+  // Each
+  int count{0};
+  snapshot2->Each<IntComponent>(
+      [&](const Entity &, const IntComponent *_int) -> bool
+      {
+        EXPECT_NE(nullptr, _int);
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(2, count);
+
+  count = 0;
+  snapshot2->Each<IntComponent, DoubleComponent>(
+      [&](const Entity &_entity, const IntComponent *,
+          const DoubleComponent *_double) -> bool
+      {
+        EXPECT_EQ(e1, _entity);
+        EXPECT_DOUBLE_EQ(0.5, _double->Data());
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(1, count);
+
+  // Remove a component and an entity, and create a new entity
+  manager.RemoveComponent<DoubleComponent>(e1);
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  Entity e3 = manager.CreateEntity();
+
+  auto snapshot3 = manager.Snapshot();
+  EXPECT_EQ(2u, snapshot3->EntityCount());
+  EXPECT_EQ(nullptr, snapshot3->Component<DoubleComponent>(e1));
+  EXPECT_FALSE(snapshot3->HasEntity(e2));
+  EXPECT_TRUE(snapshot3->HasEntity(e3));
+  EXPECT_EQ(std::vector<Entity>({e1, e3}), snapshot3->Entities());
+
+  // Older snapshots still have everything
+  EXPECT_TRUE(snapshot2->HasEntity(e2));
+  EXPECT_NE(nullptr, snapshot2->Component<DoubleComponent>(e1));
+
+  // Removing all entities
+  manager.RequestRemoveEntities();
+  manager.ProcessEntityRemovals();
+  auto snapshot4 = manager.Snapshot();
+  EXPECT_EQ(0u, snapshot4->EntityCount());
+  EXPECT_TRUE(snapshot4->Entities().empty());
+  EXPECT_EQ(2u, snapshot3->EntityCount());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(ResetTo))
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.SetParentEntity(e2, e1);
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.5));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+
+  auto snapshot = manager.Snapshot();
+  ASSERT_NE(nullptr, snapshot);
+
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+
+  // Change, remove and create components and entities
+  manager.SetComponentData<IntComponent>(e1, 10);
+  manager.RemoveComponent<DoubleComponent>(e1);
+  manager.CreateComponent<StringComponent>(e1, StringComponent("new"));
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e3, IntComponent(3));
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunClearRemovedComponents();
+  manager.RunSetAllComponentsUnchanged();
+
+  EXPECT_EQ(2, eachCount<IntComponent>(manager));
+
+  manager.ResetTo(*snapshot);
+
+  // Entities created after the snapshot are removed
+  EXPECT_TRUE(manager.HasEntitiesMarkedForRemoval());
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(manager.HasEntity(e3));
+
+  // Removed entities are back, as new entities, with their parents
+  ASSERT_TRUE(manager.HasEntity(e2));
+  EXPECT_TRUE(manager.IsNewEntity(e2));
+  EXPECT_FALSE(manager.IsNewEntity(e1));
+  EXPECT_EQ(e1, manager.ParentEntity(e2));
+  ASSERT_NE(nullptr, manager.Component<IntComponent>(e2));
+  EXPECT_EQ(2, manager.Component<IntComponent>(e2)->Data());
+
+  // Components are restored and marked as changed
+  ASSERT_NE(nullptr, manager.Component<IntComponent>(e1));
+  EXPECT_EQ(1, manager.Component<IntComponent>(e1)->Data());
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(e1, IntComponent::typeId));
+  ASSERT_NE(nullptr, manager.Component<DoubleComponent>(e1));
+  EXPECT_DOUBLE_EQ(0.5, manager.Component<DoubleComponent>(e1)->Data());
+  EXPECT_EQ(nullptr, manager.Component<StringComponent>(e1));
+
+  // Views see the restored components
+  int sum{0};
+  manager.Each<IntComponent>(
+      [&](const Entity &, const IntComponent *_int) -> bool
+      {
+        sum += _int->Data();
+        return true;
+      });
+  EXPECT_EQ(3, sum);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(Mirror))
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.SetParentEntity(e2, e1);
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  Custom custom;
+  custom.dummy = 5;
+  manager.CreateComponent<CustomComponent>(e1, CustomComponent(custom));
+
+  EntityComponentManager mirror;
+  mirror.Mirror(manager.Snapshot(), &manager);
+
+  // Everything is copied, including components without a serializer
+  ASSERT_TRUE(mirror.HasEntity(e1));
+  ASSERT_TRUE(mirror.HasEntity(e2));
+  EXPECT_TRUE(mirror.IsNewEntity(e2));
+  EXPECT_EQ(e1, mirror.ParentEntity(e2));
+  ASSERT_NE(nullptr, mirror.Component<CustomComponent>(e1));
+  EXPECT_EQ(5, mirror.Component<CustomComponent>(e1)->Data().dummy);
+  EXPECT_EQ(3, eachCount<IntComponent>(mirror) +
+      eachCount<CustomComponent>(mirror));
+
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+
+  // Change, remove and create components and entities
+  manager.SetComponentData<IntComponent>(e1, 10);
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::PeriodicChange);
+  custom.dummy = 6;
+  manager.SetComponentData<CustomComponent>(e1, custom);
+  manager.SetChanged(e1, CustomComponent::typeId,
+      ComponentState::OneTimeChange);
+  manager.CreateComponent<StringComponent>(e1, StringComponent("new"));
+  manager.RequestRemoveEntity(e2);
+  Entity e3 = manager.CreateEntity();
+  manager.SetParentEntity(e3, e1);
+  manager.CreateComponent<IntComponent>(e3, IntComponent(3));
+
+  // Snapshots can be taken from PostUpdate, through a const reference
+  const EntityComponentManager &constManager = manager;
+  mirror.Mirror(constManager.Snapshot(), &manager);
+
+  // Data is copied, with the same change state
+  ASSERT_NE(nullptr, mirror.Component<IntComponent>(e1));
+  EXPECT_EQ(10, mirror.Component<IntComponent>(e1)->Data());
+  EXPECT_EQ(ComponentState::PeriodicChange,
+      mirror.ComponentState(e1, IntComponent::typeId));
+  ASSERT_NE(nullptr, mirror.Component<CustomComponent>(e1));
+  EXPECT_EQ(6, mirror.Component<CustomComponent>(e1)->Data().dummy);
+  ASSERT_NE(nullptr, mirror.Component<StringComponent>(e1));
+  EXPECT_EQ("new", mirror.Component<StringComponent>(e1)->Data());
+
+  // Removals are requested, and new entities are created
+  EXPECT_TRUE(mirror.IsMarkedForRemoval(e2));
+  ASSERT_TRUE(mirror.HasEntity(e3));
+  EXPECT_TRUE(mirror.IsNewEntity(e3));
+  EXPECT_EQ(e1, mirror.ParentEntity(e3));
+
+  // Views which cached the old components see the new ones
+  int sum{0};
+  mirror.Each<IntComponent>(
+      [&](const Entity &, const IntComponent *_int) -> bool
+      {
+        sum += _int->Data();
+        return true;
+      });
+  EXPECT_EQ(15, sum);
+  mirror.Each<CustomComponent>(
+      [&](const Entity &, const CustomComponent *_custom) -> bool
+      {
+        EXPECT_EQ(6, _custom->Data().dummy);
+        return true;
+      });
+
+  // Unchanged components are not copied again, and changes of the previous
+  // call are cleared. Without a source, changes are one-time changes.
+  manager.ProcessEntityRemovals();
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  const auto *mirrored = mirror.Component<IntComponent>(e3);
+  manager.SetComponentData<IntComponent>(e1, 11);
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::PeriodicChange);
+  manager.RemoveComponent<StringComponent>(e1);
+  mirror.Mirror(manager.Snapshot());
+
+  EXPECT_FALSE(mirror.HasEntity(e2));
+  EXPECT_FALSE(mirror.IsNewEntity(e3));
+  EXPECT_EQ(mirrored, mirror.Component<IntComponent>(e3));
+  EXPECT_EQ(ComponentState::NoChange,
+      mirror.ComponentState(e3, IntComponent::typeId));
+  EXPECT_EQ(11, mirror.Component<IntComponent>(e1)->Data());
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      mirror.ComponentState(e1, IntComponent::typeId));
+  EXPECT_EQ(nullptr, mirror.Component<StringComponent>(e1));
+
+  // Mirroring the same snapshot again only clears the changes
+  mirror.Mirror(manager.Snapshot());
+  EXPECT_EQ(ComponentState::NoChange,
+      mirror.ComponentState(e1, IntComponent::typeId));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(ComponentChangeCount))
+{
+  EXPECT_EQ(0u, manager.ComponentChangeCount(IntComponent::typeId));
+
+  // Creation, changes and removal are counted
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  EXPECT_EQ(1u, manager.ComponentChangeCount(IntComponent::typeId));
+
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::PeriodicChange);
+  manager.SetChanged(e1, IntComponent::typeId,
+      ComponentState::NoChange);
+  EXPECT_EQ(2u, manager.ComponentChangeCount(IntComponent::typeId));
+
+  // The count isn't reset with the changes
+  manager.RunSetAllComponentsUnchanged();
+  manager.RunClearNewlyCreatedEntities();
+  EXPECT_EQ(2u, manager.ComponentChangeCount(IntComponent::typeId));
+
+  manager.RemoveComponent<IntComponent>(e1);
+  manager.RunClearRemovedComponents();
+  EXPECT_EQ(3u, manager.ComponentChangeCount(IntComponent::typeId));
+  EXPECT_EQ(0u, manager.ComponentChangeCount(DoubleComponent::typeId));
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_SUITE_P(EntityComponentManagerRepeat,
@@ -0,0 +1,630 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/LogQuery.hh"
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/transport/log/Batch.hh>
+#include <ignition/transport/log/Log.hh>
+#include <ignition/transport/log/QualifiedTime.hh>
+#include <ignition/transport/log/QueryOptions.hh>
+
+#include "ignition/gazebo/components/Factory.hh"
+#include "ignition/gazebo/components/JointForce.hh"
+#include "ignition/gazebo/components/JointPosition.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/Pose.hh"
+
+#include "ignition/gazebo/MappedStateLog.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Private data for LogQuery
+class ignition::gazebo::LogQueryPrivate
+{
+  /// \brief Open a log and load the time of each state message, without
+  /// parsing them.
+  /// \param[in] _path Path to a state.mlog or state.tlog file.
+  /// \return True if successful.
+  public: bool Open(const std::string &_path);
+
+  /// \brief Number of state messages.
+  /// \return Message count.
+  public: std::size_t Count() const;
+
+  /// \brief Sim time of a state message.
+  /// \param[in] _index Index of the message, less than Count().
+  /// \return Sim time.
+  public: std::chrono::nanoseconds Time(std::size_t _index) const;
+
+  /// \brief Find the first state message at or after a given time.
+  /// \param[in] _time Sim time.
+  /// \return Index of the message, or Count() if there's none.
+  public: std::size_t LowerBound(const std::chrono::nanoseconds &_time) const;
+
+  /// \brief Find the first state message after a given time.
+  /// \param[in] _time Sim time.
+  /// \return Index of the message, or Count() if there's none.
+  public: std::size_t UpperBound(const std::chrono::nanoseconds &_time) const;
+
+  /// \brief Parse a range of state messages, in order. Messages which fail
+  /// to parse are skipped.
+  /// \param[in] _first Index of the first message.
+  /// \param[in] _last Index after the last message.
+  /// \param[in] _callback Called with the index and content of each
+  /// message. Returns false to stop.
+  public: void EachState(std::size_t _first, std::size_t _last,
+      const std::function<bool(std::size_t,
+          const msgs::SerializedStateMap &)> &_callback);
+
+  /// \brief Parse the state messages which haven't been scanned for entity
+  /// names yet, until a function returns true or the log ends.
+  /// \param[in] _done Called after each message. Returns true to stop.
+  public: void ScanNames(const std::function<bool()> &_done);
+
+  /// \brief Get the scoped name of an entity whose name has been scanned.
+  /// \param[in] _entity Entity
+  /// \return Scoped name without the world, or empty if unknown.
+  public: std::string ScopedName(const Entity _entity) const;
+
+  /// \brief Query the changes of components of an entity in a range of
+  /// state messages.
+  /// \param[in] _entity Entity to query.
+  /// \param[in] _types Component types to query.
+  /// \param[in] _first Index of the first message.
+  /// \param[in] _last Index after the last message.
+  /// \param[in] _callback Function called for each changed component.
+  /// \return False if a component type is unknown.
+  public: bool Each(const Entity _entity,
+      const std::vector<ComponentTypeId> &_types,
+      std::size_t _first, std::size_t _last,
+      const LogQuery::Callback &_callback);
+
+  /// \brief Log being queried, if it's a state.tlog file.
+  public: transport::log::Log log;
+
+  /// \brief Log being queried, if it's a state.mlog file.
+  public: MappedStateLogReader mappedLog;
+
+  /// \brief Whether the log is a state.mlog file.
+  public: bool mapped{false};
+
+  /// \brief Sorted times of the state messages of a state.tlog file. For
+  /// state.mlog files, the index stored in the file is used instead.
+  public: std::vector<std::chrono::nanoseconds> times;
+
+  /// \brief Whether the log has been opened and indexed
+  public: bool valid{false};
+
+  /// \brief Number of state messages scanned for entity names so far.
+  public: std::size_t namesScanned{0};
+
+  /// \brief Unscoped name of each entity scanned so far
+  public: std::unordered_map<Entity, std::string> names;
+
+  /// \brief Parent of each entity scanned so far
+  public: std::unordered_map<Entity, Entity> parents;
+
+  /// \brief Entities scanned so far, in the order in which they were created
+  public: std::vector<Entity> creationOrder;
+
+  /// \brief Index of the state message in which each entity was created
+  public: std::unordered_map<Entity, std::size_t> creationIndex;
+};
+
+//////////////////////////////////////////////////
+bool LogQueryPrivate::Open(const std::string &_path)
+{
+  IGN_PROFILE("LogQueryPrivate::Open");
+
+  if (_path.size() >= 5u && _path.substr(_path.size() - 5u) == ".mlog")
+  {
+    this->mapped = this->mappedLog.Open(_path);
+    return this->mapped;
+  }
+
+  if (!this->log.Open(_path))
+  {
+    ignerr << "Failed to open log file [" << _path << "]." << std::endl;
+    return false;
+  }
+
+  // Only the times are kept, messages are parsed when they're queried
+  auto batch = this->log.QueryMessages(transport::log::TopicPattern(
+      std::regex(".*/changed_state")));
+  for (const auto &msg : batch)
+    this->times.push_back(msg.TimeReceived());
+
+  // Messages are returned in chronological order, but make sure
+  std::sort(this->times.begin(), this->times.end());
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t LogQueryPrivate::Count() const
+{
+  return this->mapped ? this->mappedLog.Count() : this->times.size();
+}
+
+//////////////////////////////////////////////////
+std::chrono::nanoseconds LogQueryPrivate::Time(std::size_t _index) const
+{
+  if (this->mapped)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        this->mappedLog.Time(_index));
+  }
+
+  if (_index >= this->times.size())
+    return std::chrono::nanoseconds::zero();
+  return this->times[_index];
+}
+
+//////////////////////////////////////////////////
+std::size_t LogQueryPrivate::LowerBound(
+    const std::chrono::nanoseconds &_time) const
+{
+  if (this->mapped)
+  {
+    return this->mappedLog.LowerBound(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        _time));
+  }
+
+  return static_cast<std::size_t>(std::lower_bound(this->times.begin(),
+      this->times.end(), _time) - this->times.begin());
+}
+
+//////////////////////////////////////////////////
+std::size_t LogQueryPrivate::UpperBound(
+    const std::chrono::nanoseconds &_time) const
+{
+  if (_time == std::chrono::nanoseconds::max())
+    return this->Count();
+
+  return this->LowerBound(_time + std::chrono::nanoseconds(1));
+}
+
+//////////////////////////////////////////////////
+void LogQueryPrivate::EachState(std::size_t _first, std::size_t _last,
+    const std::function<bool(std::size_t,
+        const msgs::SerializedStateMap &)> &_callback)
+{
+  IGN_PROFILE("LogQueryPrivate::EachState");
+
+  _last = std::min(_last, this->Count());
+  if (_first >= _last)
+    return;
+
+  msgs::SerializedStateMap stateMsg;
+  if (this->mapped)
+  {
+    for (std::size_t i = _first; i < _last; ++i)
+    {
+      if (!this->mappedLog.Message(i, stateMsg))
+      {
+        ignwarn << "Failed to parse state message [" << i << "]. Skipping."
+                << std::endl;
+        continue;
+      }
+      if (!_callback(i, stateMsg))
+        return;
+    }
+    return;
+  }
+
+  // Query the time range of the messages. Messages recorded at the same time
+  // as the first one, but before it, are skipped.
+  auto start = this->times[_first];
+  std::size_t i = this->LowerBound(start);
+  auto batch = this->log.QueryMessages(transport::log::TopicPattern(
+      std::regex(".*/changed_state"),
+      transport::log::QualifiedTimeRange(
+        transport::log::QualifiedTime(start),
+        transport::log::QualifiedTime(this->times[_last - 1]))));
+
+  for (auto it = batch.begin(); it != batch.end() && i < _last; ++it, ++i)
+  {
+    if (i < _first)
+      continue;
+
+    if (!stateMsg.ParseFromString(it->Data()))
+    {
+      ignwarn << "Failed to parse state message at ["
+              << it->TimeReceived().count() << "] ns. Skipping."
+              << std::endl;
+      continue;
+    }
+    if (!_callback(i, stateMsg))
+      return;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogQueryPrivate::ScanNames(const std::function<bool()> &_done)
+{
+  IGN_PROFILE("LogQueryPrivate::ScanNames");
+
+  this->EachState(this->namesScanned, this->Count(),
+      [&](std::size_t _index, const msgs::SerializedStateMap &_msg) -> bool
+  {
+    for (const auto &entityIter : _msg.entities())
+    {
+      Entity entity = entityIter.first;
+
+      // Only the name and parent are deserialized. They're only recorded
+      // when entities are created, so this is cheap.
+      const auto &comps = entityIter.second.components();
+      auto nameIter = comps.find(components::Name::typeId);
+      if (nameIter != comps.end())
+      {
+        if (this->names.find(entity) == this->names.end())
+        {
+          this->creationOrder.push_back(entity);
+          this->creationIndex[entity] = _index;
+        }
+
+        components::Name name;
+        std::istringstream istr(nameIter->second.component());
+        name.Deserialize(istr);
+        this->names[entity] = name.Data();
+      }
+
+      auto parentIter = comps.find(components::ParentEntity::typeId);
+      if (parentIter != comps.end())
+      {
+        components::ParentEntity parent;
+        std::istringstream istr(parentIter->second.component());
+        parent.Deserialize(istr);
+        this->parents[entity] = parent.Data();
+      }
+    }
+    this->namesScanned = _index + 1;
+    return !_done();
+  });
+}
+
+//////////////////////////////////////////////////
+std::string LogQueryPrivate::ScopedName(const Entity _entity) const
+{
+  auto nameIter = this->names.find(_entity);
+  if (nameIter == this->names.end())
+    return "";
+
+  std::string scopedName = nameIter->second;
+  Entity entity = _entity;
+  while (true)
+  {
+    auto parentIter = this->parents.find(entity);
+    if (parentIter == this->parents.end())
+      break;
+
+    entity = parentIter->second;
+
+    // Skip the world, which is the only entity without a parent
+    if (this->parents.find(entity) == this->parents.end())
+      break;
+
+    nameIter = this->names.find(entity);
+    if (nameIter == this->names.end())
+      break;
+    scopedName = nameIter->second + "::" + scopedName;
+  }
+  return scopedName;
+}
+
+//////////////////////////////////////////////////
+bool LogQueryPrivate::Each(const Entity _entity,
+    const std::vector<ComponentTypeId> &_types,
+    std::size_t _first, std::size_t _last,
+    const LogQuery::Callback &_callback)
+{
+  IGN_PROFILE("LogQueryPrivate::Each");
+
+  std::vector<std::unique_ptr<components::BaseComponent>> comps;
+  for (const auto &type : _types)
+  {
+    auto comp = components::Factory::Instance()->New(type);
+    if (nullptr == comp)
+    {
+      ignerr << "Unknown component type [" << type << "]." << std::endl;
+      return false;
+    }
+    comps.push_back(std::move(comp));
+  }
+
+  // Nothing changes before the entity is created
+  auto createdIter = this->creationIndex.find(_entity);
+  if (createdIter != this->creationIndex.end())
+    _first = std::max(_first, createdIter->second);
+
+  // Each message is parsed once, and only the requested components are
+  // deserialized
+  this->EachState(_first, _last,
+      [&](std::size_t _index, const msgs::SerializedStateMap &_msg) -> bool
+  {
+    auto entityIter = _msg.entities().find(_entity);
+    if (entityIter == _msg.entities().end())
+      return true;
+
+    auto simTime = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(this->Time(_index));
+    const auto &msgComps = entityIter->second.components();
+    for (auto &comp : comps)
+    {
+      auto compIter = msgComps.find(comp->TypeId());
+      if (compIter == msgComps.end() || compIter->second.remove())
+        continue;
+
+      std::istringstream istr(compIter->second.component());
+      comp->Deserialize(istr);
+      if (!_callback(simTime, *comp))
+        return false;
+    }
+    return true;
+  });
+  return true;
+}
+
+//////////////////////////////////////////////////
+LogQuery::LogQuery(const std::string &_path)
+  : dataPtr(std::make_unique<LogQueryPrivate>())
+{
+  std::string path = _path;
+  if (common::isDirectory(path))
+  {
+    // Prefer the log with a stored index
+    std::string mappedPath = common::joinPaths(path, "state.mlog");
+    if (common::isFile(mappedPath))
+      path = mappedPath;
+    else
+      path = common::joinPaths(path, "state.tlog");
+  }
+
+  if (!common::isFile(path))
+  {
+    ignerr << "Log file [" << path << "] not found." << std::endl;
+    return;
+  }
+
+  this->dataPtr->valid = this->dataPtr->Open(path);
+}
+
+//////////////////////////////////////////////////
+LogQuery::~LogQuery() = default;
+
+//////////////////////////////////////////////////
+bool LogQuery::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+//////////////////////////////////////////////////
+std::size_t LogQuery::Count() const
+{
+  return this->dataPtr->Count();
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration LogQuery::Time(std::size_t _index) const
+{
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      this->dataPtr->Time(_index));
+}
+
+//////////////////////////////////////////////////
+std::size_t LogQuery::LowerBound(
+    const std::chrono::steady_clock::duration &_time) const
+{
+  return this->dataPtr->LowerBound(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_time));
+}
+
+//////////////////////////////////////////////////
+std::string LogQuery::ScopedName(const Entity _entity) const
+{
+  this->dataPtr->ScanNames([&]() -> bool
+  {
+    return this->dataPtr->names.find(_entity) != this->dataPtr->names.end();
+  });
+  return this->dataPtr->ScopedName(_entity);
+}
+
+//////////////////////////////////////////////////
+Entity LogQuery::EntityByName(const std::string &_name) const
+{
+  // Check the entities scanned so far, and only parse more states until a
+  // scoped match is found. Unscoped matches need the whole log, since a
+  // scoped match takes precedence.
+  Entity scopedMatch{kNullEntity};
+  Entity unscopedMatch{kNullEntity};
+  std::size_t checked{0};
+  auto check = [&]() -> bool
+  {
+    const auto &order = this->dataPtr->creationOrder;
+    for (; checked < order.size(); ++checked)
+    {
+      Entity entity = order[checked];
+      if (this->dataPtr->ScopedName(entity) == _name)
+      {
+        scopedMatch = entity;
+        return true;
+      }
+
+      if (unscopedMatch == kNullEntity &&
+          this->dataPtr->names.at(entity) == _name)
+      {
+        unscopedMatch = entity;
+      }
+    }
+    return false;
+  };
+
+  if (!check())
+    this->dataPtr->ScanNames(check);
+
+  return kNullEntity != scopedMatch ? scopedMatch : unscopedMatch;
+}
+
+//////////////////////////////////////////////////
+ComponentTypeId LogQuery::ComponentTypeIdFromName(const std::string &_name)
+{
+  const std::string prefix{"ign_gazebo_components."};
+  for (const auto &[typeId, name] : components::Factory::Instance()->namesById)
+  {
+    if (name == _name || name == prefix + _name)
+      return typeId;
+  }
+  return kComponentTypeIdInvalid;
+}
+
+//////////////////////////////////////////////////
+bool LogQuery::Each(const Entity _entity,
+    const std::vector<ComponentTypeId> &_types,
+    const Callback &_callback) const
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  return this->dataPtr->Each(_entity, _types, 0u, this->dataPtr->Count(),
+      _callback);
+}
+
+//////////////////////////////////////////////////
+bool LogQuery::Each(const Entity _entity,
+    const std::vector<ComponentTypeId> &_types,
+    const std::chrono::steady_clock::duration &_start,
+    const std::chrono::steady_clock::duration &_end,
+    const Callback &_callback) const
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  return this->dataPtr->Each(_entity, _types,
+      this->dataPtr->LowerBound(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_start)),
+      this->dataPtr->UpperBound(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_end)),
+      _callback);
+}
+
+//////////////////////////////////////////////////
+bool LogQuery::WriteCsv(std::ostream &_out,
+    const std::string &_entityName,
+    const std::vector<std::string> &_componentNames) const
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  auto entity = this->EntityByName(_entityName);
+  if (kNullEntity == entity)
+  {
+    ignerr << "Entity [" << _entityName << "] not found in log." << std::endl;
+    return false;
+  }
+
+  std::vector<ComponentTypeId> types;
+  std::unordered_map<ComponentTypeId, std::string> names;
+  for (const auto &name : _componentNames)
+  {
+    auto typeId = ComponentTypeIdFromName(name);
+    if (kComponentTypeIdInvalid == typeId)
+    {
+      ignerr << "Unknown component [" << name << "]." << std::endl;
+      return false;
+    }
+    types.push_back(typeId);
+    names[typeId] = name;
+  }
+
+  std::unordered_set<ComponentTypeId> unsupported;
+
+  _out << "sim_time,component,values" << std::endl;
+  _out << std::setprecision(9) << std::fixed;
+  return this->Each(entity, types,
+      [&](const std::chrono::steady_clock::duration &_simTime,
+          const components::BaseComponent &_comp) -> bool
+  {
+    std::ostringstream values;
+    values << std::setprecision(std::numeric_limits<double>::max_digits10)
+           << std::defaultfloat;
+
+    // Joint states are serialized as binary messages
+    const std::vector<double> *vec{nullptr};
+    if (auto joint = dynamic_cast<const components::JointPosition *>(&_comp))
+      vec = &joint->Data();
+    else if (auto vel = dynamic_cast<const components::JointVelocity *>(&_comp))
+      vec = &vel->Data();
+    else if (auto force = dynamic_cast<const components::JointForce *>(&_comp))
+      vec = &force->Data();
+
+    if (nullptr != vec)
+    {
+      for (const auto &value : *vec)
+        values << "," << value;
+    }
+    else
+    {
+      // Other numeric components are serialized as space separated text
+      std::ostringstream ostr;
+      _comp.Serialize(ostr);
+      auto data = ostr.str();
+      bool printable = std::all_of(data.begin(), data.end(), [](char _c)
+          {
+            return std::isprint(static_cast<unsigned char>(_c)) ||
+                std::isspace(static_cast<unsigned char>(_c));
+          });
+      if (!printable)
+      {
+        if (unsupported.insert(_comp.TypeId()).second)
+        {
+          ignwarn << "Component [" << names[_comp.TypeId()]
+                  << "] can't be written as CSV." << std::endl;
+        }
+        return true;
+      }
+
+      std::istringstream istr(data);
+      std::string token;
+      while (istr >> token)
+        values << "," << token;
+    }
+
+    _out << std::chrono::duration<double>(_simTime).count() << ","
+         << names[_comp.TypeId()] << values.str() << "\n";
+    return true;
+  });
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include <regex>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/transport/log/Log.hh>
+#include <ignition/transport/log/QueryOptions.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/LogQuery.hh"
+#include "ignition/gazebo/test_config.hh"
+#include "../test/helpers/EnvTestFixture.hh"
+
+#include "ignition/gazebo/MappedStateLog.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+class LogQueryTest : public InternalFixture<::testing::Test>
+{
+  /// \brief Log recorded with a sphere rolling down a ramp
+  public: std::string logPath = common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "media", "rolling_shapes_log");
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogQueryTest, Invalid)
+{
+  LogQuery query(common::joinPaths(this->logPath, "does_not_exist"));
+  EXPECT_FALSE(query.Valid());
+  EXPECT_EQ(kNullEntity, query.EntityByName("sphere"));
+
+  std::ostringstream out;
+  EXPECT_FALSE(query.WriteCsv(out, "sphere", {"Pose"}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogQueryTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Pose))
+{
+  LogQuery query(this->logPath);
+  ASSERT_TRUE(query.Valid());
+
+  EXPECT_EQ(kNullEntity, query.EntityByName("not_a_model"));
+
+  auto sphere = query.EntityByName("sphere");
+  ASSERT_NE(kNullEntity, sphere);
+  EXPECT_EQ("sphere", query.ScopedName(sphere));
+
+  EXPECT_EQ(components::Pose::typeId,
+      LogQuery::ComponentTypeIdFromName("Pose"));
+  EXPECT_EQ(components::Pose::typeId,
+      LogQuery::ComponentTypeIdFromName("ign_gazebo_components.Pose"));
+  EXPECT_EQ(kComponentTypeIdInvalid,
+      LogQuery::ComponentTypeIdFromName("NotAComponent"));
+
+  int count{0};
+  std::chrono::steady_clock::duration lastTime{-1};
+  math::Pose3d firstPose;
+  math::Pose3d lastPose;
+  EXPECT_TRUE(query.Each(sphere, {components::Pose::typeId},
+      [&](const std::chrono::steady_clock::duration &_simTime,
+          const components::BaseComponent &_comp) -> bool
+      {
+        EXPECT_GT(_simTime, lastTime);
+        lastTime = _simTime;
+
+        auto pose = dynamic_cast<const components::Pose *>(&_comp);
+        EXPECT_NE(nullptr, pose);
+        if (count == 0)
+          firstPose = pose->Data();
+        lastPose = pose->Data();
+        ++count;
+        return true;
+      }));
+
+  // The sphere moves during the log
+  EXPECT_GT(count, 1);
+  EXPECT_NE(firstPose, lastPose);
+
+  // Stop early
+  int stopCount{0};
+  EXPECT_TRUE(query.Each(sphere, {components::Pose::typeId},
+      [&](const std::chrono::steady_clock::duration &,
+          const components::BaseComponent &) -> bool
+      {
+        return ++stopCount < 3;
+      }));
+  EXPECT_EQ(3, stopCount);
+
+  // CSV has a header and one row per change
+  std::ostringstream out;
+  EXPECT_TRUE(query.WriteCsv(out, "sphere", {"Pose"}));
+  std::istringstream in(out.str());
+  std::string line;
+  ASSERT_TRUE(std::getline(in, line));
+  EXPECT_EQ("sim_time,component,values", line);
+  int rows{0};
+  while (std::getline(in, line))
+  {
+    // Time, name and 6 pose values
+    EXPECT_EQ(7, std::count(line.begin(), line.end(), ',')) << line;
+    ++rows;
+  }
+  EXPECT_EQ(count, rows);
+
+  EXPECT_FALSE(query.WriteCsv(out, "sphere", {"NotAComponent"}));
+  EXPECT_FALSE(query.WriteCsv(out, "not_a_model", {"Pose"}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogQueryTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RandomAccess))
+{
+  LogQuery query(this->logPath);
+  ASSERT_TRUE(query.Valid());
+  ASSERT_GT(query.Count(), 4u);
+
+  for (std::size_t i = 1; i < query.Count(); ++i)
+    EXPECT_LE(query.Time(i - 1), query.Time(i));
+
+  auto last = query.Time(query.Count() - 1);
+  EXPECT_EQ(0u, query.LowerBound(0ns));
+  EXPECT_EQ(query.Count(), query.LowerBound(last + 1ns));
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      query.Time(query.Count()));
+
+  auto mid = query.Time(query.Count() / 2);
+  EXPECT_LE(query.LowerBound(mid), query.Count() / 2);
+  EXPECT_EQ(mid, query.Time(query.LowerBound(mid)));
+
+  // Only changes in the range are returned
+  auto sphere = query.EntityByName("sphere");
+  ASSERT_NE(kNullEntity, sphere);
+  auto start = query.Time(query.Count() / 4);
+  int inRange{0};
+  EXPECT_TRUE(query.Each(sphere, {components::Pose::typeId}, start, mid,
+      [&](const std::chrono::steady_clock::duration &_simTime,
+          const components::BaseComponent &) -> bool
+      {
+        EXPECT_GE(_simTime, start);
+        EXPECT_LE(_simTime, mid);
+        ++inRange;
+        return true;
+      }));
+  EXPECT_GT(inRange, 0);
+
+  int all{0};
+  EXPECT_TRUE(query.Each(sphere, {components::Pose::typeId},
+      [&](const std::chrono::steady_clock::duration &_simTime,
+          const components::BaseComponent &) -> bool
+      {
+        if (_simTime >= start && _simTime <= mid)
+          ++all;
+        return true;
+      }));
+  EXPECT_EQ(all, inRange);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogQueryTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(MappedLog))
+{
+  // Copy the state of the test log into a state.mlog
+  auto dir = common::joinPaths(PROJECT_BINARY_PATH, "test", "log_query");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+  {
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(common::joinPaths(this->logPath, "state.tlog")));
+
+    MappedStateLogWriter writer;
+    ASSERT_TRUE(writer.Open(common::joinPaths(dir, "state.mlog")));
+
+    msgs::SerializedStateMap msg;
+    auto batch = log.QueryMessages(transport::log::TopicPattern(
+        std::regex(".*/changed_state")));
+    for (const auto &logMsg : batch)
+    {
+      ASSERT_TRUE(msg.ParseFromString(logMsg.Data()));
+      EXPECT_TRUE(writer.Append(logMsg.TimeReceived(), msg));
+    }
+    EXPECT_TRUE(writer.Close());
+  }
+
+  LogQuery tlogQuery(this->logPath);
+  LogQuery mlogQuery(dir);
+  ASSERT_TRUE(tlogQuery.Valid());
+  ASSERT_TRUE(mlogQuery.Valid());
+
+  ASSERT_EQ(tlogQuery.Count(), mlogQuery.Count());
+  EXPECT_EQ(tlogQuery.Time(tlogQuery.Count() - 1),
+      mlogQuery.Time(mlogQuery.Count() - 1));
+
+  auto sphere = mlogQuery.EntityByName("sphere");
+  EXPECT_NE(kNullEntity, sphere);
+  EXPECT_EQ(tlogQuery.EntityByName("sphere"), sphere);
+
+  // Both formats give the same series
+  std::ostringstream tlogCsv;
+  std::ostringstream mlogCsv;
+  EXPECT_TRUE(tlogQuery.WriteCsv(tlogCsv, "sphere", {"Pose"}));
+  EXPECT_TRUE(mlogQuery.WriteCsv(mlogCsv, "sphere", {"Pose"}));
+  auto csv = mlogCsv.str();
+  EXPECT_GT(std::count(csv.begin(), csv.end(), '\n'), 1);
+  EXPECT_EQ(tlogCsv.str(), csv);
+
+  common::removeAll(dir);
+}
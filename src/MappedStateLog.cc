@@ -0,0 +1,696 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/MappedStateLog.hh"
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Private data for MappedStateLogWriter
+class ignition::gazebo::MappedStateLogWriterPrivate
+{
+  /// \brief File descriptor.
+  public: int fd{-1};
+
+  /// \brief Mapped memory.
+  public: char *data{nullptr};
+
+  /// \brief Size of the file and of the mapping.
+  public: std::size_t capacity{0};
+
+  /// \brief Number of bytes written.
+  public: std::size_t size{0};
+
+  /// \brief Time of the last message appended.
+  public: int64_t lastTime{0};
+
+  /// \brief Index being built as records are appended.
+  public: std::vector<MappedStateLogIndexEntry> index;
+
+  /// \brief Whether growing the file failed and it's no longer mapped.
+  public: bool failed{false};
+};
+
+/// \brief Private data for StreamedStateLogWriter
+class ignition::gazebo::StreamedStateLogWriterPrivate
+{
+  /// \brief Receives the chunks.
+  public: StreamedStateLogWriter::Sink sink;
+
+  /// \brief Size at which chunks are handed to the sink.
+  public: std::size_t chunkSize{0};
+
+  /// \brief Chunk being filled.
+  public: std::string chunk;
+
+  /// \brief Number of bytes written, including the current chunk.
+  public: std::size_t size{0};
+
+  /// \brief Time of the last message appended.
+  public: int64_t lastTime{0};
+
+  /// \brief Index being built as records are appended.
+  public: std::vector<MappedStateLogIndexEntry> index;
+
+  /// \brief Whether the log was closed.
+  public: bool closed{false};
+
+  /// \brief Whether the sink failed to write a chunk.
+  public: bool failed{false};
+};
+
+/// \brief Private data for MappedStateLogReader
+class ignition::gazebo::MappedStateLogReaderPrivate
+{
+  /// \brief Mapped file.
+  public: const char *data{nullptr};
+
+  /// \brief Size of the mapped file.
+  public: std::size_t size{0};
+
+  /// \brief Index stored in the file.
+  public: const MappedStateLogIndexEntry *index{nullptr};
+
+  /// \brief Number of entries in the index.
+  public: std::size_t count{0};
+
+  /// \brief Index rebuilt by scanning records, used if the file wasn't
+  /// closed cleanly.
+  public: std::vector<MappedStateLogIndexEntry> scannedIndex;
+};
+
+namespace
+{
+  /// \brief Identifies the start of a mapped state log.
+  constexpr char kHeaderMagic[8] = {'I', 'G', 'N', 'S', 'T', 'L', 'G', '\0'};
+
+  /// \brief Identifies the footer written when the log is closed.
+  constexpr char kFooterMagic[8] = {'I', 'G', 'N', 'S', 'I', 'D', 'X', '1'};
+
+  /// \brief Current format version.
+  constexpr uint32_t kVersion{1};
+
+  /// \brief File header.
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+  };
+
+  /// \brief Header of each record, followed by the serialized message and
+  /// padded to kAlignment. The length includes the header, so it's never
+  /// zero, even for empty messages.
+  struct RecordHeader
+  {
+    int64_t time;
+    uint64_t length;
+  };
+
+  /// \brief Written after the index when the log is closed.
+  struct Footer
+  {
+    uint64_t indexOffset;
+    uint64_t count;
+    char magic[8];
+  };
+
+  /// \brief Records and the index are aligned to this many bytes.
+  constexpr std::size_t kAlignment{8};
+
+  /// \brief Initial size of the file. It doubles every time it fills up.
+  constexpr std::size_t kInitialCapacity{64u * 1024u * 1024u};
+
+  //////////////////////////////////////////////////
+  std::size_t Align(std::size_t _size)
+  {
+    return (_size + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  //////////////////////////////////////////////////
+  std::chrono::steady_clock::duration ToDuration(int64_t _ns)
+  {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(_ns));
+  }
+}
+
+//////////////////////////////////////////////////
+MappedStateLogWriter::MappedStateLogWriter()
+  : dataPtr(std::make_unique<MappedStateLogWriterPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+MappedStateLogWriter::~MappedStateLogWriter()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogWriter::Open(const std::string &_path)
+{
+#ifdef _WIN32
+  ignerr << "Memory-mapped state logs are not supported on Windows. "
+         << "Can't open [" << _path << "]." << std::endl;
+  return false;
+#else
+  this->Close();
+
+  this->dataPtr->fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (this->dataPtr->fd < 0)
+  {
+    ignerr << "Failed to open [" << _path << "] for writing: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  this->dataPtr->size = 0;
+  this->dataPtr->lastTime = 0;
+  this->dataPtr->failed = false;
+  this->dataPtr->index.clear();
+  if (!this->Reserve(sizeof(Header)))
+  {
+    ::close(this->dataPtr->fd);
+    this->dataPtr->fd = -1;
+    return false;
+  }
+
+  Header header;
+  std::memcpy(header.magic, kHeaderMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.reserved = 0;
+  std::memcpy(this->dataPtr->data, &header, sizeof(header));
+  this->dataPtr->size = sizeof(Header);
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogWriter::IsOpen() const
+{
+  return this->dataPtr->fd >= 0;
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogWriter::Reserve(std::size_t _bytes)
+{
+#ifdef _WIN32
+  (void)_bytes;
+  return false;
+#else
+  // Keep room for the header of the record after this one, which is zero
+  // after the last record and lets readers know where records end.
+  std::size_t needed = this->dataPtr->size + _bytes + sizeof(RecordHeader);
+  if (needed <= this->dataPtr->capacity)
+    return true;
+
+  if (this->dataPtr->failed)
+    return false;
+
+  std::size_t newCapacity = std::max(this->dataPtr->capacity, kInitialCapacity);
+  while (newCapacity < needed)
+    newCapacity *= 2;
+
+  if (nullptr != this->dataPtr->data)
+  {
+    ::munmap(this->dataPtr->data, this->dataPtr->capacity);
+    this->dataPtr->data = nullptr;
+  }
+
+  // Nothing is mapped from here on, so a failure leaves the writer without
+  // a mapping. The records written so far stay in the file.
+  this->dataPtr->capacity = 0;
+
+  // The new pages read as zeros, which terminates the records
+  if (::ftruncate(this->dataPtr->fd, static_cast<off_t>(newCapacity)) != 0)
+  {
+    ignerr << "Failed to grow state log to [" << newCapacity << "] bytes: "
+           << std::strerror(errno) << std::endl;
+    this->dataPtr->failed = true;
+    return false;
+  }
+
+  void *mapped = ::mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE,
+      MAP_SHARED, this->dataPtr->fd, 0);
+  if (MAP_FAILED == mapped)
+  {
+    ignerr << "Failed to map state log: " << std::strerror(errno)
+           << std::endl;
+    this->dataPtr->failed = true;
+    return false;
+  }
+
+  this->dataPtr->data = static_cast<char *>(mapped);
+  this->dataPtr->capacity = newCapacity;
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogWriter::Append(
+    const std::chrono::steady_clock::duration &_time,
+    const google::protobuf::MessageLite &_msg)
+{
+  IGN_PROFILE("MappedStateLogWriter::Append");
+
+  if (!this->IsOpen() || this->dataPtr->failed)
+    return false;
+
+  int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _time).count();
+  if (!this->dataPtr->index.empty() && time < this->dataPtr->lastTime)
+  {
+    ignerr << "Can't append state at [" << time << "] ns, which is earlier "
+           << "than the last state at [" << this->dataPtr->lastTime << "] ns."
+           << std::endl;
+    return false;
+  }
+
+  std::size_t msgSize = _msg.ByteSizeLong();
+  std::size_t recordSize = Align(sizeof(RecordHeader) + msgSize);
+  if (!this->Reserve(recordSize))
+    return false;
+
+  char *record = this->dataPtr->data + this->dataPtr->size;
+  if (!_msg.SerializeToArray(record + sizeof(RecordHeader),
+        static_cast<int>(msgSize)))
+  {
+    ignerr << "Failed to serialize state at [" << time << "] ns."
+           << std::endl;
+    return false;
+  }
+
+  // Write the header last, so a crash mid-record leaves a zero length behind
+  RecordHeader recordHeader{time, sizeof(RecordHeader) + msgSize};
+  std::memcpy(record, &recordHeader, sizeof(recordHeader));
+
+  this->dataPtr->index.push_back({time, this->dataPtr->size});
+  this->dataPtr->size += recordSize;
+  this->dataPtr->lastTime = time;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogWriter::Close()
+{
+#ifdef _WIN32
+  return false;
+#else
+  if (!this->IsOpen())
+    return false;
+
+  // If the mapping was lost, the records are kept without an index, and
+  // readers scan them
+  bool result{false};
+  std::size_t indexBytes =
+      this->dataPtr->index.size() * sizeof(MappedStateLogIndexEntry);
+  if (!this->dataPtr->failed && this->Reserve(indexBytes + sizeof(Footer)))
+  {
+    // Terminate the records
+    std::memset(this->dataPtr->data + this->dataPtr->size, 0,
+        sizeof(RecordHeader));
+
+    Footer footer;
+    footer.indexOffset = this->dataPtr->size + sizeof(RecordHeader);
+    footer.count = this->dataPtr->index.size();
+    std::memcpy(footer.magic, kFooterMagic, sizeof(footer.magic));
+
+    if (indexBytes > 0)
+    {
+      std::memcpy(this->dataPtr->data + footer.indexOffset,
+          this->dataPtr->index.data(), indexBytes);
+    }
+    std::memcpy(this->dataPtr->data + footer.indexOffset + indexBytes, &footer,
+        sizeof(footer));
+    this->dataPtr->size = footer.indexOffset + indexBytes + sizeof(footer);
+    result = true;
+  }
+
+  if (nullptr != this->dataPtr->data)
+  {
+    ::msync(this->dataPtr->data, this->dataPtr->size, MS_SYNC);
+    ::munmap(this->dataPtr->data, this->dataPtr->capacity);
+    this->dataPtr->data = nullptr;
+  }
+
+  // Drop the unused capacity
+  if (::ftruncate(this->dataPtr->fd,
+        static_cast<off_t>(this->dataPtr->size)) != 0)
+  {
+    ignerr << "Failed to truncate state log: " << std::strerror(errno)
+           << std::endl;
+    result = false;
+  }
+
+  ::close(this->dataPtr->fd);
+  this->dataPtr->fd = -1;
+  this->dataPtr->capacity = 0;
+  this->dataPtr->index.clear();
+  return result;
+#endif
+}
+
+//////////////////////////////////////////////////
+StreamedStateLogWriter::StreamedStateLogWriter(Sink _sink,
+    std::size_t _chunkSize)
+  : dataPtr(std::make_unique<StreamedStateLogWriterPrivate>())
+{
+  this->dataPtr->sink = std::move(_sink);
+  this->dataPtr->chunkSize = _chunkSize;
+  this->dataPtr->chunk.reserve(this->dataPtr->chunkSize + kAlignment);
+
+  Header header;
+  std::memcpy(header.magic, kHeaderMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.reserved = 0;
+  this->dataPtr->chunk.append(reinterpret_cast<const char *>(&header),
+      sizeof(header));
+  this->dataPtr->size = sizeof(Header);
+}
+
+//////////////////////////////////////////////////
+StreamedStateLogWriter::~StreamedStateLogWriter()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool StreamedStateLogWriter::Append(
+    const std::chrono::steady_clock::duration &_time,
+    const google::protobuf::MessageLite &_msg)
+{
+  IGN_PROFILE("StreamedStateLogWriter::Append");
+
+  if (this->dataPtr->closed || this->dataPtr->failed)
+    return false;
+
+  int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _time).count();
+  if (!this->dataPtr->index.empty() && time < this->dataPtr->lastTime)
+  {
+    ignerr << "Can't append state at [" << time << "] ns, which is earlier "
+           << "than the last state at [" << this->dataPtr->lastTime << "] ns."
+           << std::endl;
+    return false;
+  }
+
+  std::size_t msgSize = _msg.ByteSizeLong();
+  std::size_t recordSize = Align(sizeof(RecordHeader) + msgSize);
+
+  // Padding is zeroed by the resize
+  std::size_t start = this->dataPtr->chunk.size();
+  this->dataPtr->chunk.resize(start + recordSize, '\0');
+  char *record = &this->dataPtr->chunk[start];
+  if (!_msg.SerializeToArray(record + sizeof(RecordHeader),
+        static_cast<int>(msgSize)))
+  {
+    ignerr << "Failed to serialize state at [" << time << "] ns."
+           << std::endl;
+    this->dataPtr->chunk.resize(start);
+    return false;
+  }
+
+  RecordHeader recordHeader{time, sizeof(RecordHeader) + msgSize};
+  std::memcpy(record, &recordHeader, sizeof(recordHeader));
+
+  this->dataPtr->index.push_back({time, this->dataPtr->size});
+  this->dataPtr->size += recordSize;
+  this->dataPtr->lastTime = time;
+
+  if (this->dataPtr->chunk.size() >= this->dataPtr->chunkSize)
+    return this->Flush();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool StreamedStateLogWriter::Flush()
+{
+  if (this->dataPtr->chunk.empty())
+    return true;
+
+  std::string full;
+  full.reserve(this->dataPtr->chunkSize + kAlignment);
+  std::swap(full, this->dataPtr->chunk);
+  if (!this->dataPtr->sink(std::move(full)))
+  {
+    ignerr << "Failed to write state log chunk." << std::endl;
+    this->dataPtr->failed = true;
+  }
+  return !this->dataPtr->failed;
+}
+
+//////////////////////////////////////////////////
+bool StreamedStateLogWriter::Close()
+{
+  if (this->dataPtr->closed)
+    return false;
+  this->dataPtr->closed = true;
+
+  // Terminate the records, then write the index and footer as
+  // MappedStateLogWriter does
+  RecordHeader terminator{0, 0};
+  this->dataPtr->chunk.append(reinterpret_cast<const char *>(&terminator),
+      sizeof(terminator));
+
+  Footer footer;
+  footer.indexOffset = this->dataPtr->size + sizeof(RecordHeader);
+  footer.count = this->dataPtr->index.size();
+  std::memcpy(footer.magic, kFooterMagic, sizeof(footer.magic));
+
+  this->dataPtr->chunk.append(
+      reinterpret_cast<const char *>(this->dataPtr->index.data()),
+      this->dataPtr->index.size() * sizeof(MappedStateLogIndexEntry));
+  this->dataPtr->chunk.append(reinterpret_cast<const char *>(&footer),
+      sizeof(footer));
+  this->dataPtr->index.clear();
+
+  return this->Flush();
+}
+
+//////////////////////////////////////////////////
+MappedStateLogReader::MappedStateLogReader()
+  : dataPtr(std::make_unique<MappedStateLogReaderPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+MappedStateLogReader::~MappedStateLogReader()
+{
+#ifndef _WIN32
+  if (nullptr != this->dataPtr->data)
+    ::munmap(const_cast<char *>(this->dataPtr->data), this->dataPtr->size);
+#endif
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogReader::Open(const std::string &_path)
+{
+#ifdef _WIN32
+  ignerr << "Memory-mapped state logs are not supported on Windows. "
+         << "Can't open [" << _path << "]." << std::endl;
+  return false;
+#else
+  if (nullptr != this->dataPtr->data)
+  {
+    ignerr << "State log is already open." << std::endl;
+    return false;
+  }
+
+  int fd = ::open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    ignerr << "Failed to open [" << _path << "] for reading: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) < sizeof(Header))
+  {
+    ignerr << "State log [" << _path << "] is too small." << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  std::size_t fileSize = static_cast<std::size_t>(st.st_size);
+  void *mapped = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after closing the descriptor
+  ::close(fd);
+  if (MAP_FAILED == mapped)
+  {
+    ignerr << "Failed to map [" << _path << "]: " << std::strerror(errno)
+           << std::endl;
+    return false;
+  }
+
+  this->dataPtr->data = static_cast<const char *>(mapped);
+  this->dataPtr->size = fileSize;
+
+  Header header;
+  std::memcpy(&header, this->dataPtr->data, sizeof(header));
+  if (std::memcmp(header.magic, kHeaderMagic, sizeof(header.magic)) != 0 ||
+      header.version != kVersion)
+  {
+    ignerr << "File [" << _path << "] is not a state log or has an "
+           << "unsupported version." << std::endl;
+    ::munmap(mapped, fileSize);
+    this->dataPtr->data = nullptr;
+    this->dataPtr->size = 0;
+    return false;
+  }
+
+  // Use the index written when the log was closed
+  if (this->dataPtr->size >= sizeof(Header) + sizeof(Footer))
+  {
+    Footer footer;
+    std::memcpy(&footer,
+        this->dataPtr->data + this->dataPtr->size - sizeof(footer),
+        sizeof(footer));
+    std::size_t indexEnd = this->dataPtr->size - sizeof(footer);
+    if (std::memcmp(footer.magic, kFooterMagic, sizeof(footer.magic)) == 0 &&
+        footer.indexOffset <= indexEnd &&
+        footer.count == (indexEnd - footer.indexOffset) /
+            sizeof(MappedStateLogIndexEntry))
+    {
+      this->dataPtr->index = reinterpret_cast<const MappedStateLogIndexEntry *>(
+          this->dataPtr->data + footer.indexOffset);
+      this->dataPtr->count = footer.count;
+      return true;
+    }
+  }
+
+  // The log wasn't closed cleanly, rebuild the index from the records
+  ignwarn << "State log [" << _path << "] has no index, it may not have been "
+          << "closed cleanly. Scanning records." << std::endl;
+
+  std::size_t offset = sizeof(Header);
+  while (offset + sizeof(RecordHeader) <= this->dataPtr->size)
+  {
+    RecordHeader record;
+    std::memcpy(&record, this->dataPtr->data + offset, sizeof(record));
+    if (record.length < sizeof(RecordHeader) ||
+        record.length > this->dataPtr->size - offset)
+    {
+      break;
+    }
+    this->dataPtr->scannedIndex.push_back({record.time, offset});
+    offset += Align(record.length);
+  }
+  this->dataPtr->index = this->dataPtr->scannedIndex.data();
+  this->dataPtr->count = this->dataPtr->scannedIndex.size();
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+std::size_t MappedStateLogReader::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration MappedStateLogReader::Time(
+    std::size_t _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return std::chrono::steady_clock::duration::zero();
+
+  return ToDuration(this->dataPtr->index[_index].time);
+}
+
+//////////////////////////////////////////////////
+bool MappedStateLogReader::Message(std::size_t _index,
+    google::protobuf::MessageLite &_msg) const
+{
+  IGN_PROFILE("MappedStateLogReader::Message");
+
+  if (_index >= this->dataPtr->count)
+    return false;
+
+  // The index may come from a corrupt file, check it before reading
+  uint64_t offset = this->dataPtr->index[_index].offset;
+  if (offset > this->dataPtr->size ||
+      this->dataPtr->size - offset < sizeof(RecordHeader))
+  {
+    return false;
+  }
+
+  RecordHeader record;
+  std::memcpy(&record, this->dataPtr->data + offset, sizeof(record));
+  if (record.length < sizeof(RecordHeader) ||
+      record.length > this->dataPtr->size - offset)
+  {
+    return false;
+  }
+
+  uint64_t msgSize = record.length - sizeof(RecordHeader);
+  if (msgSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+    return false;
+
+  return _msg.ParseFromArray(
+      this->dataPtr->data + offset + sizeof(RecordHeader),
+      static_cast<int>(msgSize));
+}
+
+//////////////////////////////////////////////////
+std::size_t MappedStateLogReader::LowerBound(
+    const std::chrono::steady_clock::duration &_time) const
+{
+  int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _time).count();
+  auto it = std::lower_bound(this->dataPtr->index,
+      this->dataPtr->index + this->dataPtr->count, time,
+      [](const MappedStateLogIndexEntry &_entry, int64_t _t)
+      {
+        return _entry.time < _t;
+      });
+  return static_cast<std::size_t>(it - this->dataPtr->index);
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration MappedStateLogReader::StartTime() const
+{
+  return this->Time(0);
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration MappedStateLogReader::EndTime() const
+{
+  if (this->dataPtr->count == 0)
+    return std::chrono::steady_clock::duration::zero();
+
+  return this->Time(this->dataPtr->count - 1);
+}
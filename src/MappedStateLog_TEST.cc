@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+  #include <csignal>
+#endif
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "ignition/gazebo/test_config.hh"
+
+#include "ignition/gazebo/MappedStateLog.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+class MappedStateLogTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    common::createDirectories(this->dir);
+  }
+
+  protected: void TearDown() override
+  {
+    common::removeAll(this->dir);
+  }
+
+  /// \brief Create a state with one entity
+  /// \param[in] _id Entity ID
+  /// \return State message
+  protected: msgs::SerializedStateMap State(uint64_t _id)
+  {
+    msgs::SerializedStateMap msg;
+    (*msg.mutable_entities())[_id].set_id(_id);
+    return msg;
+  }
+
+  /// \brief Directory for test files
+  protected: std::string dir = common::joinPaths(PROJECT_BINARY_PATH, "test",
+      "mapped_state_log");
+};
+
+/////////////////////////////////////////////////
+TEST_F(MappedStateLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RoundTrip))
+{
+  auto path = common::joinPaths(this->dir, "state.mlog");
+  {
+    MappedStateLogWriter writer;
+    EXPECT_FALSE(writer.IsOpen());
+    ASSERT_TRUE(writer.Open(path));
+    EXPECT_TRUE(writer.IsOpen());
+
+    EXPECT_TRUE(writer.Append(1ms, this->State(10)));
+    EXPECT_TRUE(writer.Append(2ms, this->State(20)));
+    // Empty states are valid
+    EXPECT_TRUE(writer.Append(2ms, msgs::SerializedStateMap()));
+    EXPECT_TRUE(writer.Append(5ms, this->State(50)));
+
+    // Time can't go back
+    EXPECT_FALSE(writer.Append(4ms, this->State(40)));
+
+    EXPECT_TRUE(writer.Close());
+    EXPECT_FALSE(writer.IsOpen());
+    EXPECT_FALSE(writer.Append(6ms, this->State(60)));
+  }
+
+  MappedStateLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(4u, reader.Count());
+  EXPECT_EQ(1ms, reader.StartTime());
+  EXPECT_EQ(5ms, reader.EndTime());
+  EXPECT_EQ(2ms, reader.Time(2));
+
+  msgs::SerializedStateMap msg;
+  ASSERT_TRUE(reader.Message(1, msg));
+  ASSERT_EQ(1, msg.entities().size());
+  EXPECT_EQ(20u, msg.entities().begin()->second.id());
+
+  ASSERT_TRUE(reader.Message(2, msg));
+  EXPECT_TRUE(msg.entities().empty());
+
+  EXPECT_FALSE(reader.Message(4, msg));
+
+  EXPECT_EQ(0u, reader.LowerBound(0ms));
+  EXPECT_EQ(0u, reader.LowerBound(1ms));
+  EXPECT_EQ(1u, reader.LowerBound(2ms));
+  EXPECT_EQ(3u, reader.LowerBound(3ms));
+  EXPECT_EQ(4u, reader.LowerBound(6ms));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MappedStateLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(NotClosed))
+{
+  auto path = common::joinPaths(this->dir, "state.mlog");
+  auto copyPath = common::joinPaths(this->dir, "crashed.mlog");
+
+  MappedStateLogWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+  for (uint64_t i = 1; i <= 100; ++i)
+    EXPECT_TRUE(writer.Append(std::chrono::milliseconds(i), this->State(i)));
+
+  // Copy the file before it's closed, as if the recording had crashed
+  ASSERT_TRUE(common::copyFile(path, copyPath));
+  EXPECT_TRUE(writer.Close());
+
+  // The index is rebuilt from the records
+  MappedStateLogReader reader;
+  ASSERT_TRUE(reader.Open(copyPath));
+  ASSERT_EQ(100u, reader.Count());
+  EXPECT_EQ(100ms, reader.EndTime());
+  EXPECT_EQ(49u, reader.LowerBound(50ms));
+
+  msgs::SerializedStateMap msg;
+  ASSERT_TRUE(reader.Message(99, msg));
+  EXPECT_EQ(100u, msg.entities().begin()->second.id());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MappedStateLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(GrowFails))
+{
+#ifndef _WIN32
+  auto path = common::joinPaths(this->dir, "state.mlog");
+
+  MappedStateLogWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+
+  // Don't let the file grow past its initial size
+  struct rlimit original;
+  ASSERT_EQ(0, getrlimit(RLIMIT_FSIZE, &original));
+  auto handler = std::signal(SIGXFSZ, SIG_IGN);
+  struct rlimit limited = original;
+  limited.rlim_cur = 64u * 1024u * 1024u;
+  ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &limited));
+
+  // One megabyte per state
+  msgs::SerializedStateMap msg = this->State(1);
+  auto &comps = *(*msg.mutable_entities())[1].mutable_components();
+  comps[1].set_component(std::string(1024u * 1024u, 'a'));
+
+  int appended{0};
+  for (int i = 0; i < 100; ++i)
+  {
+    if (!writer.Append(std::chrono::milliseconds(i), msg))
+      break;
+    ++appended;
+  }
+  EXPECT_GT(appended, 0);
+  EXPECT_LT(appended, 100);
+
+  // Once the mapping is lost, appending keeps failing instead of writing to
+  // unmapped memory
+  EXPECT_FALSE(writer.Append(200ms, this->State(2)));
+  EXPECT_FALSE(writer.Close());
+
+  ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &original));
+  std::signal(SIGXFSZ, handler);
+
+  // The states appended before the failure are kept
+  MappedStateLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(static_cast<std::size_t>(appended), reader.Count());
+
+  msgs::SerializedStateMap read;
+  ASSERT_TRUE(reader.Message(reader.Count() - 1, read));
+  EXPECT_EQ(1u, read.entities().begin()->second.id());
+#endif
+}
+
+/////////////////////////////////////////////////
+TEST_F(MappedStateLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(CorruptIndex))
+{
+  auto path = common::joinPaths(this->dir, "state.mlog");
+  {
+    MappedStateLogWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+    EXPECT_TRUE(writer.Append(1ms, this->State(10)));
+    EXPECT_TRUE(writer.Append(2ms, this->State(20)));
+    EXPECT_TRUE(writer.Close());
+  }
+
+  // Point the last index entry past the end of the file. The footer is 24
+  // bytes, preceded by the index.
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-24 - static_cast<int>(sizeof(MappedStateLogIndexEntry)) +
+        static_cast<int>(sizeof(int64_t)), std::ios::end);
+    uint64_t offset{0xFFFFFFFFFFFFFF00u};
+    file.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+  }
+
+  MappedStateLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(2u, reader.Count());
+
+  msgs::SerializedStateMap msg;
+  EXPECT_TRUE(reader.Message(0, msg));
+  EXPECT_FALSE(reader.Message(1, msg));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MappedStateLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Streamed))
+{
+  auto path = common::joinPaths(this->dir, "streamed.mlog");
+  std::string bytes;
+  int chunks{0};
+  {
+    // Small chunks, so that records are split across several of them
+    StreamedStateLogWriter writer([&](std::string &&_chunk)
+    {
+      bytes += _chunk;
+      ++chunks;
+      return true;
+    }, 64u);
+
+    for (uint64_t i = 1; i <= 100; ++i)
+      EXPECT_TRUE(writer.Append(std::chrono::milliseconds(i), this->State(i)));
+
+    // Time can't go back
+    EXPECT_FALSE(writer.Append(50ms, this->State(50)));
+
+    EXPECT_TRUE(writer.Close());
+    EXPECT_FALSE(writer.Append(101ms, this->State(101)));
+  }
+  EXPECT_GT(chunks, 1);
+
+  std::ofstream(path, std::ios::binary) << bytes;
+
+  // The streamed bytes are a closed mapped state log, with an index
+  MappedStateLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(100u, reader.Count());
+  EXPECT_EQ(1ms, reader.StartTime());
+  EXPECT_EQ(100ms, reader.EndTime());
+  EXPECT_EQ(49u, reader.LowerBound(50ms));
+
+  msgs::SerializedStateMap msg;
+  ASSERT_TRUE(reader.Message(41, msg));
+  EXPECT_EQ(42u, msg.entities().begin()->second.id());
+
+  // A failing sink fails appends once a chunk is handed to it
+  StreamedStateLogWriter failing([](std::string &&)
+  {
+    return false;
+  }, 1u);
+  EXPECT_FALSE(failing.Append(1ms, this->State(1)));
+  EXPECT_FALSE(failing.Append(2ms, this->State(2)));
+  EXPECT_FALSE(failing.Close());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MappedStateLogTest, Invalid)
+{
+  MappedStateLogReader reader;
+  EXPECT_FALSE(reader.Open(common::joinPaths(this->dir, "does_not_exist")));
+  EXPECT_EQ(0u, reader.Count());
+  EXPECT_EQ(0u, reader.LowerBound(1ms));
+
+  msgs::SerializedStateMap msg;
+  EXPECT_FALSE(reader.Message(0, msg));
+}
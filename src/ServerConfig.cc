@@ -237,7 +237,10 @@ class ignition::gazebo::ServerConfigPrivate
             networkSecondaries(_cfg->networkSecondaries),
             seed(_cfg->seed),
             logRecordTopics(_cfg->logRecordTopics),
-            isHeadlessRendering(_cfg->isHeadlessRendering) { }
+            isHeadlessRendering(_cfg->isHeadlessRendering),
+            batchMode(_cfg->batchMode),
+            precisePacing(_cfg->precisePacing),
+            pipelinedPostUpdate(_cfg->pipelinedPostUpdate) { }
 
   // \brief The SDF file that the server should load
   public: std::string sdfFile = "";
@@ -301,6 +304,15 @@ class ignition::gazebo::ServerConfigPrivate
 
   /// \brief is the headless mode active.
   public: bool isHeadlessRendering{false};
+
+  /// \brief Run as fast as possible, without sleeping.
+  public: bool batchMode{false};
+
+  /// \brief Pace iterations with absolute deadlines and spinning.
+  public: bool precisePacing{false};
+
+  /// \brief Overlap PostUpdate with the next iteration.
+  public: bool pipelinedPostUpdate{false};
 };
 
 //////////////////////////////////////////////////
@@ -538,6 +550,42 @@ bool ServerConfig::HeadlessRendering() const
   return this->dataPtr->isHeadlessRendering;
 }
 
+/////////////////////////////////////////////////
+void ServerConfig::SetBatchMode(const bool _batch)
+{
+  this->dataPtr->batchMode = _batch;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::BatchMode() const
+{
+  return this->dataPtr->batchMode;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPrecisePacing(const bool _precise)
+{
+  this->dataPtr->precisePacing = _precise;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PrecisePacing() const
+{
+  return this->dataPtr->precisePacing;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPipelinedPostUpdate(const bool _pipelined)
+{
+  this->dataPtr->pipelinedPostUpdate = _pipelined;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PipelinedPostUpdate() const
+{
+  return this->dataPtr->pipelinedPostUpdate;
+}
+
 /////////////////////////////////////////////////
 const std::string &ServerConfig::RenderEngineGui() const
 {
@@ -18,6 +18,8 @@
 
 #include <tinyxml2.h>
 
+#include <algorithm>
+
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
@@ -168,16 +170,26 @@ bool ServerPrivate::Run(const uint64_t _iterations,
   }
   else
   {
-    for (std::unique_ptr<SimulationRunner> &runner : this->simRunners)
+    // Step each world in its own thread. Worlds are independent, each with
+    // its own ECM and systems, so they can use all cores. A fixed size pool
+    // would keep worlds beyond the pool size from ever running when the
+    // number of iterations is unbounded.
+    std::vector<std::thread> threads;
+    std::vector<char> results(this->simRunners.size(), true);
+    for (size_t i = 0; i < this->simRunners.size(); ++i)
     {
-      this->workerPool.AddWork([&runner, &_iterations] ()
+      threads.emplace_back([this, i, _iterations, &results]()
         {
-          runner->Run(_iterations);
+          results[i] = this->simRunners[i]->Run(_iterations);
         });
     }
 
-    // Wait for the runner to complete.
-    result = this->workerPool.WaitForResults();
+    // Wait for the runners to complete.
+    for (auto &thread : threads)
+      thread.join();
+
+    result = std::all_of(results.begin(), results.end(),
+        [](char _result) { return _result; });
   }
 
   this->running = false;
@@ -34,7 +34,6 @@
 
 #include <ignition/common/SignalHandler.hh>
 #include <ignition/common/URI.hh>
-#include <ignition/common/WorkerPool.hh>
 
 #include <ignition/fuel_tools/FuelClient.hh>
 
@@ -124,9 +123,6 @@ namespace ignition
       private: bool ServerControlService(
         const ignition::msgs::ServerControl &_req, msgs::Boolean &_res);
 
-      /// \brief A pool of worker threads.
-      public: common::WorkerPool workerPool{2};
-
       /// \brief All the simulation runners.
       public: std::vector<std::unique_ptr<SimulationRunner>> simRunners;
 
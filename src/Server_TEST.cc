@@ -416,6 +416,101 @@ TEST_P(ServerFixture, RunBlocking)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, RunBlockingBatchMode)
+{
+  gazebo::ServerConfig serverConfig;
+  EXPECT_FALSE(serverConfig.BatchMode());
+  serverConfig.SetBatchMode(true);
+  EXPECT_TRUE(serverConfig.BatchMode());
+
+  // The update rate is ignored
+  serverConfig.SetUpdateRate(1.0);
+
+  gazebo::Server server(serverConfig);
+  EXPECT_TRUE(*server.Paused());
+
+  // 1000 iterations at 1 Hz would take too long if the update rate was used
+  server.Run(true, 1000, false);
+  EXPECT_FALSE(server.Running());
+  EXPECT_EQ(1000u, *server.IterationCount());
+
+  server.Run(true, 500, false);
+  EXPECT_EQ(1500u, *server.IterationCount());
+}
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, RunBlockingPrecisePacing)
+{
+  gazebo::ServerConfig serverConfig;
+  EXPECT_FALSE(serverConfig.PrecisePacing());
+  serverConfig.SetPrecisePacing(true);
+  EXPECT_TRUE(serverConfig.PrecisePacing());
+  serverConfig.SetUpdateRate(1000.0);
+
+  gazebo::Server server(serverConfig);
+
+  // Iterations are paced at the update rate
+  auto start = std::chrono::steady_clock::now();
+  server.Run(true, 200, false);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(200u, *server.IterationCount());
+  EXPECT_GE(elapsed, 199ms);
+}
+
+/////////////////////////////////////////////////
+/// \brief System which only implements PostUpdate and records what it sees
+class PostUpdateRecorder :
+  public gazebo::System,
+  public gazebo::ISystemPostUpdate
+{
+  // Documentation inherited
+  public: void PostUpdate(const gazebo::UpdateInfo &_info,
+              const gazebo::EntityComponentManager &_ecm) override
+  {
+    this->iterations.push_back(_info.iterations);
+    this->modelCounts.push_back(
+        _ecm.EntitiesByComponents(gazebo::components::Model()).size());
+  }
+
+  /// \brief Iteration of each PostUpdate call
+  public: std::vector<uint64_t> iterations;
+
+  /// \brief Number of models seen in each PostUpdate call
+  public: std::vector<std::size_t> modelCounts;
+};
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(PipelinedPostUpdate))
+{
+  // PostUpdate systems see the same in both modes
+  for (bool pipelined : {false, true})
+  {
+    gazebo::ServerConfig serverConfig;
+    serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+        "/test/worlds/shapes.sdf");
+    EXPECT_FALSE(serverConfig.PipelinedPostUpdate());
+    serverConfig.SetPipelinedPostUpdate(pipelined);
+    EXPECT_EQ(pipelined, serverConfig.PipelinedPostUpdate());
+
+    gazebo::Server server(serverConfig);
+    server.SetUpdatePeriod(1ns);
+
+    auto recorder = std::make_shared<PostUpdateRecorder>();
+    EXPECT_TRUE(*server.AddSystem(recorder));
+
+    // All PostUpdates are done when Run returns
+    server.Run(true, 50, false);
+    server.Run(true, 50, false);
+    ASSERT_EQ(100u, recorder->iterations.size());
+    for (std::size_t i = 0; i < recorder->iterations.size(); ++i)
+    {
+      EXPECT_EQ(i + 1, recorder->iterations[i]);
+      EXPECT_EQ(5u, recorder->modelCounts[i]) << i;
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 TEST_P(ServerFixture, RunNonBlockingPaused)
 {
@@ -602,6 +697,48 @@ TEST_P(ServerFixture, RunNonBlockingMultiple)
   EXPECT_FALSE(*server.Running(0));
 }
 
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(RunMultipleWorlds))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "multiple_worlds.sdf"));
+  gazebo::Server server(serverConfig);
+  server.SetUpdatePeriod(1ns);
+
+  const unsigned int worldCount{3u};
+  for (unsigned int i = 0; i < worldCount; ++i)
+  {
+    ASSERT_TRUE(server.Running(i).has_value());
+    EXPECT_FALSE(*server.Running(i));
+    EXPECT_EQ(0u, *server.IterationCount(i));
+  }
+  EXPECT_FALSE(server.Running(worldCount).has_value());
+
+  // Blocking: all worlds run the requested iterations
+  EXPECT_TRUE(server.Run(true, 50, false));
+  for (unsigned int i = 0; i < worldCount; ++i)
+    EXPECT_EQ(50u, *server.IterationCount(i));
+
+  // Non-blocking and unbounded: all worlds step concurrently, none of them
+  // waits for another one to finish
+  EXPECT_TRUE(server.Run(false, 0, false));
+
+  int sleep{0};
+  bool allStepped{false};
+  while (!allStepped && sleep++ < 100)
+  {
+    IGN_SLEEP_MS(100);
+    allStepped = true;
+    for (unsigned int i = 0; i < worldCount; ++i)
+      allStepped &= *server.IterationCount(i) > 100u;
+  }
+  EXPECT_TRUE(allStepped);
+
+  for (unsigned int i = 0; i < worldCount; ++i)
+    EXPECT_TRUE(*server.Running(i));
+}
+
 /////////////////////////////////////////////////
 TEST_P(ServerFixture, SigInt)
 {
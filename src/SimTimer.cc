@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/SimTimer.hh"
+
+#include <algorithm>
+#include <utility>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Private data for SimTimer
+class ignition::gazebo::SimTimerPrivate
+{
+  /// \brief Sim time between expirations
+  public: std::chrono::steady_clock::duration period{0};
+
+  /// \brief Function called when the timer expires
+  public: SimTimer::Callback callback;
+
+  /// \brief True if the timer is periodic
+  public: bool repeat{true};
+
+  /// \brief Number of times the timer fired
+  public: uint64_t fireCount{0u};
+};
+
+//////////////////////////////////////////////////
+SimTimer::SimTimer(const std::chrono::steady_clock::duration &_period,
+    Callback _callback, bool _repeat)
+  : dataPtr(std::make_unique<SimTimerPrivate>())
+{
+  this->dataPtr->period = std::max(_period,
+      std::chrono::steady_clock::duration::zero());
+  this->dataPtr->callback = std::move(_callback);
+  this->dataPtr->repeat = _repeat;
+}
+
+//////////////////////////////////////////////////
+SimTimer::~SimTimer() = default;
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration SimTimer::Period() const
+{
+  return this->dataPtr->period;
+}
+
+//////////////////////////////////////////////////
+bool SimTimer::Repeat() const
+{
+  return this->dataPtr->repeat;
+}
+
+//////////////////////////////////////////////////
+uint64_t SimTimer::FireCount() const
+{
+  return this->dataPtr->fireCount;
+}
+
+//////////////////////////////////////////////////
+void SimTimer::Fire(const UpdateInfo &_info, EntityComponentManager &_ecm)
+{
+  ++this->dataPtr->fireCount;
+  if (this->dataPtr->callback)
+    this->dataPtr->callback(_info, _ecm);
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SimTimerWheel.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <ignition/common/Profiler.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Jumps longer than this many ticks reinsert all timers instead of
+/// visiting every level 0 rotation on the way.
+static constexpr uint64_t kMaxAdvanceTicks{uint64_t{1} << 18u};
+
+//////////////////////////////////////////////////
+/// \brief Get the first tick at or after a sim time.
+/// \param[in] _time Sim time.
+/// \param[in] _resolution Duration of a tick.
+/// \return Tick.
+static uint64_t ceilTicks(const std::chrono::steady_clock::duration &_time,
+    const std::chrono::steady_clock::duration &_resolution)
+{
+  if (_time <= std::chrono::steady_clock::duration::zero())
+    return 0u;
+  return static_cast<uint64_t>(
+      (_time.count() + _resolution.count() - 1) / _resolution.count());
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the last tick at or before a sim time.
+/// \param[in] _time Sim time.
+/// \param[in] _resolution Duration of a tick.
+/// \return Tick.
+static uint64_t floorTicks(const std::chrono::steady_clock::duration &_time,
+    const std::chrono::steady_clock::duration &_resolution)
+{
+  if (_time <= std::chrono::steady_clock::duration::zero())
+    return 0u;
+  return static_cast<uint64_t>(_time.count() / _resolution.count());
+}
+
+//////////////////////////////////////////////////
+SimTimerWheel::SimTimerWheel(
+    const std::chrono::steady_clock::duration &_resolution)
+  : resolution(std::max(_resolution, std::chrono::steady_clock::duration(1)))
+{
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Add(const std::shared_ptr<SimTimer> &_timer)
+{
+  if (!_timer)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->pendingMutex);
+  this->pending.push_back(_timer);
+}
+
+//////////////////////////////////////////////////
+std::size_t SimTimerWheel::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->pendingMutex);
+  return this->count + this->pending.size();
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Update(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("SimTimerWheel::Update");
+
+  // Sim time jumped back, for example after a reset
+  if (_info.simTime < this->simTime)
+  {
+    this->simTime = _info.simTime;
+    this->Restart();
+  }
+
+  // Timers never fire while paused. New timers wait as well, otherwise those
+  // without a period would fire right away.
+  if (_info.paused)
+    return;
+
+  // New timers start at the sim time of the last update
+  std::vector<std::shared_ptr<SimTimer>> added;
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    added.swap(this->pending);
+  }
+  for (const auto &timer : added)
+  {
+    ++this->count;
+    this->Insert({timer, this->simTime + timer->Period(),
+        this->nextSequence++});
+  }
+
+  this->Advance(floorTicks(_info.simTime, this->resolution));
+  this->simTime = _info.simTime;
+
+  if (this->expired.empty())
+    return;
+
+  std::vector<Entry> fired;
+  fired.swap(this->expired);
+  std::sort(fired.begin(), fired.end(),
+      [](const Entry &_a, const Entry &_b)
+      {
+        return _a.due < _b.due ||
+            (_a.due == _b.due && _a.sequence < _b.sequence);
+      });
+
+  for (auto &entry : fired)
+  {
+    auto timer = entry.timer.lock();
+    if (!timer)
+    {
+      --this->count;
+      continue;
+    }
+
+    timer->Fire(_info, _ecm);
+
+    if (!timer->Repeat())
+    {
+      --this->count;
+      continue;
+    }
+
+    // Keep the phase of periodic timers, skipping the expirations missed
+    // during long iterations
+    const auto period = timer->Period();
+    if (period <= std::chrono::steady_clock::duration::zero())
+    {
+      entry.due = this->simTime + this->resolution;
+    }
+    else
+    {
+      entry.due += period;
+      if (entry.due <= this->simTime)
+        entry.due += period * ((this->simTime - entry.due) / period + 1);
+    }
+    this->Insert(std::move(entry));
+  }
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Insert(Entry &&_entry)
+{
+  const auto dueTick = ceilTicks(_entry.due, this->resolution);
+  if (dueTick <= this->tick)
+  {
+    this->expired.push_back(std::move(_entry));
+    return;
+  }
+
+  const auto delta = dueTick - this->tick;
+  for (std::size_t level = 0u; level < kLevels; ++level)
+  {
+    if (delta < (uint64_t{1} << (kSlotBits * (level + 1u))))
+    {
+      const auto slot = static_cast<std::size_t>(
+          (dueTick >> (kSlotBits * level)) & (kSlots - 1u));
+      this->slots[level][slot].push_back(std::move(_entry));
+      this->occupied[level] |= uint64_t{1} << slot;
+      return;
+    }
+  }
+  this->overflow.push_back(std::move(_entry));
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Advance(uint64_t _tick)
+{
+  if (_tick <= this->tick)
+    return;
+
+  // Reinserting all timers is cheaper than a long walk through empty slots
+  if (_tick - this->tick > kMaxAdvanceTicks)
+  {
+    std::vector<Entry> all;
+    all.swap(this->overflow);
+    for (std::size_t level = 0u; level < kLevels; ++level)
+    {
+      for (auto &slot : this->slots[level])
+      {
+        std::move(slot.begin(), slot.end(), std::back_inserter(all));
+        slot.clear();
+      }
+      this->occupied[level] = 0u;
+    }
+
+    this->tick = _tick;
+    for (auto &entry : all)
+      this->Insert(std::move(entry));
+    return;
+  }
+
+  while (this->tick < _tick)
+  {
+    const auto index = static_cast<std::size_t>(this->tick & (kSlots - 1u));
+
+    // Start a new rotation of level 0
+    if (index == kSlots - 1u)
+    {
+      ++this->tick;
+      this->Cascade();
+      this->Collect(0u);
+      continue;
+    }
+
+    // Collect the non-empty slots up to the target or the end of the
+    // rotation
+    const auto last = std::min(_tick, this->tick | (kSlots - 1u));
+    const auto lastIndex = static_cast<std::size_t>(last & (kSlots - 1u));
+    const uint64_t upTo = lastIndex == kSlots - 1u ? ~uint64_t{0} :
+        (uint64_t{1} << (lastIndex + 1u)) - 1u;
+    const uint64_t from = ~((uint64_t{1} << (index + 1u)) - 1u);
+    auto bits = this->occupied[0] & upTo & from;
+    for (std::size_t slot = index + 1u; bits != 0u; ++slot)
+    {
+      if (bits & (uint64_t{1} << slot))
+      {
+        this->Collect(slot);
+        bits &= ~(uint64_t{1} << slot);
+      }
+    }
+    this->tick = last;
+  }
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Cascade()
+{
+  for (std::size_t level = 1u; level < kLevels; ++level)
+  {
+    const auto slot = static_cast<std::size_t>(
+        (this->tick >> (kSlotBits * level)) & (kSlots - 1u));
+    if (this->occupied[level] & (uint64_t{1} << slot))
+    {
+      std::vector<Entry> entries;
+      entries.swap(this->slots[level][slot]);
+      this->occupied[level] &= ~(uint64_t{1} << slot);
+      for (auto &entry : entries)
+        this->Insert(std::move(entry));
+    }
+
+    // Higher levels only move when this one starts a new rotation
+    if (slot != 0u)
+      return;
+  }
+
+  // The highest level started a new rotation
+  std::vector<Entry> entries;
+  entries.swap(this->overflow);
+  for (auto &entry : entries)
+    this->Insert(std::move(entry));
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Collect(std::size_t _slot)
+{
+  if (!(this->occupied[0] & (uint64_t{1} << _slot)))
+    return;
+
+  auto &slot = this->slots[0][_slot];
+  std::move(slot.begin(), slot.end(), std::back_inserter(this->expired));
+  slot.clear();
+  this->occupied[0] &= ~(uint64_t{1} << _slot);
+}
+
+//////////////////////////////////////////////////
+void SimTimerWheel::Restart()
+{
+  std::vector<Entry> all;
+  all.swap(this->overflow);
+  std::move(this->expired.begin(), this->expired.end(),
+      std::back_inserter(all));
+  this->expired.clear();
+  for (std::size_t level = 0u; level < kLevels; ++level)
+  {
+    for (auto &slot : this->slots[level])
+    {
+      std::move(slot.begin(), slot.end(), std::back_inserter(all));
+      slot.clear();
+    }
+    this->occupied[level] = 0u;
+  }
+
+  this->tick = floorTicks(this->simTime, this->resolution);
+  for (auto &entry : all)
+  {
+    auto timer = entry.timer.lock();
+    if (!timer)
+    {
+      --this->count;
+      continue;
+    }
+    entry.due = this->simTime + timer->Period();
+    this->Insert(std::move(entry));
+  }
+}
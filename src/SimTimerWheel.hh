@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SIMTIMERWHEEL_HH_
+#define IGNITION_GAZEBO_SIMTIMERWHEEL_HH_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/Export.hh"
+#include "ignition/gazebo/SimTimer.hh"
+#include "ignition/gazebo/Types.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Hierarchical timing wheel which fires the sim time timers of
+    /// all systems. Advancing the wheel by one iteration only visits the
+    /// slots of the timers which expire, instead of checking every timer.
+    ///
+    /// Sim time is divided into ticks of a fixed resolution. Level 0 has one
+    /// slot per tick, and each higher level has one slot per full rotation of
+    /// the level below. Timers are placed on the lowest level whose range
+    /// covers their expiration, and moved down a level when the level below
+    /// reaches their slot. Timers expire on the first tick at or after their
+    /// expiration time, so they never fire early.
+    class IGNITION_GAZEBO_VISIBLE SimTimerWheel
+    {
+      /// \brief Constructor
+      /// \param[in] _resolution Duration of a tick.
+      public: explicit SimTimerWheel(
+                  const std::chrono::steady_clock::duration &_resolution =
+                  std::chrono::microseconds(1));
+
+      /// \brief Add a timer. It's inserted on the next call to Update which
+      /// isn't paused, with its first expiration one period after the sim
+      /// time of the last update. This can be called from any thread,
+      /// including from timer callbacks.
+      /// \param[in] _timer Timer to add. It's removed once all other shared
+      /// pointers to it are released.
+      public: void Add(const std::shared_ptr<SimTimer> &_timer);
+
+      /// \brief Advance to the sim time of an iteration and fire the expired
+      /// timers, in order of expiration. Nothing fires while paused.
+      /// \param[in] _info Update info of the iteration.
+      /// \param[in] _ecm Entity component manager passed to the callbacks.
+      public: void Update(const UpdateInfo &_info,
+                  EntityComponentManager &_ecm);
+
+      /// \brief Number of timers in the wheel, including released timers
+      /// which haven't been removed yet.
+      /// \return Timer count.
+      public: std::size_t Count() const;
+
+      /// \brief A timer in the wheel.
+      private: struct Entry
+      {
+        /// \brief The timer, removed when expired.
+        std::weak_ptr<SimTimer> timer;
+
+        /// \brief Sim time of the next expiration.
+        std::chrono::steady_clock::duration due;
+
+        /// \brief Order of insertion, to fire timers which expire at the same
+        /// time in a deterministic order.
+        uint64_t sequence;
+      };
+
+      /// \brief Insert a timer in the slot matching its expiration.
+      /// \param[in] _entry Timer to insert.
+      private: void Insert(Entry &&_entry);
+
+      /// \brief Advance the current tick, collecting expired timers.
+      /// \param[in] _tick Tick to advance to.
+      private: void Advance(uint64_t _tick);
+
+      /// \brief Move the timers of the higher level slots reached at the
+      /// current tick down to lower levels.
+      private: void Cascade();
+
+      /// \brief Move the timers of a slot to the expired list.
+      /// \param[in] _slot Level 0 slot.
+      private: void Collect(std::size_t _slot);
+
+      /// \brief Remove all timers and insert them again, restarting them from
+      /// the current time.
+      private: void Restart();
+
+      /// \brief Number of bits of the slot index of each level.
+      private: static constexpr std::size_t kSlotBits{6u};
+
+      /// \brief Number of slots of each level, one bit of the occupancy mask.
+      private: static constexpr std::size_t kSlots{1u << kSlotBits};
+
+      /// \brief Number of levels. With microsecond ticks, they cover a bit
+      /// more than 19 hours, later timers are kept in an overflow list.
+      private: static constexpr std::size_t kLevels{6u};
+
+      /// \brief Duration of a tick.
+      private: std::chrono::steady_clock::duration resolution;
+
+      /// \brief Timer slots of each level.
+      private: std::array<std::array<std::vector<Entry>, kSlots>, kLevels>
+          slots;
+
+      /// \brief Bit mask of the non-empty slots of each level.
+      private: std::array<uint64_t, kLevels> occupied{};
+
+      /// \brief Timers beyond the range of the highest level.
+      private: std::vector<Entry> overflow;
+
+      /// \brief Timers which expired, to be fired.
+      private: std::vector<Entry> expired;
+
+      /// \brief Current tick.
+      private: uint64_t tick{0u};
+
+      /// \brief Sim time of the last update.
+      private: std::chrono::steady_clock::duration simTime{0};
+
+      /// \brief Number of timers in the wheel.
+      private: std::size_t count{0u};
+
+      /// \brief Next insertion sequence number.
+      private: uint64_t nextSequence{0u};
+
+      /// \brief Timers added since the last update.
+      private: std::vector<std::shared_ptr<SimTimer>> pending;
+
+      /// \brief Mutex to protect pending.
+      private: mutable std::mutex pendingMutex;
+    };
+    }
+  }  // namespace gazebo
+}  // namespace ignition
+#endif  // IGNITION_GAZEBO_SIMTIMERWHEEL_HH_
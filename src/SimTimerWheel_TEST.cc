@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/SimTimer.hh"
+#include "ignition/gazebo/Types.hh"
+
+#include "SimTimerWheel.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Step a wheel with a fixed step size.
+/// \param[in] _wheel Wheel to step.
+/// \param[in, out] _info Update info, advanced by each step.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _steps Number of steps.
+void step(SimTimerWheel &_wheel, UpdateInfo &_info,
+    EntityComponentManager &_ecm, int _steps)
+{
+  for (int i = 0; i < _steps; ++i)
+  {
+    _info.simTime += _info.dt;
+    ++_info.iterations;
+    _wheel.Update(_info, _ecm);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SimTimerWheel, Periodic)
+{
+  SimTimerWheel wheel;
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = 1ms;
+
+  // 250 Hz and 30 Hz timers
+  std::vector<std::chrono::steady_clock::duration> fast;
+  std::vector<std::chrono::steady_clock::duration> slow;
+  auto fastTimer = std::make_shared<SimTimer>(4ms,
+      [&](const UpdateInfo &_info, EntityComponentManager &)
+      {
+        fast.push_back(_info.simTime);
+      });
+  auto slowTimer = std::make_shared<SimTimer>(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / 30.0)),
+      [&](const UpdateInfo &_info, EntityComponentManager &)
+      {
+        slow.push_back(_info.simTime);
+      });
+  wheel.Add(fastTimer);
+  wheel.Add(slowTimer);
+  EXPECT_EQ(2u, wheel.Count());
+
+  step(wheel, info, ecm, 1000);
+
+  // Fired every 4 iterations
+  ASSERT_EQ(250u, fast.size());
+  EXPECT_EQ(250u, fastTimer->FireCount());
+  for (std::size_t i = 0; i < fast.size(); ++i)
+  {
+    EXPECT_EQ(std::chrono::steady_clock::duration(4ms * (i + 1)), fast[i]);
+  }
+
+  // Fired on the first iteration after each expiration, without drifting
+  ASSERT_EQ(30u, slow.size());
+  EXPECT_EQ(34ms, slow[0]);
+  EXPECT_EQ(67ms, slow[1]);
+  EXPECT_EQ(100ms, slow[2]);
+  EXPECT_EQ(1000ms, slow.back());
+
+  // Nothing fires while paused
+  info.paused = true;
+  info.dt = 0ms;
+  step(wheel, info, ecm, 10);
+  EXPECT_EQ(250u, fast.size());
+
+  // Released timers stop firing and are removed
+  fastTimer.reset();
+  info.paused = false;
+  info.dt = 1ms;
+  step(wheel, info, ecm, 100);
+  EXPECT_EQ(250u, fast.size());
+  EXPECT_EQ(1u, wheel.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(SimTimerWheel, OneShot)
+{
+  SimTimerWheel wheel;
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = 10ms;
+
+  int count{0};
+  auto timer = std::make_shared<SimTimer>(25ms,
+      [&](const UpdateInfo &, EntityComponentManager &)
+      {
+        ++count;
+      }, false);
+
+  step(wheel, info, ecm, 5);
+  wheel.Add(timer);
+  EXPECT_EQ(1u, wheel.Count());
+
+  // Expires 25 ms after the last update, at 75 ms, so it fires at 80 ms
+  step(wheel, info, ecm, 2);
+  EXPECT_EQ(0, count);
+  step(wheel, info, ecm, 1);
+  EXPECT_EQ(1, count);
+  EXPECT_EQ(0u, wheel.Count());
+
+  step(wheel, info, ecm, 100);
+  EXPECT_EQ(1, count);
+}
+
+/////////////////////////////////////////////////
+TEST(SimTimerWheel, LongPeriodsAndJumps)
+{
+  SimTimerWheel wheel;
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = 1ms;
+
+  // Beyond the range of all levels
+  int count{0};
+  auto timer = std::make_shared<SimTimer>(std::chrono::hours(30),
+      [&](const UpdateInfo &, EntityComponentManager &)
+      {
+        ++count;
+      });
+  wheel.Add(timer);
+
+  step(wheel, info, ecm, 1000);
+  EXPECT_EQ(0, count);
+
+  // Jump forward past the expiration
+  info.simTime = std::chrono::hours(31);
+  wheel.Update(info, ecm);
+  EXPECT_EQ(1, count);
+
+  // Missed expirations are skipped
+  info.simTime = std::chrono::hours(100);
+  wheel.Update(info, ecm);
+  EXPECT_EQ(2, count);
+
+  // Jumping back restarts the timer
+  info.simTime = 0ms;
+  wheel.Update(info, ecm);
+  EXPECT_EQ(2, count);
+  info.simTime = std::chrono::hours(29);
+  wheel.Update(info, ecm);
+  EXPECT_EQ(2, count);
+  info.simTime = std::chrono::hours(30);
+  wheel.Update(info, ecm);
+  EXPECT_EQ(3, count);
+}
+
+/////////////////////////////////////////////////
+TEST(SimTimerWheel, AddWhilePaused)
+{
+  SimTimerWheel wheel;
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = 1ms;
+  step(wheel, info, ecm, 10);
+
+  std::vector<std::chrono::steady_clock::duration> fired;
+  auto timer = std::make_shared<SimTimer>(0ms,
+      [&](const UpdateInfo &_info, EntityComponentManager &)
+      {
+        EXPECT_FALSE(_info.paused);
+        fired.push_back(_info.simTime);
+      }, false);
+
+  // Timers without a period don't fire until the simulation is unpaused
+  info.paused = true;
+  info.dt = 0ms;
+  wheel.Add(timer);
+  step(wheel, info, ecm, 10);
+  EXPECT_TRUE(fired.empty());
+  EXPECT_EQ(1u, wheel.Count());
+
+  info.paused = false;
+  info.dt = 1ms;
+  step(wheel, info, ecm, 1);
+  ASSERT_EQ(1u, fired.size());
+  EXPECT_EQ(11ms, fired[0]);
+  EXPECT_EQ(0u, wheel.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(SimTimerWheel, AddFromCallback)
+{
+  SimTimerWheel wheel;
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = 1ms;
+
+  std::vector<std::chrono::steady_clock::duration> fired;
+  std::shared_ptr<SimTimer> second;
+  auto first = std::make_shared<SimTimer>(5ms,
+      [&](const UpdateInfo &_info, EntityComponentManager &)
+      {
+        fired.push_back(_info.simTime);
+        second = std::make_shared<SimTimer>(5ms,
+            [&](const UpdateInfo &_info2, EntityComponentManager &)
+            {
+              fired.push_back(_info2.simTime);
+            }, false);
+        wheel.Add(second);
+      }, false);
+  wheel.Add(first);
+
+  step(wheel, info, ecm, 20);
+  ASSERT_EQ(2u, fired.size());
+  EXPECT_EQ(5ms, fired[0]);
+  EXPECT_EQ(10ms, fired[1]);
+}
@@ -17,7 +17,13 @@
 
 #include "SimulationRunner.hh"
 
+#ifdef __linux__
+#include <time.h>
+#endif
+
 #include <algorithm>
+#include <cerrno>
+#include <thread>
 
 #include <sdf/Root.hh>
 
@@ -43,6 +49,71 @@ using namespace gazebo;
 
 using StringSet = std::unordered_set<std::string>;
 
+/// \brief With precise pacing, time before each deadline which is spent
+/// spinning instead of sleeping. It should be larger than the typical
+/// scheduler wake up latency.
+static constexpr std::chrono::steady_clock::duration kPacingSpinTime{200us};
+
+/// \brief Period over which pacing statistics are computed.
+static constexpr std::chrono::steady_clock::duration kPacingWindow{1s};
+
+/// \brief Maximum wall time a step and state request waits for its
+/// iterations, for requests which don't have a `timeout_ms` header, such as
+/// those made with `ign service`. It matches the default timeout of
+/// StepStateClient.
+static constexpr std::chrono::steady_clock::duration kStepStateTimeout{5s};
+
+//////////////////////////////////////////////////
+/// \brief Sleep until an absolute time.
+/// \param[in] _time Time to wake up at.
+static void sleepUntil(const std::chrono::steady_clock::time_point &_time)
+{
+#ifdef __linux__
+  // steady_clock is CLOCK_MONOTONIC. Sleeping until an absolute time, instead
+  // of for a duration, isn't affected by preemption between computing the
+  // duration and going to sleep.
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _time.time_since_epoch()).count();
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns % 1000000000);  // NOLINT
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+      EINTR)
+  {
+  }
+#else
+  std::this_thread::sleep_until(_time);
+#endif
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the library filenames of the system plugins of a world, its
+/// models, including nested models, and its includes. Plugins of other
+/// elements, such as sensors, visuals and the GUI, aren't preloaded.
+/// \param[in] _elem World, model or include element.
+/// \param[out] _filenames Library filenames.
+static void pluginFilenames(const sdf::ElementPtr &_elem,
+    std::set<std::string> &_filenames)
+{
+  if (!_elem)
+    return;
+
+  for (auto child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    const auto &name = child->GetName();
+    if (name == "plugin")
+    {
+      auto filename = child->Get<std::string>("filename");
+      if (!filename.empty() && filename != "__default__")
+        _filenames.insert(filename);
+    }
+    else if (name == "model" || name == "include")
+    {
+      pluginFilenames(child, _filenames);
+    }
+  }
+}
 
 //////////////////////////////////////////////////
 SimulationRunner::SimulationRunner(const sdf::World *_world,
@@ -112,10 +183,34 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
         static_cast<int>(this->stepSize.count() / this->desiredRtf));
   }
 
+  this->batchMode = _config.BatchMode();
+  this->precisePacing = _config.PrecisePacing();
+  this->pipelinedPostUpdate = _config.PipelinedPostUpdate();
+  if (this->batchMode && this->precisePacing)
+  {
+    ignwarn << "Precise pacing has no effect in batch mode." << std::endl;
+  }
+  if (this->batchMode && _config.UpdateRate())
+  {
+    ignwarn << "Running in batch mode, the update rate of ["
+            << *_config.UpdateRate() << "] Hz will be ignored." << std::endl;
+  }
+
   // Create the system manager
   this->systemMgr = std::make_unique<SystemManager>(_systemLoader,
       &this->entityCompMgr, &this->eventMgr);
 
+  // Load all plugin libraries at once, instead of one by one as entities
+  // are created
+  if (_systemLoader)
+  {
+    std::set<std::string> filenames;
+    pluginFilenames(_world->Element(), filenames);
+    for (const auto &plugin : _config.Plugins())
+      filenames.insert(plugin.Filename());
+    _systemLoader->PreloadLibraries(filenames);
+  }
+
   this->pauseConn = this->eventMgr.Connect<events::Pause>(
       std::bind(&SimulationRunner::SetPaused, this, std::placeholders::_1));
 
@@ -126,6 +221,10 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
       std::bind(&SimulationRunner::LoadPlugins, this, std::placeholders::_1,
       std::placeholders::_2));
 
+  this->addSimTimerConn = this->eventMgr.Connect<events::AddSimTimer>(
+      std::bind(&SimTimerWheel::Add, &this->timerWheel,
+      std::placeholders::_1));
+
   // Create the level manager
   this->levelMgr = std::make_unique<LevelManager>(this, _config.UseLevels());
 
@@ -166,6 +265,13 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
     }
   }
 
+  if (this->pipelinedPostUpdate && this->networkMgr)
+  {
+    ignwarn << "Pipelined PostUpdate isn't supported with distributed "
+            << "simulation, it will be disabled." << std::endl;
+    this->pipelinedPostUpdate = false;
+  }
+
   // Load the active levels
   this->levelMgr->UpdateLevelsState();
 
@@ -207,11 +313,14 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
   this->node->Advertise("control", &SimulationRunner::OnWorldControl, this);
   this->node->Advertise("control/state", &SimulationRunner::OnWorldControlState,
       this);
+  this->node->Advertise("control/step_state", &SimulationRunner::OnStepState,
+      this);
   this->node->Advertise("playback/control",
       &SimulationRunner::OnPlaybackControl, this);
 
   ignmsg << "Serving world controls on [" << opts.NameSpace()
-         << "/control], [" << opts.NameSpace() << "/control/state] and ["
+         << "/control], [" << opts.NameSpace() << "/control/state], ["
+         << opts.NameSpace() << "/control/step_state] and ["
          << opts.NameSpace() << "/playback/control]" << std::endl;
 
   // Publish empty GUI messages for worlds that have no GUI in the beginning.
@@ -293,40 +402,46 @@ void SimulationRunner::UpdateCurrentInfo()
 
   // Regular time flow
 
-  // Store the real time and sim time only if not paused.
-  if (this->realTimeWatch.Running())
+  // In batch mode, the RTF is computed when statistics are published, over
+  // the whole publication period
+  if (!this->batchMode)
   {
-    this->realTimes.push_back(this->realTimeWatch.ElapsedRunTime());
-    this->simTimes.push_back(this->currentInfo.simTime);
-  }
-
-  // Maintain a window size of 20 for realtime and simtime.
-  if (this->realTimes.size() > 20)
-    this->realTimes.pop_front();
-  if (this->simTimes.size() > 20)
-    this->simTimes.pop_front();
-
-  // Compute the average sim and real times.
-  std::chrono::steady_clock::duration simAvg{0}, realAvg{0};
-  std::list<std::chrono::steady_clock::duration>::iterator simIter,
-    realIter;
+    // Store the real time and sim time only if not paused.
+    if (this->realTimeWatch.Running())
+    {
+      this->realTimes.push_back(this->realTimeWatch.ElapsedRunTime());
+      this->simTimes.push_back(this->currentInfo.simTime);
+    }
 
-  simIter = ++(this->simTimes.begin());
-  realIter = ++(this->realTimes.begin());
-  while (simIter != this->simTimes.end() && realIter != this->realTimes.end())
-  {
-    simAvg += ((*simIter) - this->simTimes.front());
-    realAvg += ((*realIter) - this->realTimes.front());
-    ++simIter;
-    ++realIter;
-  }
+    // Maintain a window size of 20 for realtime and simtime.
+    if (this->realTimes.size() > 20)
+      this->realTimes.pop_front();
+    if (this->simTimes.size() > 20)
+      this->simTimes.pop_front();
+
+    // Compute the average sim and real times.
+    std::chrono::steady_clock::duration simAvg{0}, realAvg{0};
+    std::list<std::chrono::steady_clock::duration>::iterator simIter,
+      realIter;
+
+    simIter = ++(this->simTimes.begin());
+    realIter = ++(this->realTimes.begin());
+    while (simIter != this->simTimes.end() &&
+           realIter != this->realTimes.end())
+    {
+      simAvg += ((*simIter) - this->simTimes.front());
+      realAvg += ((*realIter) - this->realTimes.front());
+      ++simIter;
+      ++realIter;
+    }
 
-  // RTF, only compute this if the realTime count is greater than zero. The
-  // realtTime count could be zero if simulation was started paused.
-  if (realAvg.count() > 0)
-  {
-    this->realTimeFactor = math::precision(
-          static_cast<double>(simAvg.count()) / realAvg.count(), 4);
+    // RTF, only compute this if the realTime count is greater than zero. The
+    // realtTime count could be zero if simulation was started paused.
+    if (realAvg.count() > 0)
+    {
+      this->realTimeFactor = math::precision(
+            static_cast<double>(simAvg.count()) / realAvg.count(), 4);
+    }
   }
 
   // Fill the current update info
@@ -347,8 +462,13 @@ void SimulationRunner::UpdateCurrentInfo()
 /////////////////////////////////////////////////
 void SimulationRunner::UpdatePhysicsParams()
 {
-  auto worldEntity =
-    this->entityCompMgr.EntityByComponents(components::World());
+  if (kNullEntity == this->cachedWorldEntity ||
+      !this->entityCompMgr.HasEntity(this->cachedWorldEntity))
+  {
+    this->cachedWorldEntity =
+        this->entityCompMgr.EntityByComponents(components::World());
+  }
+  auto worldEntity = this->cachedWorldEntity;
   const auto physicsCmdComp =
     this->entityCompMgr.Component<components::PhysicsCmd>(worldEntity);
   if (!physicsCmdComp)
@@ -428,6 +548,26 @@ void SimulationRunner::PublishStats()
     headerData->set_key("step");
   }
 
+  // Statistics of the last complete window, so all messages published within
+  // a window agree
+  if (this->precisePacing && !this->batchMode)
+  {
+    auto addData = [&msg](const std::string &_key, const std::string &_value)
+    {
+      auto headerData = msg.mutable_header()->add_data();
+      headerData->set_key(_key);
+      headerData->add_value(_value);
+    };
+    addData("pacing_jitter_mean_us", std::to_string(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        this->lastPacingJitter.Mean()).count()));
+    addData("pacing_jitter_max_us", std::to_string(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        this->lastPacingJitter.max).count()));
+    addData("pacing_overruns", std::to_string(this->lastPacingOverruns));
+    addData("pacing_iterations", std::to_string(this->lastPacingJitter.count));
+  }
+
   // Publish the stats message. The stats message is throttled.
   this->statsPub.Publish(msg);
 
@@ -451,6 +591,95 @@ void SimulationRunner::PublishStats()
     this->rootClockPub.Publish(clockMsg);
 }
 
+/////////////////////////////////////////////////
+void SimulationRunner::WaitForNextStep()
+{
+  IGN_PROFILE("SimulationRunner::WaitForNextStep");
+
+  auto now = std::chrono::steady_clock::now();
+
+  if (!this->nextStepDeadline)
+  {
+    this->nextStepDeadline = now;
+    this->pacingWindowStart = now;
+  }
+
+  if (now - this->pacingWindowStart >= kPacingWindow)
+  {
+    this->lastPacingJitter = this->pacingJitter;
+    this->lastPacingOverruns = this->pacingOverruns;
+    this->pacingJitter.Reset();
+    this->pacingOverruns = 0u;
+    this->pacingWindowStart = now;
+  }
+
+  // Run as fast as possible
+  if (this->updatePeriod <= 0ns)
+  {
+    this->nextStepDeadline = now;
+    return;
+  }
+
+  // Deadlines are absolute, so errors don't accumulate from one iteration
+  // to the next
+  *this->nextStepDeadline += this->updatePeriod;
+
+  if (now >= *this->nextStepDeadline)
+  {
+    ++this->pacingOverruns;
+    this->pacingJitter.Add(now - *this->nextStepDeadline);
+
+    // Don't try to catch up if we're more than a period late, such as after
+    // a slow iteration, start a new schedule instead
+    if (now - *this->nextStepDeadline > this->updatePeriod)
+      this->nextStepDeadline = now;
+    return;
+  }
+
+  // Sleep is too coarse for the last stretch, spin instead
+  const auto wakeUp = *this->nextStepDeadline - kPacingSpinTime;
+  if (now < wakeUp)
+  {
+    IGN_PROFILE("Sleep");
+    sleepUntil(wakeUp);
+  }
+  {
+    IGN_PROFILE("Spin");
+    do
+    {
+      now = std::chrono::steady_clock::now();
+    }
+    while (now < *this->nextStepDeadline);
+  }
+
+  this->pacingJitter.Add(now - *this->nextStepDeadline);
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::PublishBatchStats()
+{
+  // Statistics and clock are published at the same rate the statistics
+  // publisher is throttled to, instead of on every iteration
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->lastBatchStatsPub < 100ms && !this->Stepping())
+    return;
+  this->lastBatchStatsPub = now;
+
+  // Compute the RTF over the period since the last publication
+  const auto simTime = this->currentInfo.simTime - this->batchStatsSimTime;
+  const auto realTime = this->currentInfo.realTime - this->batchStatsRealTime;
+  if (simTime >= std::chrono::steady_clock::duration::zero() &&
+      realTime > std::chrono::steady_clock::duration::zero())
+  {
+    this->realTimeFactor = math::precision(
+        static_cast<double>(simTime.count()) / realTime.count(), 4);
+  }
+  this->batchStatsSimTime = this->currentInfo.simTime;
+  this->batchStatsRealTime = this->currentInfo.realTime;
+
+  this->PublishStats();
+}
+
 //////////////////////////////////////////////////
 void SimulationRunner::AddSystem(const SystemPluginPtr &_system,
       std::optional<Entity> _entity,
@@ -481,44 +710,99 @@ void SimulationRunner::ProcessSystemQueue()
     return;
 
   // If additional systems are to be added, stop the existing threads.
+  this->WaitForPostUpdate();
   this->StopWorkerThreads();
 
   this->systemMgr->ActivatePendingSystems();
 
-  auto threadCount = this->systemMgr->SystemsPostUpdate().size() + 1u;
+  // In pipelined mode, systems which only implement PostUpdate overlap with
+  // the next iteration. Systems which also implement PreUpdate or Update may
+  // not expect them to run concurrently, so their PostUpdate finishes within
+  // the iteration, like when pipelining is off.
+  std::vector<const SystemInternal *> syncSystems;
+  std::vector<const SystemInternal *> pipelinedSystems;
+  for (const auto &system : this->systemMgr->Systems())
+  {
+    if (!system.postupdate)
+      continue;
 
-  igndbg << "Creating PostUpdate worker threads: "
-    << threadCount << std::endl;
+    if (this->pipelinedPostUpdate && !system.preupdate && !system.update)
+    {
+      pipelinedSystems.push_back(&system);
+    }
+    else
+    {
+      if (this->pipelinedPostUpdate)
+      {
+        igndbg << "System [" << system.name << "] implements PostUpdate "
+               << "and PreUpdate or Update, so its PostUpdate won't overlap "
+               << "with the next iteration." << std::endl;
+      }
+      syncSystems.push_back(&system);
+    }
+  }
 
-  this->postUpdateStartBarrier = std::make_unique<Barrier>(threadCount);
-  this->postUpdateStopBarrier = std::make_unique<Barrier>(threadCount);
+  igndbg << "Creating PostUpdate worker threads: "
+    << syncSystems.size() + pipelinedSystems.size() << std::endl;
+
+  this->postUpdateStartBarrier =
+      std::make_unique<Barrier>(syncSystems.size() + 1u);
+  this->postUpdateStopBarrier =
+      std::make_unique<Barrier>(syncSystems.size() + 1u);
+  this->pipelinedStartBarrier.reset();
+  this->pipelinedStopBarrier.reset();
+  if (!pipelinedSystems.empty())
+  {
+    this->pipelinedStartBarrier =
+        std::make_unique<Barrier>(pipelinedSystems.size() + 1u);
+    this->pipelinedStopBarrier =
+        std::make_unique<Barrier>(pipelinedSystems.size() + 1u);
+  }
 
   this->postUpdateThreadsRunning = true;
   int id = 0;
 
-  for (auto &system : this->systemMgr->SystemsPostUpdate())
+  auto createThread = [&](const SystemInternal *_system, bool _pipelined)
   {
     igndbg << "Creating postupdate worker thread (" << id << ")" << std::endl;
 
-    this->postUpdateThreads.push_back(std::thread([&, id]()
+    auto *system = _system->postupdate;
+    auto *timing = &_system->timing->postUpdate;
+    auto *startBarrier = _pipelined ? this->pipelinedStartBarrier.get() :
+        this->postUpdateStartBarrier.get();
+    auto *stopBarrier = _pipelined ? this->pipelinedStopBarrier.get() :
+        this->postUpdateStopBarrier.get();
+    const auto *info = _pipelined ? &this->pipelinedPostUpdateInfo :
+        &this->postUpdateInfo;
+    const EntityComponentManager *ecm = _pipelined ? &this->postUpdateEcm :
+        &this->entityCompMgr;
+    this->postUpdateThreads.push_back(std::thread([this, id, system, timing,
+        startBarrier, stopBarrier, info, ecm]()
     {
       std::stringstream ss;
       ss << "PostUpdateThread: " << id;
       IGN_PROFILE_THREAD_NAME(ss.str().c_str());
       while (this->postUpdateThreadsRunning)
       {
-        this->postUpdateStartBarrier->Wait();
+        startBarrier->Wait();
         if (this->postUpdateThreadsRunning)
         {
-          system->PostUpdate(this->currentInfo, this->entityCompMgr);
+          const auto start = std::chrono::steady_clock::now();
+          system->PostUpdate(*info, *ecm);
+          timing->Add(std::chrono::steady_clock::now() - start);
         }
-        this->postUpdateStopBarrier->Wait();
+        stopBarrier->Wait();
       }
       igndbg << "Exiting postupdate worker thread ("
         << id << ")" << std::endl;
     }));
     id++;
-  }
+  };
+
+  for (const auto *system : syncSystems)
+    createThread(system, false);
+  for (const auto *system : pipelinedSystems)
+    createThread(system, true);
 }
 
 /////////////////////////////////////////////////
@@ -531,23 +815,67 @@ void SimulationRunner::UpdateSystems()
   // WorkerPool.cc). We could turn on parallel updates in the future, and/or
   // turn it on if there are sufficient systems. More testing is required.
 
+  const auto stepStart = std::chrono::steady_clock::now();
+
+  // Fire the sim time timers which expired
+  this->timerWheel.Update(this->currentInfo, this->entityCompMgr);
+
   {
     IGN_PROFILE("PreUpdate");
-    for (auto& system : this->systemMgr->SystemsPreUpdate())
-      system->PreUpdate(this->currentInfo, this->entityCompMgr);
+    const auto &systems = this->systemMgr->SystemsPreUpdate();
+    const auto &timings = this->systemMgr->TimingsPreUpdate();
+    const auto &wakeUps = this->systemMgr->WakeUpsPreUpdate();
+    UpdateInfo wakeInfo;
+    for (std::size_t i = 0; i < systems.size(); ++i)
+    {
+      // Skip idle systems
+      if (wakeUps[i] &&
+          !wakeUps[i]->Due(this->currentInfo, this->entityCompMgr, wakeInfo))
+      {
+        continue;
+      }
+
+      const auto start = std::chrono::steady_clock::now();
+      systems[i]->PreUpdate(wakeUps[i] ? wakeInfo : this->currentInfo,
+          this->entityCompMgr);
+      timings[i]->Add(std::chrono::steady_clock::now() - start);
+      if (wakeUps[i])
+        wakeUps[i]->Updated(this->entityCompMgr);
+    }
   }
 
   {
     IGN_PROFILE("Update");
-    for (auto& system : this->systemMgr->SystemsUpdate())
-      system->Update(this->currentInfo, this->entityCompMgr);
+    const auto &systems = this->systemMgr->SystemsUpdate();
+    const auto &timings = this->systemMgr->TimingsUpdate();
+    for (std::size_t i = 0; i < systems.size(); ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      systems[i]->Update(this->currentInfo, this->entityCompMgr);
+      timings[i]->Add(std::chrono::steady_clock::now() - start);
+    }
+  }
+
+  // Pipelined systems read a mirror, which can only be updated once their
+  // previous PostUpdate is done. They're then started, and waited for on the
+  // next iteration.
+  if (this->pipelinedStartBarrier && this->pipelinedStopBarrier)
+  {
+    IGN_PROFILE("PipelinedPostUpdate");
+    this->WaitForPostUpdate();
+    this->SyncPostUpdateEcm();
+    this->pipelinedPostUpdateInfo = this->currentInfo;
+    this->postUpdateEcm.LockAddingEntitiesToViews(true);
+    this->pipelinedStartBarrier->Wait();
+    this->postUpdatePending = true;
   }
 
+  // If no systems implementing PostUpdate have been added, then
+  // the barriers will be uninitialized, so guard against that condition.
   {
     IGN_PROFILE("PostUpdate");
+    this->postUpdateInfo = this->currentInfo;
     this->entityCompMgr.LockAddingEntitiesToViews(true);
-    // If no systems implementing PostUpdate have been added, then
-    // the barriers will be uninitialized, so guard against that condition.
     if (this->postUpdateStartBarrier && this->postUpdateStopBarrier)
     {
       this->postUpdateStartBarrier->Wait();
@@ -555,6 +883,147 @@ void SimulationRunner::UpdateSystems()
     }
     this->entityCompMgr.LockAddingEntitiesToViews(false);
   }
+
+  this->stepTiming.Add(std::chrono::steady_clock::now() - stepStart);
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::WaitForPostUpdate()
+{
+  if (!this->postUpdatePending)
+    return;
+
+  IGN_PROFILE("SimulationRunner::WaitForPostUpdate");
+  if (this->pipelinedStopBarrier)
+    this->pipelinedStopBarrier->Wait();
+  this->postUpdateEcm.LockAddingEntitiesToViews(false);
+  this->postUpdatePending = false;
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::SyncPostUpdateEcm()
+{
+  IGN_PROFILE("SimulationRunner::SyncPostUpdateEcm");
+
+  // Only what changed since the previous snapshot is copied
+  this->postUpdateEcm.Mirror(this->entityCompMgr.Snapshot(),
+      &this->entityCompMgr);
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::ResetAll()
+{
+  IGN_PROFILE("SimulationRunner::ResetAll");
+  igndbg << "Resetting world to its initial state." << std::endl;
+
+  // PostUpdate systems may still be reading the previous state
+  this->WaitForPostUpdate();
+
+  this->entityCompMgr.ResetTo(*this->initialSnapshot);
+
+  this->currentInfo.paused = true;
+  this->currentInfo.dt = std::chrono::steady_clock::duration::zero();
+  this->systemMgr->Reset(this->currentInfo, this->entityCompMgr);
+
+  this->requestedReset = false;
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::PublishPerformance()
+{
+  auto now = std::chrono::steady_clock::now();
+  if (now - this->lastPerformancePub < std::chrono::seconds(1))
+    return;
+  this->lastPerformancePub = now;
+
+  // PostUpdate timings are written by PostUpdate threads
+  this->WaitForPostUpdate();
+
+  // Timings are only accumulated over the last second, so they're reset even
+  // if nobody is listening
+  if (this->performancePub.HasConnections())
+  {
+    IGN_PROFILE("SimulationRunner::PublishPerformance");
+
+    auto toUs = [](const std::chrono::steady_clock::duration &_duration)
+    {
+      return std::chrono::duration<double, std::micro>(_duration).count();
+    };
+
+    auto addStats = [&](msgs::Param *_param, const std::string &_prefix,
+        const SystemTimingStats &_stats)
+    {
+      auto &params = *_param->mutable_params();
+      params[_prefix + "count"].set_type(msgs::Any::INT32);
+      params[_prefix + "count"].set_int_value(
+          static_cast<int>(_stats.count));
+      params[_prefix + "mean_us"].set_type(msgs::Any::DOUBLE);
+      params[_prefix + "mean_us"].set_double_value(toUs(_stats.Mean()));
+      params[_prefix + "max_us"].set_type(msgs::Any::DOUBLE);
+      params[_prefix + "max_us"].set_double_value(toUs(_stats.max));
+      params[_prefix + "total_us"].set_type(msgs::Any::DOUBLE);
+      params[_prefix + "total_us"].set_double_value(toUs(_stats.total));
+
+      // Bucket i counts calls shorter than 2^i microseconds
+      for (std::size_t i = 0; i < SystemTimingStats::kBucketCount; ++i)
+      {
+        if (0u == _stats.buckets[i])
+          continue;
+        auto key = _prefix + "bucket_" + std::to_string(i);
+        params[key].set_type(msgs::Any::INT32);
+        params[key].set_int_value(static_cast<int>(_stats.buckets[i]));
+      }
+    };
+
+    auto setString = [](msgs::Param *_param, const std::string &_key,
+        const std::string &_value)
+    {
+      auto &any = (*_param->mutable_params())[_key];
+      any.set_type(msgs::Any::STRING);
+      any.set_string_value(_value);
+    };
+
+    auto setInt = [](msgs::Param *_param, const std::string &_key,
+        std::size_t _value)
+    {
+      auto &any = (*_param->mutable_params())[_key];
+      any.set_type(msgs::Any::INT32);
+      any.set_int_value(static_cast<int>(_value));
+    };
+
+    msgs::Param_V msg;
+
+    // The first entry has world statistics and the timing of whole steps
+    auto worldParam = msg.add_param();
+    setString(worldParam, "name", this->worldName);
+    setInt(worldParam, "entity_count", this->entityCompMgr.EntityCount());
+    setInt(worldParam, "component_count",
+        this->entityCompMgr.ComponentCount());
+    setInt(worldParam, "view_count", this->entityCompMgr.ViewCount());
+    setInt(worldParam, "system_count", this->systemMgr->ActiveCount());
+    auto &rtf = (*worldParam->mutable_params())["real_time_factor"];
+    rtf.set_type(msgs::Any::DOUBLE);
+    rtf.set_double_value(this->realTimeFactor);
+    addStats(worldParam, "step_", this->stepTiming);
+
+    // One entry per system
+    for (const auto &system : this->systemMgr->Systems())
+    {
+      auto systemParam = msg.add_param();
+      setString(systemParam, "name", system.name);
+      if (system.preupdate)
+        addStats(systemParam, "preupdate_", system.timing->preUpdate);
+      if (system.update)
+        addStats(systemParam, "update_", system.timing->update);
+      if (system.postupdate)
+        addStats(systemParam, "postupdate_", system.timing->postUpdate);
+    }
+
+    this->performancePub.Publish(msg);
+  }
+
+  this->stepTiming.Reset();
+  this->systemMgr->ResetTimings();
 }
 
 /////////////////////////////////////////////////
@@ -568,12 +1037,19 @@ void SimulationRunner::OnStop()
 {
   this->stopReceived = true;
   this->running = false;
+
+  // Release step and state requests which won't be done
+  {
+    std::lock_guard<std::mutex> lock(this->msgBufferMutex);
+  }
+  this->stepStateCv.notify_all();
 }
 
 /////////////////////////////////////////////////
 void SimulationRunner::StopWorkerThreads()
 {
   this->postUpdateThreadsRunning = false;
+  this->postUpdatePending = false;
   if (this->postUpdateStartBarrier)
   {
     this->postUpdateStartBarrier->Cancel();
@@ -582,6 +1058,14 @@ void SimulationRunner::StopWorkerThreads()
   {
     this->postUpdateStopBarrier->Cancel();
   }
+  if (this->pipelinedStartBarrier)
+  {
+    this->pipelinedStartBarrier->Cancel();
+  }
+  if (this->pipelinedStopBarrier)
+  {
+    this->pipelinedStopBarrier->Cancel();
+  }
   for (auto &thread : this->postUpdateThreads)
   {
     thread.join();
@@ -628,6 +1112,10 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   std::chrono::steady_clock::duration sleepTime;
   std::chrono::steady_clock::duration actualSleep;
 
+  // Start pacing from the first step of this run, instead of catching up
+  // with the deadline of a previous run
+  this->nextStepDeadline.reset();
+
   this->running = true;
 
   // Create the world statistics publisher.
@@ -645,6 +1133,14 @@ bool SimulationRunner::Run(const uint64_t _iterations)
         "stats", advertOpts);
   }
 
+  // Create the performance publisher.
+  if (!this->performancePub.Valid())
+  {
+    this->performancePub = this->node->Advertise<ignition::msgs::Param_V>(
+        "performance");
+    this->lastPerformancePub = std::chrono::steady_clock::now();
+  }
+
   if (!this->rootStatsPub.Valid())
   {
     // Check for the existence of other publishers on `/stats`
@@ -709,6 +1205,16 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   // Keep number of iterations requested by caller
   uint64_t processedIterations{0};
 
+  // Used to report throughput in batch mode
+  const auto batchStartTime = std::chrono::steady_clock::now();
+  const auto batchStartSimTime = this->currentInfo.simTime;
+  if (this->batchMode)
+  {
+    this->lastBatchStatsPub = batchStartTime;
+    this->batchStatsSimTime = this->currentInfo.simTime;
+    this->batchStatsRealTime = this->realTimeWatch.ElapsedRunTime();
+  }
+
   // Execute all the systems until we are told to stop, or the number of
   // iterations is reached.
   while (this->running && (_iterations == 0 ||
@@ -719,32 +1225,49 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     // Update the step size and desired rtf
     this->UpdatePhysicsParams();
 
-    // Compute the time to sleep in order to match, as closely as possible,
-    // the update period.
-    sleepTime = 0ns;
-    actualSleep = 0ns;
+    // Batch mode runs as fast as possible, so there's no need to sleep while
+    // running
+    if (!this->batchMode && this->precisePacing)
+    {
+      this->WaitForNextStep();
+    }
+    else if (!this->batchMode)
+    {
+      // Compute the time to sleep in order to match, as closely as possible,
+      // the update period.
+      sleepTime = 0ns;
+      actualSleep = 0ns;
 
-    sleepTime = std::max(0ns, this->prevUpdateRealTime +
-        this->updatePeriod - std::chrono::steady_clock::now() -
-        this->sleepOffset);
+      sleepTime = std::max(0ns, this->prevUpdateRealTime +
+          this->updatePeriod - std::chrono::steady_clock::now() -
+          this->sleepOffset);
+
+      // Only sleep if needed.
+      if (sleepTime > 0ns)
+      {
+        IGN_PROFILE("Sleep");
+        // Get the current time, sleep for the duration needed to match the
+        // updatePeriod, and then record the actual time slept.
+        startTime = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(sleepTime);
+        actualSleep = std::chrono::steady_clock::now() - startTime;
+      }
 
-    // Only sleep if needed.
-    if (sleepTime > 0ns)
+      // Exponentially average out the difference between expected sleep
+      // time and actual sleep time.
+      this->sleepOffset =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            (actualSleep - sleepTime) * 0.01 + this->sleepOffset * 0.99);
+    }
+    else if (this->currentInfo.paused)
     {
+      // Batch mode only skips the sleep while running. While paused there
+      // are no steps to catch up on, so sleep instead of spinning.
       IGN_PROFILE("Sleep");
-      // Get the current time, sleep for the duration needed to match the
-      // updatePeriod, and then record the actual time slept.
-      startTime = std::chrono::steady_clock::now();
-      std::this_thread::sleep_for(sleepTime);
-      actualSleep = std::chrono::steady_clock::now() - startTime;
+      std::this_thread::sleep_for(std::max<std::chrono::nanoseconds>(
+          this->updatePeriod, this->stepSize));
     }
 
-    // Exponentially average out the difference between expected sleep time
-    // and actual sleep time.
-    this->sleepOffset =
-      std::chrono::duration_cast<std::chrono::nanoseconds>(
-          (actualSleep - sleepTime) * 0.01 + this->sleepOffset * 0.99);
-
     // Update time information. This will update the iteration count, RTF,
     // and other values.
     this->UpdateCurrentInfo();
@@ -774,8 +1297,35 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     }
   }
 
+  // PostUpdate of the last iteration is done when Run returns
+  this->WaitForPostUpdate();
+
+  if (this->batchMode)
+  {
+    const std::chrono::duration<double> wallTime =
+        std::chrono::steady_clock::now() - batchStartTime;
+    const std::chrono::duration<double> simTime =
+        this->currentInfo.simTime - batchStartSimTime;
+    ignmsg << "Batch run of world [" << this->worldName << "] finished: "
+           << processedIterations << " iterations, " << simTime.count()
+           << " s of sim time in " << wallTime.count() << " s of wall time";
+    if (wallTime.count() > 0.0)
+    {
+      ignmsg << " (" << processedIterations / wallTime.count()
+             << " iterations/s, real time factor "
+             << simTime.count() / wallTime.count() << ")";
+    }
+    ignmsg << "." << std::endl;
+  }
+
   this->running = false;
 
+  // Release step and state requests which won't be processed
+  {
+    std::lock_guard<std::mutex> lock(this->msgBufferMutex);
+  }
+  this->stepStateCv.notify_all();
+
   return true;
 }
 
@@ -790,16 +1340,36 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   this->ProcessNewWorldControlState();
 
   // Publish info
-  this->PublishStats();
+  if (this->batchMode)
+  {
+    this->PublishBatchStats();
+  }
+  else
+  {
+    this->PublishStats();
+  }
+  this->PublishPerformance();
 
   // Record when the update step starts.
-  this->prevUpdateRealTime = std::chrono::steady_clock::now();
+  if (!this->batchMode)
+    this->prevUpdateRealTime = std::chrono::steady_clock::now();
 
   this->levelMgr->UpdateLevelsState();
 
   // Handle pending systems
   this->ProcessSystemQueue();
 
+  // Keep the initial state, for resets
+  if (!this->initialSnapshot)
+    this->initialSnapshot = this->entityCompMgr.FullSnapshot();
+
+  // The reset iteration is paused, so systems can see the initial state
+  // before time starts moving again
+  const bool resetIteration = this->requestedReset;
+  const bool paused = this->currentInfo.paused;
+  if (resetIteration)
+    this->ResetAll();
+
   // Handle entities that need to be recreated.
   // Put in a request to mark them as removed so that in the UpdateSystem call
   // the systems can remove them first before new ones are created. This is
@@ -809,7 +1379,10 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Update all the systems.
   this->UpdateSystems();
 
-  if (!this->Paused() &&
+  if (resetIteration)
+    this->currentInfo.paused = paused;
+
+  if (!resetIteration && !this->Paused() &&
        this->requestedRunToSimTime >
        std::chrono::steady_clock::duration::zero() &&
        this->currentInfo.simTime >= this->requestedRunToSimTime)
@@ -818,7 +1391,7 @@ void SimulationRunner::Step(const UpdateInfo &_info)
     this->requestedRunToSimTime = std::chrono::steady_clock::duration{-1};
   }
 
-  if (!this->Paused() && this->pendingSimIterations > 0)
+  if (!resetIteration && !this->Paused() && this->pendingSimIterations > 0)
   {
     // Decrement the pending sim iterations, if there are any.
     --this->pendingSimIterations;
@@ -1123,6 +1696,7 @@ bool SimulationRunner::OnWorldControlState(const msgs::WorldControlState &_req,
   {
     control.rewind = _req.world_control().reset().all() ||
       _req.world_control().reset().time_only();
+    control.reset = _req.world_control().reset().all();
 
     if (_req.world_control().reset().model_only())
     {
@@ -1148,6 +1722,77 @@ bool SimulationRunner::OnWorldControlState(const msgs::WorldControlState &_req,
   return true;
 }
 
+/////////////////////////////////////////////////
+bool SimulationRunner::OnStepState(const msgs::WorldControlState &_req,
+    msgs::SerializedStepMap &_res)
+{
+  auto request = std::make_shared<StepStateRequest>();
+
+  if (_req.world_control().multi_step() != 0)
+    request->multiStep = _req.world_control().multi_step();
+  else if (_req.world_control().step())
+    request->multiStep = 1;
+
+  for (const auto &entityMsg : _req.state().entities())
+  {
+    if (entityMsg.id() != kNullEntity)
+      request->entities.insert(entityMsg.id());
+
+    for (const auto &compMsg : entityMsg.components())
+      request->types.insert(static_cast<ComponentTypeId>(compMsg.type()));
+  }
+
+  // Clients send how long they wait for the reply, so the request isn't
+  // cancelled while they're still waiting
+  std::chrono::steady_clock::duration timeout{kStepStateTimeout};
+  for (const auto &data : _req.header().data())
+  {
+    if (data.key() != "timeout_ms" || data.value_size() == 0)
+      continue;
+
+    try
+    {
+      timeout = std::chrono::milliseconds(std::stoul(data.value(0)));
+    }
+    catch (const std::exception &)
+    {
+      ignwarn << "Invalid step and state timeout [" << data.value(0)
+              << "], using [" << std::chrono::duration_cast<
+              std::chrono::milliseconds>(kStepStateTimeout).count()
+              << "] ms." << std::endl;
+    }
+  }
+
+  // Nothing would process the request
+  if (!this->running)
+  {
+    ignerr << "Unable to step and get the state, simulation isn't running."
+           << std::endl;
+    return false;
+  }
+
+  // Wait for the simulation thread to run the iterations and fill the state
+  std::unique_lock<std::mutex> lock(this->msgBufferMutex);
+  this->stepStateRequests.push_back(request);
+  this->stepStateCv.wait_for(lock, timeout, [&]
+  {
+    return request->done || this->stopReceived || !this->running;
+  });
+
+  if (!request->done)
+  {
+    // The simulation thread withdraws the iterations which didn't run yet
+    request->cancelled = true;
+    ignwarn << "Step and state request of [" << request->multiStep
+            << "] iterations wasn't done in time, or simulation stopped."
+            << std::endl;
+    return false;
+  }
+
+  _res.Swap(&request->response);
+  return true;
+}
+
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessNewWorldControlState()
 {
@@ -1197,6 +1842,7 @@ void SimulationRunner::ProcessMessages()
   IGN_PROFILE("SimulationRunner::ProcessMessages");
   std::lock_guard<std::mutex> lock(this->msgBufferMutex);
   this->ProcessWorldControl();
+  this->ProcessStepStateRequests();
 }
 
 /////////////////////////////////////////////////
@@ -1223,6 +1869,13 @@ void SimulationRunner::ProcessWorldControl()
 
     // Rewind / reset
     this->requestedRewind = control.rewind;
+    this->requestedReset = control.reset;
+    if (control.reset && (this->networkMgr || this->serverConfig.UseLevels()))
+    {
+      ignwarn << "Resetting entities isn't supported with levels or "
+              << "distributed simulation, only rewinding time." << std::endl;
+      this->requestedReset = false;
+    }
 
     // Seek
     if (control.seek >= std::chrono::steady_clock::duration::zero())
@@ -1236,6 +1889,107 @@ void SimulationRunner::ProcessWorldControl()
   this->worldControls.clear();
 }
 
+/////////////////////////////////////////////////
+void SimulationRunner::ProcessStepStateRequests()
+{
+  if (this->stepStateRequests.empty())
+    return;
+
+  IGN_PROFILE("SimulationRunner::ProcessStepStateRequests");
+
+  // Withdraw the iterations of requests whose callers stopped waiting, so
+  // they don't keep the simulation running. Requests started after them
+  // target fewer iterations.
+  uint64_t previousTarget = this->currentInfo.iterations;
+  uint64_t withdrawn{0u};
+  for (auto iter = this->stepStateRequests.begin();
+       iter != this->stepStateRequests.end();)
+  {
+    auto &request = **iter;
+    if (request.started)
+    {
+      request.targetIterations -= std::min(withdrawn,
+          request.targetIterations);
+    }
+
+    if (!request.cancelled)
+    {
+      if (request.started)
+        previousTarget = std::max(previousTarget, request.targetIterations);
+      ++iter;
+      continue;
+    }
+
+    if (request.started && request.targetIterations > previousTarget)
+    {
+      const auto remaining = request.targetIterations - previousTarget;
+      withdrawn += remaining;
+      this->pendingSimIterations -= static_cast<unsigned int>(
+          std::min<uint64_t>(remaining, this->pendingSimIterations));
+      if (this->pendingSimIterations == 0u)
+        this->SetPaused(true);
+    }
+    iter = this->stepStateRequests.erase(iter);
+  }
+
+  if (this->stepStateRequests.empty())
+    return;
+
+  auto reply = [this](StepStateRequest &_request)
+  {
+    set(_request.response.mutable_stats(), this->currentInfo);
+    _request.response.mutable_stats()->set_paused(this->Paused());
+    this->entityCompMgr.State(*_request.response.mutable_state(),
+        _request.entities, _request.types, true);
+    _request.done = true;
+  };
+
+  // Reply to requests whose iterations are done, or were interrupted by a
+  // pause, a rewind or a seek
+  bool replied{false};
+  for (auto &request : this->stepStateRequests)
+  {
+    if (request->started &&
+        (this->currentInfo.iterations >= request->targetIterations ||
+         this->Paused()))
+    {
+      reply(*request);
+      replied = true;
+    }
+  }
+
+  // Start the iterations of new requests, after those already queued
+  for (auto &request : this->stepStateRequests)
+  {
+    if (request->started)
+      continue;
+
+    request->started = true;
+    if (request->multiStep == 0u)
+    {
+      reply(*request);
+      replied = true;
+      continue;
+    }
+
+    this->pendingSimIterations += request->multiStep;
+    this->SetPaused(false);
+    this->SetStepping(true);
+    request->targetIterations =
+        this->currentInfo.iterations + this->pendingSimIterations;
+  }
+
+  if (replied)
+  {
+    this->stepStateRequests.remove_if(
+        [](const std::shared_ptr<StepStateRequest> &_request)
+        {
+          return _request->done;
+        });
+    this->stepStateCv.notify_all();
+  }
+}
+
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessRecreateEntitiesRemove()
 {
@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <list>
 #include <memory>
@@ -54,6 +55,7 @@
 #include "network/NetworkManager.hh"
 #include "LevelManager.hh"
 #include "SystemManager.hh"
+#include "SimTimerWheel.hh"
 #include "Barrier.hh"
 #include "WorldControl.hh"
 
@@ -136,6 +138,32 @@ namespace ignition
       /// \brief Publish current world statistics.
       public: void PublishStats();
 
+      /// \brief Publish current world statistics in batch mode, throttled
+      /// by wall time instead of once per iteration. The real time factor is
+      /// computed over the period since the last publication.
+      public: void PublishBatchStats();
+
+      /// \brief Wait for PostUpdate threads which are still running in
+      /// pipelined mode. It does nothing if there are none.
+      private: void WaitForPostUpdate();
+
+      /// \brief Copy changes of the current iteration to the ECM mirror read
+      /// by PostUpdate systems in pipelined mode.
+      private: void SyncPostUpdateEcm();
+
+      /// \brief Restore the initial entities and components, and reset the
+      /// systems. Sim time must have been rewound already.
+      private: void ResetAll();
+
+      /// \brief Wait until the next iteration is due with precise pacing,
+      /// and record how late it started.
+      private: void WaitForNextStep();
+
+      /// \brief Publish the wall time taken by each system since the last
+      /// time it was published, together with ECM statistics, on the
+      /// `performance` topic. This is done once per second of wall time.
+      public: void PublishPerformance();
+
       /// \brief Load system plugin for a given entity.
       /// \param[in] _entity Entity
       /// \param[in] _fname Filename of the plugin library
@@ -306,6 +334,23 @@ namespace ignition
       private: bool OnWorldControlState(const msgs::WorldControlState &_req,
                                          msgs::Boolean &_res);
 
+      /// \brief Step and state service callback. This function queues the
+      /// request, which is processed by the ProcessMessages function, and
+      /// blocks until the requested iterations have run.
+      /// \param[in] _req Request from client. The world control's multi step
+      /// (or step) is the number of iterations to run, after which simulation
+      /// is paused. The entities in the state select which entities are
+      /// returned, and the components they contain select which component
+      /// types are returned for all of them. The null entity can be used to
+      /// select component types without selecting entities. When empty, the
+      /// whole state is returned.
+      /// \param[out] _res World statistics and state after the iterations.
+      /// \return True for success. False if simulation isn't running, or if
+      /// the iterations took longer than 5 seconds, in which case those which
+      /// didn't run yet are cancelled.
+      private: bool OnStepState(const msgs::WorldControlState &_req,
+                                msgs::SerializedStepMap &_res);
+
       /// \brief World control service callback. This function stores the
       /// the request which will then be processed by the ProcessMessages
       /// function.
@@ -331,6 +376,11 @@ namespace ignition
       /// \brief Process world control service messages.
       private: void ProcessWorldControl();
 
+      /// \brief Start the iterations of new step and state requests, and
+      /// reply to those whose iterations are done. The message buffer mutex
+      /// must be locked.
+      private: void ProcessStepStateRequests();
+
       /// \brief Actually add system to the runner
       /// \param[in] _system System to be added
       public: void AddSystemToRunner(SystemInternal _system);
@@ -430,6 +480,49 @@ namespace ignition
       /// \brief List of real times used to compute averages.
       private: std::list<std::chrono::steady_clock::duration> realTimes;
 
+      /// \brief Run as fast as possible, see ServerConfig::SetBatchMode.
+      private: bool batchMode{false};
+
+      /// \brief Wall time of the last statistics published in batch mode.
+      private: std::chrono::steady_clock::time_point lastBatchStatsPub;
+
+      /// \brief Sim time when statistics were last published in batch mode,
+      /// used to compute the real time factor.
+      private: std::chrono::steady_clock::duration batchStatsSimTime{0};
+
+      /// \brief Real time when statistics were last published in batch mode,
+      /// used to compute the real time factor.
+      private: std::chrono::steady_clock::duration batchStatsRealTime{0};
+
+      /// \brief Pace iterations with absolute deadlines, see
+      /// ServerConfig::SetPrecisePacing.
+      private: bool precisePacing{false};
+
+      /// \brief Deadline of the next iteration with precise pacing.
+      private: std::optional<std::chrono::steady_clock::time_point>
+          nextStepDeadline;
+
+      /// \brief How late iterations started with respect to their deadline
+      /// in the current statistics window, with precise pacing.
+      private: SystemTimingStats pacingJitter;
+
+      /// \brief Number of iterations in the current statistics window whose
+      /// deadline had already passed when the previous one finished.
+      private: uint64_t pacingOverruns{0u};
+
+      /// \brief Wall time when the current statistics window started.
+      private: std::chrono::steady_clock::time_point pacingWindowStart;
+
+      /// \brief Jitter of the last complete statistics window, which is the
+      /// one published.
+      private: SystemTimingStats lastPacingJitter;
+
+      /// \brief Overruns of the last complete statistics window.
+      private: uint64_t lastPacingOverruns{0u};
+
+      /// \brief World entity, cached to avoid looking it up every iteration.
+      private: Entity cachedWorldEntity{kNullEntity};
+
       /// \brief Node for communication.
       private: std::unique_ptr<transport::Node> node{nullptr};
 
@@ -445,6 +538,16 @@ namespace ignition
       /// \brief Clock publisher for the root `/clock` topic.
       private: ignition::transport::Node::Publisher rootClockPub;
 
+      /// \brief Publisher of system timing and ECM statistics.
+      private: ignition::transport::Node::Publisher performancePub;
+
+      /// \brief Wall time of the last performance message.
+      private: std::chrono::steady_clock::time_point lastPerformancePub;
+
+      /// \brief Wall time taken by UpdateSystems since the last performance
+      /// message.
+      private: SystemTimingStats stepTiming;
+
       /// \brief Name of world being simulated.
       private: std::string worldName;
 
@@ -466,6 +569,13 @@ namespace ignition
       /// \brief Connection to the load plugins event.
       private: common::ConnectionPtr loadPluginsConn;
 
+      /// \brief Connection to the add sim timer event.
+      private: common::ConnectionPtr addSimTimerConn;
+
+      /// \brief Sim time timers of all systems, fired at the beginning of
+      /// each iteration.
+      private: SimTimerWheel timerWheel;
+
       /// \brief Pointer to the sdf::World object of this runner
       private: const sdf::World *sdfWorld;
 
@@ -480,6 +590,15 @@ namespace ignition
       /// \brief True if user requested to rewind simulation.
       private: bool requestedRewind{false};
 
+      /// \brief True if user requested to reset the world to its initial
+      /// state.
+      private: bool requestedReset{false};
+
+      /// \brief Entities and components right before the first iteration,
+      /// restored when the world is reset.
+      private: std::shared_ptr<const EntityComponentManagerSnapshot>
+          initialSnapshot;
+
       /// \brief If user asks to seek to a specific sim time, this holds the
       /// time.s A negative value means there's no request from the user.
       private: std::chrono::steady_clock::duration requestedSeek{-1};
@@ -494,6 +613,41 @@ namespace ignition
       /// \brief Buffer of world control messages.
       private: std::list<WorldControl> worldControls;
 
+      /// \brief A request of the step and state service.
+      private: struct StepStateRequest
+      {
+        /// \brief Number of iterations to run.
+        uint64_t multiStep{0u};
+
+        /// \brief Entities to serialize, all if empty.
+        std::unordered_set<Entity> entities;
+
+        /// \brief Component types to serialize, all if empty.
+        std::unordered_set<ComponentTypeId> types;
+
+        /// \brief True once the iterations started.
+        bool started{false};
+
+        /// \brief Iteration count after which the state is returned.
+        uint64_t targetIterations{0u};
+
+        /// \brief True once the response is filled.
+        bool done{false};
+
+        /// \brief True if the caller stopped waiting for the response.
+        bool cancelled{false};
+
+        /// \brief Response.
+        msgs::SerializedStepMap response;
+      };
+
+      /// \brief Step and state requests which haven't been replied to.
+      private: std::list<std::shared_ptr<StepStateRequest>> stepStateRequests;
+
+      /// \brief Notifies step and state callbacks when requests are done.
+      /// Used with the message buffer mutex.
+      private: std::condition_variable stepStateCv;
+
       /// \brief Mutex to protect message buffers.
       private: std::mutex msgBufferMutex;
 
@@ -515,6 +669,34 @@ namespace ignition
       /// \brief Barrier to signal end of PostUpdate thread execution
       private: std::unique_ptr<Barrier> postUpdateStopBarrier;
 
+      /// \brief Barrier to signal beginning of pipelined PostUpdate thread
+      /// execution. Null if no system's PostUpdate is pipelined.
+      private: std::unique_ptr<Barrier> pipelinedStartBarrier;
+
+      /// \brief Barrier to signal end of pipelined PostUpdate thread
+      /// execution. Null if no system's PostUpdate is pipelined.
+      private: std::unique_ptr<Barrier> pipelinedStopBarrier;
+
+      /// \brief Update info passed to PostUpdate, which is a copy of the
+      /// current info when PostUpdate threads are started.
+      private: UpdateInfo postUpdateInfo;
+
+      /// \brief Update info passed to pipelined PostUpdate, which is a copy
+      /// of the current info when pipelined PostUpdate threads are started.
+      private: UpdateInfo pipelinedPostUpdateInfo;
+
+      /// \brief Overlap PostUpdate with the next iteration, see
+      /// ServerConfig::SetPipelinedPostUpdate.
+      private: bool pipelinedPostUpdate{false};
+
+      /// \brief Mirror of the ECM read by pipelined PostUpdate systems,
+      /// updated from snapshots of the ECM.
+      private: EntityComponentManager postUpdateEcm;
+
+      /// \brief Whether pipelined PostUpdate threads have been started and
+      /// not waited for yet.
+      private: bool postUpdatePending{false};
+
       /// \brief Map from file paths to Fuel URIs.
       private: std::unordered_map<std::string, std::string> fuelUriMap;
 
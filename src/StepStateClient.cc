@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/StepStateClient.hh"
+
+#include <ignition/msgs/world_control_state.pb.h>
+
+#include <ignition/common/Console.hh>
+#include <ignition/transport/Node.hh>
+#include <ignition/transport/TopicUtils.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Private data for StepStateClient
+class ignition::gazebo::StepStateClientPrivate
+{
+  /// \brief Update the state filter of the request.
+  public: void UpdateFilter()
+  {
+    auto stateMsg = this->req.mutable_state();
+    stateMsg->clear_entities();
+
+    for (const auto &entity : this->entities)
+      stateMsg->add_entities()->set_id(entity);
+
+    if (this->types.empty())
+      return;
+
+    // Types are given by the components of the first entity, or of the null
+    // entity if no entities are selected
+    auto entityMsg = stateMsg->entities_size() > 0 ?
+        stateMsg->mutable_entities(0) : stateMsg->add_entities();
+    for (const auto &type : this->types)
+      entityMsg->add_components()->set_type(static_cast<int64_t>(type));
+  }
+
+  /// \brief Communication node.
+  public: transport::Node node;
+
+  /// \brief Step and state service name.
+  public: std::string service;
+
+  /// \brief Selected entities.
+  public: std::unordered_set<Entity> entities;
+
+  /// \brief Selected component types.
+  public: std::unordered_set<ComponentTypeId> types;
+
+  /// \brief Request, with the current filter.
+  public: msgs::WorldControlState req;
+};
+
+//////////////////////////////////////////////////
+StepStateClient::StepStateClient(const std::string &_worldName)
+  : dataPtr(std::make_unique<StepStateClientPrivate>())
+{
+  this->dataPtr->service = transport::TopicUtils::AsValidTopic(
+      "/world/" + _worldName + "/control/step_state");
+  if (this->dataPtr->service.empty())
+  {
+    ignerr << "Invalid world name [" << _worldName << "]" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+StepStateClient::~StepStateClient() = default;
+
+//////////////////////////////////////////////////
+void StepStateClient::SetEntities(const std::unordered_set<Entity> &_entities)
+{
+  this->dataPtr->entities = _entities;
+  this->dataPtr->UpdateFilter();
+}
+
+//////////////////////////////////////////////////
+void StepStateClient::SetComponentTypes(
+    const std::unordered_set<ComponentTypeId> &_types)
+{
+  this->dataPtr->types = _types;
+  this->dataPtr->UpdateFilter();
+}
+
+//////////////////////////////////////////////////
+std::optional<msgs::SerializedStepMap> StepStateClient::Step(
+    uint64_t _iterations, unsigned int _timeout)
+{
+  if (this->dataPtr->service.empty())
+    return std::nullopt;
+
+  this->dataPtr->req.mutable_world_control()->set_multi_step(_iterations);
+
+  // The server cancels the iterations which didn't run once we stop waiting
+  auto header = this->dataPtr->req.mutable_header();
+  header->clear_data();
+  auto data = header->add_data();
+  data->set_key("timeout_ms");
+  data->add_value(std::to_string(_timeout));
+
+  msgs::SerializedStepMap res;
+  bool result{false};
+  if (!this->dataPtr->node.Request(this->dataPtr->service,
+      this->dataPtr->req, _timeout, res, result))
+  {
+    ignerr << "Timed out waiting for [" << this->dataPtr->service << "]"
+           << std::endl;
+    return std::nullopt;
+  }
+
+  if (!result)
+  {
+    ignerr << "Request to [" << this->dataPtr->service << "] failed"
+           << std::endl;
+    return std::nullopt;
+  }
+
+  return res;
+}
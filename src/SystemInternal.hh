@@ -19,6 +19,8 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,6 +28,8 @@
 #include "ignition/gazebo/System.hh"
 #include "ignition/gazebo/SystemPluginPtr.hh"
 
+#include "SystemTiming.hh"
+
 namespace ignition
 {
   namespace gazebo
@@ -33,6 +37,110 @@ namespace ignition
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 
+    /// \brief Calls the update callbacks of a system at a lower rate than
+    /// the simulation, so systems which don't need to run on every step, such
+    /// as publishers and slow controllers, don't slow down simulation. When a
+    /// callback is skipped, the next call is given the sim time elapsed since
+    /// the previous one as its dt. All callbacks are called while paused.
+    class SystemThrottle :
+      public ISystemPreUpdate,
+      public ISystemUpdate,
+      public ISystemPostUpdate
+    {
+      /// \brief Constructor
+      /// \param[in] _preupdate System's PreUpdate interface, may be null.
+      /// \param[in] _update System's Update interface, may be null.
+      /// \param[in] _postupdate System's PostUpdate interface, may be null.
+      /// \param[in] _period Minimum sim time between callbacks.
+      public: SystemThrottle(ISystemPreUpdate *_preupdate,
+                  ISystemUpdate *_update,
+                  ISystemPostUpdate *_postupdate,
+                  const std::chrono::steady_clock::duration &_period)
+              : preupdate(_preupdate),
+                update(_update),
+                postupdate(_postupdate),
+                period(_period)
+      {
+      }
+
+      // Documentation inherited
+      public: void PreUpdate(const UpdateInfo &_info,
+                  EntityComponentManager &_ecm) override
+      {
+        UpdateInfo info;
+        if (this->Due(_info, this->lastPreUpdate, info))
+          this->preupdate->PreUpdate(info, _ecm);
+      }
+
+      // Documentation inherited
+      public: void Update(const UpdateInfo &_info,
+                  EntityComponentManager &_ecm) override
+      {
+        UpdateInfo info;
+        if (this->Due(_info, this->lastUpdate, info))
+          this->update->Update(info, _ecm);
+      }
+
+      // Documentation inherited
+      public: void PostUpdate(const UpdateInfo &_info,
+                  const EntityComponentManager &_ecm) override
+      {
+        UpdateInfo info;
+        if (this->Due(_info, this->lastPostUpdate, info))
+          this->postupdate->PostUpdate(info, _ecm);
+      }
+
+      /// \brief Check whether a callback should be called.
+      /// \param[in] _info Simulation update info.
+      /// \param[in, out] _last Sim time of the last call of the callback.
+      /// Updated if the callback is due.
+      /// \param[out] _throttledInfo Update info to pass to the callback, with
+      /// dt covering all the skipped steps.
+      /// \return True if the callback should be called.
+      private: bool Due(const UpdateInfo &_info,
+                   std::optional<std::chrono::steady_clock::duration> &_last,
+                   UpdateInfo &_throttledInfo) const
+      {
+        _throttledInfo = _info;
+        if (_info.paused)
+          return true;
+
+        // Sim time may jump back, for example after a reset
+        if (_last && _info.simTime >= *_last)
+        {
+          const auto elapsed = _info.simTime - *_last;
+          if (elapsed < this->period)
+            return false;
+          _throttledInfo.dt = elapsed;
+        }
+        _last = _info.simTime;
+        return true;
+      }
+
+      /// \brief System's PreUpdate interface
+      private: ISystemPreUpdate *preupdate;
+
+      /// \brief System's Update interface
+      private: ISystemUpdate *update;
+
+      /// \brief System's PostUpdate interface
+      private: ISystemPostUpdate *postupdate;
+
+      /// \brief Minimum sim time between callbacks
+      private: std::chrono::steady_clock::duration period;
+
+      /// \brief Sim time of the last PreUpdate call
+      private: std::optional<std::chrono::steady_clock::duration>
+          lastPreUpdate;
+
+      /// \brief Sim time of the last Update call
+      private: std::optional<std::chrono::steady_clock::duration> lastUpdate;
+
+      /// \brief Sim time of the last PostUpdate call
+      private: std::optional<std::chrono::steady_clock::duration>
+          lastPostUpdate;
+    };
+
     /// \brief Class to hold systems internally. It supports systems loaded
     /// from plugins, as well as systems created at runtime.
     class SystemInternal
@@ -45,7 +153,9 @@ namespace ignition
                 configure(systemPlugin->QueryInterface<ISystemConfigure>()),
                 preupdate(systemPlugin->QueryInterface<ISystemPreUpdate>()),
                 update(systemPlugin->QueryInterface<ISystemUpdate>()),
-                postupdate(systemPlugin->QueryInterface<ISystemPostUpdate>())
+                postupdate(systemPlugin->QueryInterface<ISystemPostUpdate>()),
+                wakeUpInterface(systemPlugin->QueryInterface<ISystemWakeUp>()),
+                reset(systemPlugin->QueryInterface<ISystemReset>())
       {
       }
 
@@ -57,7 +167,9 @@ namespace ignition
                 configure(dynamic_cast<ISystemConfigure *>(_system.get())),
                 preupdate(dynamic_cast<ISystemPreUpdate *>(_system.get())),
                 update(dynamic_cast<ISystemUpdate *>(_system.get())),
-                postupdate(dynamic_cast<ISystemPostUpdate *>(_system.get()))
+                postupdate(dynamic_cast<ISystemPostUpdate *>(_system.get())),
+                wakeUpInterface(dynamic_cast<ISystemWakeUp *>(_system.get())),
+                reset(dynamic_cast<ISystemReset *>(_system.get()))
       {
       }
 
@@ -89,6 +201,14 @@ namespace ignition
       /// Will be nullptr if the System doesn't implement this interface.
       public: ISystemPostUpdate *postupdate = nullptr;
 
+      /// \brief Access this system via the ISystemWakeUp interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemWakeUp *wakeUpInterface = nullptr;
+
+      /// \brief Access this system via the ISystemReset interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemReset *reset = nullptr;
+
       /// \brief Cached entity that was used to call `Configure` on the system
       /// Useful for if a system needs to be reconfigured at runtime
       public: Entity configureEntity = {kNullEntity};
@@ -99,6 +219,24 @@ namespace ignition
 
       /// \brief Vector of queries and callbacks
       public: std::vector<EntityQueryCallback> updates;
+
+      /// \brief Name of the system, used to report its timing.
+      public: std::string name;
+
+      /// \brief Wall time taken by the system's update callbacks. Shared, so
+      /// copies of this object point to the same timing.
+      public: std::shared_ptr<SystemTiming> timing{
+          std::make_shared<SystemTiming>()};
+
+      /// \brief Throttles the update callbacks of the system, if it has an
+      /// update rate. When set, the preupdate, update and postupdate
+      /// interfaces point to it instead of the system.
+      public: std::shared_ptr<SystemThrottle> throttle{nullptr};
+
+      /// \brief Conditions under which PreUpdate is called, if the system
+      /// implements ISystemWakeUp. Null if PreUpdate is called on every
+      /// iteration.
+      public: std::shared_ptr<SystemWakeUp> wakeUp{nullptr};
     };
     }
   }  // namespace gazebo
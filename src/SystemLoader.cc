@@ -15,9 +15,17 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <ignition/gazebo/SystemLoader.hh>
 
@@ -41,23 +49,70 @@ class ignition::gazebo::SystemLoaderPrivate
   public: explicit SystemLoaderPrivate() = default;
 
   //////////////////////////////////////////////////
-  public: bool InstantiateSystemPlugin(const std::string &_filename,
-              const std::string &_name,
-              const sdf::ElementPtr &/*_sdf*/,
-              ignition::plugin::PluginPtr &_plugin)
+  /// \brief Set the paths where plugins are searched for.
+  /// \param[in] _pluginPaths Paths added with AddSystemPluginPath.
+  /// \param[out] _systemPaths System paths to set up.
+  public: void SetSearchPaths(
+              const std::unordered_set<std::string> &_pluginPaths,
+              ignition::common::SystemPaths &_systemPaths) const
   {
-    ignition::common::SystemPaths systemPaths;
-    systemPaths.SetPluginPathEnv(pluginPathEnv);
+    _systemPaths.SetPluginPathEnv(pluginPathEnv);
 
-    for (const auto &path : this->systemPluginPaths)
-      systemPaths.AddPluginPaths(path);
+    for (const auto &path : _pluginPaths)
+      _systemPaths.AddPluginPaths(path);
 
     std::string homePath;
     ignition::common::env(IGN_HOMEDIR, homePath);
-    systemPaths.AddPluginPaths(homePath + "/.ignition/gazebo/plugins");
-    systemPaths.AddPluginPaths(IGN_GAZEBO_PLUGIN_INSTALL_DIR);
+    _systemPaths.AddPluginPaths(homePath + "/.ignition/gazebo/plugins");
+    _systemPaths.AddPluginPaths(IGN_GAZEBO_PLUGIN_INSTALL_DIR);
+  }
+
+  /// \brief Find a library, using the cache of previous searches.
+  /// \param[in] _filename Library filename.
+  /// \return Path to the library, empty if not found.
+  public: std::string FindLibrary(const std::string &_filename)
+  {
+    auto it = this->libraryPaths.find(_filename);
+    if (it != this->libraryPaths.end())
+      return it->second;
 
+    ignition::common::SystemPaths systemPaths;
+    this->SetSearchPaths(this->systemPluginPaths, systemPaths);
     auto pathToLib = systemPaths.FindSharedLibrary(_filename);
+
+    // Libraries which aren't found are searched for again next time, since
+    // they may be installed while running
+    if (!pathToLib.empty())
+      this->libraryPaths[_filename] = pathToLib;
+    return pathToLib;
+  }
+
+  /// \brief Load a library, unless it's already loaded.
+  /// \param[in] _pathToLib Path to the library.
+  /// \return True if the library is loaded and has plugins.
+  public: bool LoadLibrary(const std::string &_pathToLib)
+  {
+    if (this->loadedLibraries.find(_pathToLib) !=
+        this->loadedLibraries.end())
+    {
+      return true;
+    }
+
+    auto pluginNames = this->loader.LoadLib(_pathToLib);
+    if (pluginNames.empty() || pluginNames.begin()->empty())
+      return false;
+
+    this->loadedLibraries.insert(_pathToLib);
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  public: bool InstantiateSystemPlugin(const std::string &_filename,
+              const std::string &_name,
+              const sdf::ElementPtr &/*_sdf*/,
+              ignition::plugin::PluginPtr &_plugin)
+  {
+    auto pathToLib = this->FindLibrary(_filename);
     if (pathToLib.empty())
     {
       // We assume ignition::gazebo corresponds to the levels feature
@@ -69,17 +124,7 @@ class ignition::gazebo::SystemLoaderPrivate
       return false;
     }
 
-    auto pluginNames = this->loader.LoadLib(pathToLib);
-    if (pluginNames.empty())
-    {
-      ignerr << "Failed to load system plugin [" << _filename <<
-                "] : couldn't load library on path [" << pathToLib <<
-                "]." << std::endl;
-      return false;
-    }
-
-    auto pluginName = *pluginNames.begin();
-    if (pluginName.empty())
+    if (!this->LoadLibrary(pathToLib))
     {
       ignerr << "Failed to load system plugin [" << _filename <<
                 "] : couldn't load library on path [" << pathToLib <<
@@ -120,6 +165,22 @@ class ignition::gazebo::SystemLoaderPrivate
 
   /// \brief System plugins that have instances loaded via the manager.
   public: std::unordered_set<SystemPluginPtr> systemPluginsAdded;
+
+  /// \brief Paths of the libraries which have been found. Cleared when
+  /// search paths are added.
+  public: std::unordered_map<std::string, std::string> libraryPaths;
+
+  /// \brief Incremented whenever search paths are added, so searches which
+  /// ran with the previous paths aren't cached.
+  public: uint64_t searchPathsGeneration{0u};
+
+  /// \brief Paths of the libraries already loaded by the loader, so they're
+  /// only loaded once, no matter how many plugins are instantiated.
+  public: std::unordered_set<std::string> loadedLibraries;
+
+  /// \brief Protects the loader, paths and added plugins, since a loader
+  /// may be shared by worlds which are stepped in different threads.
+  public: mutable std::mutex mutex;
 };
 
 //////////////////////////////////////////////////
@@ -134,7 +195,81 @@ SystemLoader::~SystemLoader() = default;
 //////////////////////////////////////////////////
 void SystemLoader::AddSystemPluginPath(const std::string &_path)
 {
-  this->dataPtr->systemPluginPaths.insert(_path);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->systemPluginPaths.insert(_path).second)
+  {
+    this->dataPtr->libraryPaths.clear();
+    ++this->dataPtr->searchPathsGeneration;
+  }
+}
+
+//////////////////////////////////////////////////
+void SystemLoader::PreloadLibraries(const std::set<std::string> &_filenames)
+{
+  std::unordered_set<std::string> pluginPaths;
+  std::vector<std::string> filenames;
+  uint64_t generation{0u};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    pluginPaths = this->dataPtr->systemPluginPaths;
+    generation = this->dataPtr->searchPathsGeneration;
+    for (const auto &filename : _filenames)
+    {
+      if (!filename.empty() && this->dataPtr->libraryPaths.find(filename) ==
+          this->dataPtr->libraryPaths.end())
+      {
+        filenames.push_back(filename);
+      }
+    }
+  }
+
+  if (filenames.empty())
+    return;
+
+  // Searching goes through many directories for each library, so it's done
+  // in parallel
+  std::vector<std::string> paths(filenames.size());
+  std::atomic<std::size_t> next{0u};
+  auto search = [&]()
+  {
+    ignition::common::SystemPaths systemPaths;
+    this->dataPtr->SetSearchPaths(pluginPaths, systemPaths);
+    for (auto i = next++; i < filenames.size(); i = next++)
+      paths[i] = systemPaths.FindSharedLibrary(filenames[i]);
+  };
+
+  const auto threadCount = std::min<std::size_t>(filenames.size(),
+      std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1u; i < threadCount; ++i)
+    threads.emplace_back(search);
+  search();
+  for (auto &thread : threads)
+    thread.join();
+
+  // The plugin loader isn't thread safe, and the dynamic linker serializes
+  // loading anyway
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // If search paths were added in the meantime, the libraries may resolve
+  // to different paths. They'll be searched for again when loaded.
+  if (generation != this->dataPtr->searchPathsGeneration)
+  {
+    igndbg << "Plugin search paths changed while preloading libraries, "
+           << "skipping preload." << std::endl;
+    return;
+  }
+
+  for (std::size_t i = 0u; i < filenames.size(); ++i)
+  {
+    if (paths[i].empty())
+      continue;
+    this->dataPtr->libraryPaths[filenames[i]] = paths[i];
+    this->dataPtr->LoadLibrary(paths[i]);
+  }
+
+  igndbg << "Preloaded [" << filenames.size() << "] plugin libraries."
+         << std::endl;
 }
 
 //////////////////////////////////////////////////
@@ -153,6 +288,7 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
     return {};
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   auto ret = this->dataPtr->InstantiateSystemPlugin(_filename,
                                                     _name,
                                                     _sdf, plugin);
@@ -180,6 +316,7 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
 //////////////////////////////////////////////////
 std::string SystemLoader::PrettyStr() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->loader.PrettyStr();
 }
 
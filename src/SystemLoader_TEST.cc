@@ -58,6 +58,73 @@ TEST(SystemLoader, Constructor)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(SystemLoader, PreloadLibraries)
+{
+  gazebo::SystemLoader sm;
+
+  auto testBuildPath = ignition::common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "lib");
+  sm.AddSystemPluginPath(testBuildPath);
+
+  const std::string physics = std::string("libignition-gazebo") +
+      IGNITION_GAZEBO_MAJOR_VERSION_STR + "-physics-system.so";
+  const std::string sceneBroadcaster = std::string("libignition-gazebo") +
+      IGNITION_GAZEBO_MAJOR_VERSION_STR + "-scene-broadcaster-system.so";
+
+  // Missing libraries are skipped
+  sm.PreloadLibraries({physics, sceneBroadcaster, "libmissing.so"});
+
+  // Plugins are instantiated from the preloaded libraries, any number of
+  // times
+  for (int i = 0; i < 3; ++i)
+  {
+    auto system = sm.LoadPlugin(physics, "ignition::gazebo::systems::Physics",
+        nullptr);
+    EXPECT_TRUE(system.has_value());
+  }
+  auto system = sm.LoadPlugin(sceneBroadcaster,
+      "ignition::gazebo::systems::SceneBroadcaster", nullptr);
+  EXPECT_TRUE(system.has_value());
+
+  system = sm.LoadPlugin("libmissing.so", "missing", nullptr);
+  EXPECT_FALSE(system.has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(SystemLoader, MissingLibraryNotCached)
+{
+  const auto libDir = ignition::common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "test", "system_loader_lib");
+  ignition::common::removeAll(libDir);
+  ASSERT_TRUE(ignition::common::createDirectories(libDir));
+
+  gazebo::SystemLoader sm;
+  sm.AddSystemPluginPath(libDir);
+
+  // The library isn't there yet
+  const std::string filename{"libsystem-loader-test-physics.so"};
+  sm.PreloadLibraries({filename});
+  auto system = sm.LoadPlugin(filename,
+      "ignition::gazebo::systems::Physics", nullptr);
+  EXPECT_FALSE(system.has_value());
+
+  // Once the library is installed, it's found without adding search paths
+  const std::string physics = ignition::common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "lib",
+      std::string("libignition-gazebo") +
+      IGNITION_GAZEBO_MAJOR_VERSION_STR + "-physics-system.so");
+  ASSERT_TRUE(ignition::common::copyFile(physics,
+      ignition::common::joinPaths(libDir, filename)));
+
+  system = sm.LoadPlugin(filename, "ignition::gazebo::systems::Physics",
+      nullptr);
+  EXPECT_TRUE(system.has_value());
+
+  ignition::common::removeAll(libDir);
+}
+
+/////////////////////////////////////////////////
 TEST(SystemLoader, EmptyNames)
 {
   gazebo::SystemLoader sm;
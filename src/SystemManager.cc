@@ -15,6 +15,9 @@
  *
 */
 
+#include <chrono>
+#include <string>
+
 #include "SystemManager.hh"
 
 using namespace ignition;
@@ -45,7 +48,9 @@ void SystemManager::LoadPlugin(const Entity _entity,
   // System correctly loaded from library
   if (system)
   {
-    this->AddSystem(system.value(), _entity, _sdf);
+    SystemInternal systemInternal(system.value());
+    systemInternal.name = _name;
+    this->AddSystemImpl(systemInternal, _entity, _sdf);
     igndbg << "Loaded system [" << _name
            << "] for entity [" << _entity << "]" << std::endl;
   }
@@ -85,13 +90,26 @@ size_t SystemManager::ActivatePendingSystems()
       this->systemsConfigure.push_back(system.configure);
 
     if (system.preupdate)
+    {
       this->systemsPreupdate.push_back(system.preupdate);
+      this->timingsPreupdate.push_back(&system.timing->preUpdate);
+      this->wakeUpsPreupdate.push_back(system.wakeUp.get());
+    }
 
     if (system.update)
+    {
       this->systemsUpdate.push_back(system.update);
+      this->timingsUpdate.push_back(&system.timing->update);
+    }
 
     if (system.postupdate)
+    {
       this->systemsPostupdate.push_back(system.postupdate);
+      this->timingsPostupdate.push_back(&system.timing->postUpdate);
+    }
+
+    if (system.reset)
+      this->systemsReset.push_back(system.reset);
   }
 
   this->pendingSystems.clear();
@@ -129,8 +147,46 @@ void SystemManager::AddSystemImpl(
                                  *this->eventMgr);
   }
 
+  // Let the system declare when it needs PreUpdate
+  if (_system.wakeUpInterface && _system.preupdate)
+  {
+    _system.wakeUp = std::make_shared<SystemWakeUp>();
+    _system.wakeUpInterface->ConfigureWakeUp(_system.wakeUp);
+  }
+
+  // Run the system's update callbacks at a lower rate, if requested
+  if (_sdf && _sdf->HasElement("system_update_rate") &&
+      (_system.preupdate || _system.update || _system.postupdate))
+  {
+    auto rate = _sdf->Get<double>("system_update_rate");
+    if (rate > 0.0)
+    {
+      auto period = std::chrono::duration_cast<
+          std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / rate));
+      _system.throttle = std::make_shared<SystemThrottle>(
+          _system.preupdate, _system.update, _system.postupdate, period);
+      if (_system.preupdate)
+        _system.preupdate = _system.throttle.get();
+      if (_system.update)
+        _system.update = _system.throttle.get();
+      if (_system.postupdate)
+        _system.postupdate = _system.throttle.get();
+    }
+    else
+    {
+      ignerr << "<system_update_rate> must be positive, got [" << rate
+             << "]. System will be updated on every iteration." << std::endl;
+    }
+  }
+
   // Update callbacks will be handled later, add to queue
   std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+  if (_system.name.empty())
+  {
+    _system.name = "system_" +
+        std::to_string(this->systems.size() + this->pendingSystems.size());
+  }
   this->pendingSystems.push_back(_system);
 }
 
@@ -157,3 +213,55 @@ const std::vector<ISystemPostUpdate *>& SystemManager::SystemsPostUpdate()
 {
   return this->systemsPostupdate;
 }
+
+//////////////////////////////////////////////////
+const std::vector<ISystemReset *>& SystemManager::SystemsReset()
+{
+  return this->systemsReset;
+}
+
+//////////////////////////////////////////////////
+void SystemManager::Reset(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("SystemManager::Reset");
+  for (auto *system : this->systemsReset)
+    system->Reset(_info, _ecm);
+}
+
+//////////////////////////////////////////////////
+const std::vector<SystemTimingStats *> &SystemManager::TimingsPreUpdate()
+{
+  return this->timingsPreupdate;
+}
+
+//////////////////////////////////////////////////
+const std::vector<SystemWakeUp *> &SystemManager::WakeUpsPreUpdate()
+{
+  return this->wakeUpsPreupdate;
+}
+
+//////////////////////////////////////////////////
+const std::vector<SystemTimingStats *> &SystemManager::TimingsUpdate()
+{
+  return this->timingsUpdate;
+}
+
+//////////////////////////////////////////////////
+const std::vector<SystemTimingStats *> &SystemManager::TimingsPostUpdate()
+{
+  return this->timingsPostupdate;
+}
+
+//////////////////////////////////////////////////
+const std::vector<SystemInternal> &SystemManager::Systems() const
+{
+  return this->systems;
+}
+
+//////////////////////////////////////////////////
+void SystemManager::ResetTimings()
+{
+  for (auto &system : this->systems)
+    system.timing->Reset();
+}
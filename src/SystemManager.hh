@@ -60,7 +60,9 @@ namespace ignition
                               const std::string &_name,
                               const sdf::ElementPtr &_sdf);
 
-      /// \brief Add a system to the manager
+      /// \brief Add a system to the manager. If the SDF has a
+      /// `<system_update_rate>` element, the system's update callbacks are
+      /// called at most at that rate in Hz of sim time.
       /// \param[in] _system SystemPluginPtr to be added
       /// \param[in] _entity Entity that system is attached to.
       /// \param[in] _sdf Pointer to the SDF of the entity.
@@ -68,7 +70,9 @@ namespace ignition
                              Entity _entity,
                              std::shared_ptr<const sdf::Element> _sdf);
 
-      /// \brief Add a system to the manager
+      /// \brief Add a system to the manager. If the SDF has a
+      /// `<system_update_rate>` element, the system's update callbacks are
+      /// called at most at that rate in Hz of sim time.
       /// \param[in] _system SystemPluginPtr to be added
       /// \param[in] _entity Entity that system is attached to.
       /// \param[in] _sdf Pointer to the SDF of the entity.
@@ -104,6 +108,45 @@ namespace ignition
       /// \brief Get an vector of all systems implementing "PostUpdate"
       public: const std::vector<ISystemPostUpdate *>& SystemsPostUpdate();
 
+      /// \brief Get an vector of all systems implementing "Reset"
+      public: const std::vector<ISystemReset *>& SystemsReset();
+
+      /// \brief Reset all systems implementing "Reset", after the world was
+      /// reset.
+      /// \param[in] _info Update info of the iteration following the reset.
+      /// \param[in] _ecm Entity component manager.
+      public: void Reset(const UpdateInfo &_info,
+                  EntityComponentManager &_ecm);
+
+      /// \brief Get the timing of each system implementing "PreUpdate", in
+      /// the same order as SystemsPreUpdate.
+      /// \return Timing of each system.
+      public: const std::vector<SystemTimingStats *> &TimingsPreUpdate();
+
+      /// \brief Get the wake-up conditions of each system implementing
+      /// "PreUpdate", in the same order as SystemsPreUpdate. Null for
+      /// systems which are updated on every iteration.
+      /// \return Wake-up conditions of each system.
+      public: const std::vector<SystemWakeUp *> &WakeUpsPreUpdate();
+
+      /// \brief Get the timing of each system implementing "Update", in the
+      /// same order as SystemsUpdate.
+      /// \return Timing of each system.
+      public: const std::vector<SystemTimingStats *> &TimingsUpdate();
+
+      /// \brief Get the timing of each system implementing "PostUpdate", in
+      /// the same order as SystemsPostUpdate.
+      /// \return Timing of each system.
+      public: const std::vector<SystemTimingStats *> &TimingsPostUpdate();
+
+      /// \brief Get all the active systems, for example to report their
+      /// timing.
+      /// \return Active systems.
+      public: const std::vector<SystemInternal> &Systems() const;
+
+      /// \brief Remove the timing samples of all active systems.
+      public: void ResetTimings();
+
       /// \brief Implementation for AddSystem functions. This only adds systems
       /// to a queue, the actual addition is performed by `AddSystemToRunner` at
       /// the appropriate time.
@@ -135,6 +178,21 @@ namespace ignition
       /// \brief Systems implementing PostUpdate
       private: std::vector<ISystemPostUpdate *> systemsPostupdate;
 
+      /// \brief Systems implementing Reset
+      private: std::vector<ISystemReset *> systemsReset;
+
+      /// \brief Timing of systems implementing PreUpdate
+      private: std::vector<SystemTimingStats *> timingsPreupdate;
+
+      /// \brief Wake-up conditions of systems implementing PreUpdate
+      private: std::vector<SystemWakeUp *> wakeUpsPreupdate;
+
+      /// \brief Timing of systems implementing Update
+      private: std::vector<SystemTimingStats *> timingsUpdate;
+
+      /// \brief Timing of systems implementing PostUpdate
+      private: std::vector<SystemTimingStats *> timingsPostupdate;
+
       /// \brief System loader, for loading system plugins.
       private: SystemLoaderPtr systemLoader;
 
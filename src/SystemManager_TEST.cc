@@ -17,10 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/EventManager.hh"
 #include "ignition/gazebo/System.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/Types.hh"
+#include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
 
 #include "SystemManager.hh"
@@ -51,15 +55,27 @@ class SystemWithUpdates:
 {
   // Documentation inherited
   public: void PreUpdate(const UpdateInfo &,
-                EntityComponentManager &) override {};
+                EntityComponentManager &) override { preUpdates++; };
 
   // Documentation inherited
-  public: void Update(const UpdateInfo &,
-                EntityComponentManager &) override {};
+  public: void Update(const UpdateInfo &_info,
+                EntityComponentManager &) override
+                {
+                  updates++;
+                  lastDt = _info.dt;
+                }
 
   // Documentation inherited
   public: void PostUpdate(const UpdateInfo &,
-                const EntityComponentManager &) override {};
+                const EntityComponentManager &) override { postUpdates++; };
+
+  public: int preUpdates = 0;
+
+  public: int updates = 0;
+
+  public: int postUpdates = 0;
+
+  public: std::chrono::steady_clock::duration lastDt{0};
 };
 
 /////////////////////////////////////////////////
@@ -196,3 +212,217 @@ TEST(SystemManager, AddSystemEcm)
   EXPECT_EQ(1u, systemMgr.SystemsPostUpdate().size());
 }
 
+/////////////////////////////////////////////////
+TEST(SystemManager, SystemUpdateRate)
+{
+  auto loader = std::make_shared<SystemLoader>();
+  SystemManager systemMgr(loader);
+
+  auto rateElem = std::make_shared<sdf::Element>();
+  rateElem->SetName("system_update_rate");
+  rateElem->AddValue("double", "0", true);
+  rateElem->Set<double>(250.0);
+
+  auto pluginElem = std::make_shared<sdf::Element>();
+  pluginElem->SetName("plugin");
+  pluginElem->InsertElement(rateElem);
+
+  auto updateSystem = std::make_shared<SystemWithUpdates>();
+  systemMgr.AddSystem(updateSystem, kNullEntity, pluginElem);
+  systemMgr.ActivatePendingSystems();
+  ASSERT_EQ(1u, systemMgr.SystemsPreUpdate().size());
+  ASSERT_EQ(1u, systemMgr.SystemsUpdate().size());
+  ASSERT_EQ(1u, systemMgr.SystemsPostUpdate().size());
+
+  // Step at 1 kHz, the system is updated every 4 steps
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = std::chrono::milliseconds(1);
+  for (int i = 0; i < 8; ++i)
+  {
+    info.simTime += info.dt;
+    ++info.iterations;
+    systemMgr.SystemsPreUpdate()[0]->PreUpdate(info, ecm);
+    systemMgr.SystemsUpdate()[0]->Update(info, ecm);
+    systemMgr.SystemsPostUpdate()[0]->PostUpdate(info, ecm);
+  }
+  EXPECT_EQ(2, updateSystem->preUpdates);
+  EXPECT_EQ(2, updateSystem->updates);
+  EXPECT_EQ(2, updateSystem->postUpdates);
+
+  // dt covers the skipped steps
+  EXPECT_EQ(std::chrono::milliseconds(4), updateSystem->lastDt);
+
+  // Systems are always updated while paused
+  info.paused = true;
+  info.dt = std::chrono::steady_clock::duration::zero();
+  systemMgr.SystemsUpdate()[0]->Update(info, ecm);
+  EXPECT_EQ(3, updateSystem->updates);
+}
+
+/////////////////////////////////////////////////
+class SystemWithWakeUp:
+  public System,
+  public ISystemPreUpdate,
+  public ISystemWakeUp
+{
+  // Documentation inherited
+  public: void ConfigureWakeUp(
+                const std::shared_ptr<SystemWakeUp> &_wakeUp) override
+                {
+                  wakeUp = _wakeUp;
+                  wakeUp->WakeOnComponentChange(
+                      components::Name::typeId);
+                  wakeUp->WakeEvery(std::chrono::milliseconds(10));
+                };
+
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &_info,
+                EntityComponentManager &_ecm) override
+                {
+                  preUpdates++;
+                  lastDt = _info.dt;
+                  if (createName)
+                  {
+                    _ecm.CreateComponent(_ecm.CreateEntity(),
+                        components::Name("own"));
+                  }
+                };
+
+  public: std::shared_ptr<SystemWakeUp> wakeUp;
+
+  public: int preUpdates = 0;
+
+  public: bool createName = false;
+
+  public: std::chrono::steady_clock::duration lastDt{0};
+};
+
+/////////////////////////////////////////////////
+TEST(SystemManager, SystemWakeUp)
+{
+  auto loader = std::make_shared<SystemLoader>();
+  SystemManager systemMgr(loader);
+
+  auto system = std::make_shared<SystemWithWakeUp>();
+  auto updateSystem = std::make_shared<SystemWithUpdates>();
+  systemMgr.AddSystem(system, kNullEntity, nullptr);
+  systemMgr.AddSystem(updateSystem, kNullEntity, nullptr);
+  systemMgr.ActivatePendingSystems();
+  ASSERT_NE(nullptr, system->wakeUp);
+  ASSERT_EQ(2u, systemMgr.WakeUpsPreUpdate().size());
+  EXPECT_EQ(system->wakeUp.get(), systemMgr.WakeUpsPreUpdate()[0]);
+  EXPECT_EQ(nullptr, systemMgr.WakeUpsPreUpdate()[1]);
+
+  EntityComponentManager ecm;
+  UpdateInfo info;
+  info.paused = false;
+  info.dt = std::chrono::milliseconds(1);
+  auto step = [&](const std::function<void()> &_afterPreUpdate = nullptr)
+  {
+    info.simTime += info.dt;
+    ++info.iterations;
+    UpdateInfo wakeInfo;
+    auto *wakeUp = systemMgr.WakeUpsPreUpdate()[0];
+    if (wakeUp->Due(info, ecm, wakeInfo))
+    {
+      systemMgr.SystemsPreUpdate()[0]->PreUpdate(wakeInfo, ecm);
+      wakeUp->Updated(ecm);
+    }
+    if (_afterPreUpdate)
+      _afterPreUpdate();
+    ecm.SetAllComponentsUnchanged();
+  };
+
+  // Called on the first iteration, then idle until the timer fires
+  step();
+  EXPECT_EQ(1, system->preUpdates);
+  for (int i = 0; i < 9; ++i)
+    step();
+  EXPECT_EQ(1, system->preUpdates);
+  step();
+  EXPECT_EQ(2, system->preUpdates);
+
+  // dt covers the skipped iterations
+  EXPECT_EQ(std::chrono::milliseconds(10), system->lastDt);
+
+  // Woken explicitly, for example from a transport callback
+  system->wakeUp->Wake();
+  step();
+  EXPECT_EQ(3, system->preUpdates);
+  step();
+  EXPECT_EQ(3, system->preUpdates);
+
+  // One-shot timer
+  system->wakeUp->WakeAt(info.simTime + std::chrono::milliseconds(2));
+  step();
+  EXPECT_EQ(3, system->preUpdates);
+  step();
+  EXPECT_EQ(4, system->preUpdates);
+
+  // Component changes made after the system's PreUpdate wake it up on the
+  // next iteration
+  auto entity = ecm.CreateEntity();
+  ecm.CreateComponent(entity, components::Name("name"));
+  ecm.SetAllComponentsUnchanged();
+  step();
+  EXPECT_EQ(5, system->preUpdates);
+  step();
+  EXPECT_EQ(5, system->preUpdates);
+
+  // Changes made before the system's PreUpdate, on the same iteration, wake
+  // it up only once
+  ecm.CreateComponent(ecm.CreateEntity(), components::Name("other"));
+  step();
+  EXPECT_EQ(6, system->preUpdates);
+  step();
+  EXPECT_EQ(6, system->preUpdates);
+
+  // Sim time jumping back wakes the system up and restarts the periodic
+  // timer, while one-shot timers are kept at the same sim time
+  const auto wakeTime = info.simTime + std::chrono::milliseconds(5);
+  system->wakeUp->WakeAt(wakeTime);
+  step();
+  EXPECT_EQ(6, system->preUpdates);
+
+  info.simTime = std::chrono::steady_clock::duration::zero();
+  step();
+  EXPECT_EQ(7, system->preUpdates);
+
+  int expected = 7;
+  while (info.simTime < wakeTime)
+  {
+    step();
+    if (info.simTime == std::chrono::milliseconds(11) ||
+        info.simTime == std::chrono::milliseconds(21) ||
+        info.simTime == wakeTime)
+    {
+      ++expected;
+    }
+    EXPECT_EQ(expected, system->preUpdates);
+  }
+  EXPECT_EQ(10, system->preUpdates);
+
+  // Changes made later on the same iteration as changes which woke the
+  // system up, for example by Update or PostUpdate, wake it up again
+  ecm.CreateComponent(ecm.CreateEntity(), components::Name("before"));
+  step([&]()
+  {
+    ecm.CreateComponent(ecm.CreateEntity(), components::Name("late"));
+  });
+  EXPECT_EQ(11, system->preUpdates);
+  step();
+  EXPECT_EQ(12, system->preUpdates);
+  step();
+  EXPECT_EQ(12, system->preUpdates);
+
+  // Changes made by the system itself don't wake it up
+  system->createName = true;
+  system->wakeUp->Wake();
+  step();
+  EXPECT_EQ(13, system->preUpdates);
+  system->createName = false;
+  step();
+  EXPECT_EQ(13, system->preUpdates);
+}
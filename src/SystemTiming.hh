@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMTIMING_HH_
+#define IGNITION_GAZEBO_SYSTEMTIMING_HH_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+
+    /// \brief Histogram of the wall time taken by calls to a function, such as
+    /// one of the update callbacks of a system. It's cheap enough to be
+    /// always on: adding a sample only increments a few counters.
+    ///
+    /// Bucket 0 counts calls shorter than 1 microsecond, bucket i counts calls
+    /// shorter than 2^i microseconds and at least 2^(i-1) microseconds, and the
+    /// last bucket counts all longer calls.
+    class SystemTimingStats
+    {
+      /// \brief Number of histogram buckets.
+      public: static constexpr std::size_t kBucketCount{20u};
+
+      /// \brief Add a sample.
+      /// \param[in] _duration Wall time taken by a call.
+      public: void Add(const std::chrono::steady_clock::duration &_duration)
+      {
+        ++this->count;
+        this->total += _duration;
+        if (_duration > this->max)
+          this->max = _duration;
+
+        auto us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+            _duration).count());
+        std::size_t bucket{0u};
+        while (us > 0u && bucket < kBucketCount - 1u)
+        {
+          us >>= 1u;
+          ++bucket;
+        }
+        ++this->buckets[bucket];
+      }
+
+      /// \brief Remove all samples.
+      public: void Reset()
+      {
+        *this = SystemTimingStats();
+      }
+
+      /// \brief Mean duration of the calls.
+      /// \return Mean duration, zero if there are no samples.
+      public: std::chrono::steady_clock::duration Mean() const
+      {
+        if (0u == this->count)
+          return std::chrono::steady_clock::duration::zero();
+        return this->total / this->count;
+      }
+
+      /// \brief Number of calls.
+      public: uint64_t count{0u};
+
+      /// \brief Total wall time of all calls.
+      public: std::chrono::steady_clock::duration total{0};
+
+      /// \brief Longest call.
+      public: std::chrono::steady_clock::duration max{0};
+
+      /// \brief Number of calls in each bucket.
+      public: std::array<uint64_t, kBucketCount> buckets{};
+    };
+
+    /// \brief Timing of all the update callbacks of a system.
+    class SystemTiming
+    {
+      /// \brief Remove all samples.
+      public: void Reset()
+      {
+        this->preUpdate.Reset();
+        this->update.Reset();
+        this->postUpdate.Reset();
+      }
+
+      /// \brief Timing of PreUpdate calls.
+      public: SystemTimingStats preUpdate;
+
+      /// \brief Timing of Update calls.
+      public: SystemTimingStats update;
+
+      /// \brief Timing of PostUpdate calls.
+      public: SystemTimingStats postUpdate;
+    };
+    }
+  }  // namespace gazebo
+}  // namespace ignition
+#endif  // IGNITION_GAZEBO_SYSTEMTIMING_HH_
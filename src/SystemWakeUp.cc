@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/SystemWakeUp.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <vector>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Private data for SystemWakeUp
+class ignition::gazebo::SystemWakeUpPrivate
+{
+  /// \brief Set by Wake, possibly from other threads.
+  public: std::atomic<bool> woken{false};
+
+  /// \brief Watched component types.
+  public: std::vector<ComponentTypeId> componentTypes;
+
+  /// \brief Change count of each watched component type which was already
+  /// seen by the system, in the same order as componentTypes.
+  public: std::vector<uint64_t> changeCounts;
+
+  /// \brief One-shot timers, earliest first.
+  public: std::priority_queue<std::chrono::steady_clock::duration,
+          std::vector<std::chrono::steady_clock::duration>,
+          std::greater<std::chrono::steady_clock::duration>> timers;
+
+  /// \brief Period of the periodic timer, zero if disabled.
+  public: std::chrono::steady_clock::duration period{0};
+
+  /// \brief Next sim time at which the periodic timer fires.
+  public: std::optional<std::chrono::steady_clock::duration> nextPeriodic;
+
+  /// \brief Sim time of the last PreUpdate call, unset before the first.
+  public: std::optional<std::chrono::steady_clock::duration> lastCall;
+
+  /// \brief Sim time of the last checked iteration.
+  public: std::chrono::steady_clock::duration lastSimTime{0};
+};
+
+//////////////////////////////////////////////////
+SystemWakeUp::SystemWakeUp()
+  : dataPtr(std::make_unique<SystemWakeUpPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+SystemWakeUp::~SystemWakeUp() = default;
+
+//////////////////////////////////////////////////
+void SystemWakeUp::Wake()
+{
+  this->dataPtr->woken = true;
+}
+
+//////////////////////////////////////////////////
+void SystemWakeUp::WakeOnComponentChange(const ComponentTypeId _typeId)
+{
+  auto &types = this->dataPtr->componentTypes;
+  if (std::find(types.begin(), types.end(), _typeId) == types.end())
+  {
+    types.push_back(_typeId);
+    this->dataPtr->changeCounts.push_back(0u);
+  }
+}
+
+//////////////////////////////////////////////////
+void SystemWakeUp::WakeAt(const std::chrono::steady_clock::duration &_simTime)
+{
+  this->dataPtr->timers.push(_simTime);
+}
+
+//////////////////////////////////////////////////
+void SystemWakeUp::WakeEvery(
+    const std::chrono::steady_clock::duration &_period)
+{
+  this->dataPtr->period = std::max(_period,
+      std::chrono::steady_clock::duration::zero());
+  this->dataPtr->nextPeriodic.reset();
+}
+
+//////////////////////////////////////////////////
+bool SystemWakeUp::Due(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm, UpdateInfo &_wakeInfo)
+{
+  auto &data = *this->dataPtr;
+
+  // Always consume the flag, so a wake-up isn't carried over to a later
+  // iteration which was going to call PreUpdate anyway
+  bool due = data.woken.exchange(false);
+
+  // First call, or sim time jumped back. One-shot timers which didn't fire
+  // yet are kept at the same sim time, the periodic timer restarts.
+  if (!data.lastCall || _info.simTime < data.lastSimTime)
+  {
+    due = true;
+    data.lastCall.reset();
+    data.nextPeriodic.reset();
+  }
+  data.lastSimTime = _info.simTime;
+
+  while (!data.timers.empty() && data.timers.top() <= _info.simTime)
+  {
+    due = true;
+    data.timers.pop();
+  }
+
+  // Timers set before the first iteration, or from PreUpdate, start from
+  // the sim time of the iteration which sees them
+  if (data.period > std::chrono::steady_clock::duration::zero())
+  {
+    if (!data.nextPeriodic)
+    {
+      data.nextPeriodic = _info.simTime + data.period;
+    }
+    else if (_info.simTime >= *data.nextPeriodic)
+    {
+      due = true;
+      *data.nextPeriodic += data.period;
+      // Don't try to catch up after a long pause in the schedule
+      if (*data.nextPeriodic <= _info.simTime)
+        data.nextPeriodic = _info.simTime + data.period;
+    }
+  }
+
+  // Changes made since the system's previous PreUpdate, by systems which ran
+  // after it on a previous iteration or before it on this one. Change
+  // counts only grow, so nothing is lost when changes are cleared at the
+  // end of an iteration.
+  for (std::size_t i = 0; i < data.componentTypes.size(); ++i)
+  {
+    const auto count = _ecm.ComponentChangeCount(data.componentTypes[i]);
+    if (count != data.changeCounts[i])
+    {
+      due = true;
+      data.changeCounts[i] = count;
+    }
+  }
+
+  if (!due)
+    return false;
+
+  _wakeInfo = _info;
+  if (data.lastCall && _info.simTime >= *data.lastCall)
+    _wakeInfo.dt = _info.simTime - *data.lastCall;
+  data.lastCall = _info.simTime;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SystemWakeUp::Updated(const EntityComponentManager &_ecm)
+{
+  auto &data = *this->dataPtr;
+  for (std::size_t i = 0; i < data.componentTypes.size(); ++i)
+    data.changeCounts[i] = _ecm.ComponentChangeCount(data.componentTypes[i]);
+}
@@ -46,6 +46,11 @@ namespace ignition
       // cppcheck-suppress unusedStructMember
       bool rewind{false};  // NOLINT
 
+      /// \brief Reset all entities, components and systems to their state
+      /// right after the world was loaded. This also rewinds.
+      // cppcheck-suppress unusedStructMember
+      bool reset{false};  // NOLINT
+
       /// \brief A simulation time in the future to run to and then pause.
       /// A negative number indicates that this variable it not being used.
       std::chrono::steady_clock::duration runToSimTime{-1};  // NOLINT
@@ -69,6 +69,7 @@
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/gui/GuiEvents.hh"
+#include "ignition/gazebo/rendering/PipelinedVideoEncoder.hh"
 #include "ignition/gazebo/rendering/RenderUtil.hh"
 
 /// \brief condition variable for lockstepping video recording
@@ -185,11 +186,16 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Video recorder bitrate (bps)
     public: unsigned int recordVideoBitrate = 2070000;
 
+    /// \brief Encode video frames in a separate thread, so rendering the
+    /// next frame overlaps with encoding the current one.
+    public: bool recordVideoPipelined = false;
+
     /// \brief Previous camera update time during video recording
     /// only used in lockstep mode and recording in sim time.
     public: std::chrono::steady_clock::time_point recordVideoUpdateTime;
 
-    /// \brief Start time of video recording
+    /// \brief Start time of video recording. Only accessed from the render
+    /// thread.
     public: std::chrono::steady_clock::time_point recordStartTime;
 
     /// \brief Video recording statistics publisher
@@ -201,6 +207,10 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Video encoder
     public: common::VideoEncoder videoEncoder;
 
+    /// \brief Feeds frames to the video encoder from a separate thread. Only
+    /// used in pipelined mode.
+    public: std::unique_ptr<PipelinedVideoEncoder> pipelinedEncoder;
+
     // --------------------------------------------------------------
     // CameraTracking
 
@@ -646,7 +656,27 @@ IgnRenderer::IgnRenderer()
 
 
 /////////////////////////////////////////////////
-IgnRenderer::~IgnRenderer() = default;
+IgnRenderer::~IgnRenderer()
+{
+  // The encoding thread publishes stats using other members, stop it before
+  // they're destroyed
+  this->dataPtr->pipelinedEncoder.reset();
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::PublishRecorderStats(
+    const std::chrono::steady_clock::time_point &_t,
+    const std::chrono::steady_clock::time_point &_startTime)
+{
+  std::chrono::steady_clock::duration dt;
+  dt = _t - _startTime;
+  int64_t sec, nsec;
+  std::tie(sec, nsec) = ignition::math::durationToSecNsec(dt);
+  msgs::Time msg;
+  msg.set_sec(sec);
+  msg.set_nsec(nsec);
+  this->dataPtr->recorderStatsPub.Publish(msg);
+}
 
 ////////////////////////////////////////////////
 RenderUtil *IgnRenderer::RenderUtil() const
@@ -777,28 +807,25 @@ void IgnRenderer::Render(RenderSync *_renderSync)
           t = std::chrono::steady_clock::time_point(
               this->dataPtr->renderUtil.SimTime());
         }
-        bool frameAdded = this->dataPtr->videoEncoder.AddFrame(
-            this->dataPtr->cameraImage.Data<unsigned char>(), width, height, t);
-
-        if (frameAdded)
+        if (this->dataPtr->recordStartTime ==
+            std::chrono::steady_clock::time_point(
+            std::chrono::duration(std::chrono::seconds(0))))
         {
-          // publish recorder stats
-          if (this->dataPtr->recordStartTime ==
-              std::chrono::steady_clock::time_point(
-              std::chrono::duration(std::chrono::seconds(0))))
-          {
-            // start time, i.e. time when first frame is added
-            this->dataPtr->recordStartTime = t;
-          }
-
-          std::chrono::steady_clock::duration dt;
-          dt = t - this->dataPtr->recordStartTime;
-          int64_t sec, nsec;
-          std::tie(sec, nsec) = ignition::math::durationToSecNsec(dt);
-          msgs::Time msg;
-          msg.set_sec(sec);
-          msg.set_nsec(nsec);
-          this->dataPtr->recorderStatsPub.Publish(msg);
+          // start time, i.e. time when first frame is added
+          this->dataPtr->recordStartTime = t;
+        }
+        if (this->dataPtr->pipelinedEncoder)
+        {
+          // Stats are published from the encoding thread, which gets the
+          // start time along with the frame
+          this->dataPtr->pipelinedEncoder->AddFrame(
+              this->dataPtr->cameraImage.Data<unsigned char>(), width, height,
+              t, this->dataPtr->recordStartTime);
+        }
+        else if (this->dataPtr->videoEncoder.AddFrame(
+            this->dataPtr->cameraImage.Data<unsigned char>(), width, height, t))
+        {
+          this->PublishRecorderStats(t, this->dataPtr->recordStartTime);
         }
       }
       // Video recorder is idle. Start recording.
@@ -822,10 +849,27 @@ void IgnRenderer::Render(RenderSync *_renderSync)
             this->dataPtr->recordVideoBitrate);
         this->dataPtr->recordStartTime = std::chrono::steady_clock::time_point(
             std::chrono::duration(std::chrono::seconds(0)));
+
+        if (this->dataPtr->recordVideoPipelined)
+        {
+          ignmsg << "Encoding video in a separate thread." << std::endl;
+          this->dataPtr->pipelinedEncoder =
+              std::make_unique<PipelinedVideoEncoder>(
+              this->dataPtr->videoEncoder);
+          this->dataPtr->pipelinedEncoder->SetFrameAddedCallback(
+              [this](const std::chrono::steady_clock::time_point &_t,
+                  const std::chrono::steady_clock::time_point &_startTime)
+              {
+                this->PublishRecorderStats(_t, _startTime);
+              });
+          this->dataPtr->pipelinedEncoder->Start();
+        }
       }
     }
     else if (this->dataPtr->videoEncoder.IsEncoding())
     {
+      // Encode pending frames before finalizing the video
+      this->dataPtr->pipelinedEncoder.reset();
       this->dataPtr->videoEncoder.Stop();
     }
   }
@@ -2342,6 +2386,13 @@ void IgnRenderer::SetRecordVideoBitrate(unsigned int _bitrate)
   this->dataPtr->recordVideoBitrate = _bitrate;
 }
 
+/////////////////////////////////////////////////
+void IgnRenderer::SetRecordVideoPipelined(bool _pipelined)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->recordVideoPipelined = _pipelined;
+}
+
 /////////////////////////////////////////////////
 void IgnRenderer::SetMoveTo(const std::string &_target)
 {
@@ -3112,6 +3163,20 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         else
         {
           renderWindow->SetRecordVideoLockstep(lockstep);
+          this->dataPtr->recordVideoLockstep = lockstep;
+        }
+      }
+      if (auto pipelinedElem = elem->FirstChildElement("pipelined"))
+      {
+        bool pipelined = false;
+        if (pipelinedElem->QueryBoolText(&pipelined) != tinyxml2::XML_SUCCESS)
+        {
+          ignerr << "Failed to parse <pipelined> value: "
+                 << pipelinedElem->GetText() << std::endl;
+        }
+        else
+        {
+          renderWindow->SetRecordVideoPipelined(pipelined);
         }
       }
       if (auto bitrateElem = elem->FirstChildElement("bitrate"))
@@ -3960,6 +4025,13 @@ void RenderWindowItem::SetRecordVideoBitrate(unsigned int _bitrate)
       _bitrate);
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRecordVideoPipelined(bool _pipelined)
+{
+  this->dataPtr->renderThread->ignRenderer.SetRecordVideoPipelined(
+      _pipelined);
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetVisibilityMask(uint32_t _mask)
 {
@@ -24,6 +24,7 @@
 #include <ignition/msgs/vector3d.pb.h>
 #include <ignition/msgs/video_record.pb.h>
 
+#include <chrono>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -336,6 +337,10 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _bitrate Bit rate to set to
     public: void SetRecordVideoBitrate(unsigned int _bitrate);
 
+    /// \brief Set whether to encode video in a separate thread
+    /// \param[in] _pipelined True to encode video in a separate thread
+    public: void SetRecordVideoPipelined(bool _pipelined);
+
     /// \brief Move the user camera to move to the speficied target
     /// \param[in] _target Target to move the camera to
     public: void SetMoveTo(const std::string &_target);
@@ -506,6 +511,14 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Handle entity selection requests
     private: void HandleEntitySelection();
 
+    /// \brief Publish video recorder stats for a frame that has been added
+    /// to the video.
+    /// \param[in] _t Timestamp of the frame.
+    /// \param[in] _startTime Timestamp of the first frame of the video.
+    private: void PublishRecorderStats(
+        const std::chrono::steady_clock::time_point &_t,
+        const std::chrono::steady_clock::time_point &_startTime);
+
     /// \brief Handle model placement requests
     private: void HandleModelPlacement();
 
@@ -718,6 +731,10 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _bitrate Bit rate to set to
     public: void SetRecordVideoBitrate(unsigned int _bitrate);
 
+    /// \brief Set whether to encode video in a separate thread
+    /// \param[in] _pipelined True to encode video in a separate thread
+    public: void SetRecordVideoPipelined(bool _pipelined);
+
     /// \brief Move the user camera to move to the specified target
     /// \param[in] _target Target to move the camera to
     public: void SetMoveTo(const std::string &_target);
@@ -21,6 +21,7 @@
 #include <ignition/msgs/video_record.pb.h>
 
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include <ignition/common/Console.hh>
@@ -37,6 +38,8 @@
 #include <ignition/transport/Node.hh>
 #include <ignition/transport/Publisher.hh>
 
+#include "ignition/gazebo/rendering/PipelinedVideoEncoder.hh"
+
 /// \brief condition variable for lockstepping video recording
 /// todo(anyone) avoid using a global condition variable when we support
 /// multiple viewports in the future.
@@ -52,6 +55,12 @@ namespace ignition::gazebo
     /// \brief Initialize rendering and transport.
     public: void Initialize();
 
+    /// \brief Publish recorder stats for a frame added to the video.
+    /// \param[in] _t Timestamp of the frame.
+    /// \param[in] _startTime Timestamp of the first frame of the video.
+    public: void PublishStats(const std::chrono::steady_clock::time_point &_t,
+        const std::chrono::steady_clock::time_point &_startTime);
+
     /// \brief Ignition communication node.
     public: transport::Node node;
 
@@ -64,6 +73,10 @@ namespace ignition::gazebo
     /// \brief Video encoder
     public: common::VideoEncoder videoEncoder;
 
+    /// \brief Feeds frames to the video encoder from a separate thread. Only
+    /// used in pipelined mode.
+    public: std::unique_ptr<PipelinedVideoEncoder> pipelinedEncoder;
+
     /// \brief Image from user camera
     public: rendering::Image cameraImage;
 
@@ -83,7 +96,12 @@ namespace ignition::gazebo
     /// \brief Video recorder bitrate (bps)
     public: unsigned int bitrate = 2070000;
 
-    /// \brief Start tiem of video recording
+    /// \brief Encode video frames in a separate thread, so rendering the
+    /// next frame overlaps with encoding the current one.
+    public: bool pipelined = false;
+
+    /// \brief Start time of video recording. Only accessed from the render
+    /// thread.
     public: std::chrono::steady_clock::time_point startTime;
 
     /// \brief Camera pose publisher
@@ -167,6 +185,21 @@ void VideoRecorderPrivate::Initialize()
          << this->recorderStatsTopic << "]" << std::endl;
 }
 
+/////////////////////////////////////////////////
+void VideoRecorderPrivate::PublishStats(
+    const std::chrono::steady_clock::time_point &_t,
+    const std::chrono::steady_clock::time_point &_startTime)
+{
+  std::chrono::steady_clock::duration dt;
+  dt = _t - _startTime;
+  int64_t sec, nsec;
+  std::tie(sec, nsec) = ignition::math::durationToSecNsec(dt);
+  msgs::Time msg;
+  msg.set_sec(sec);
+  msg.set_nsec(nsec);
+  this->recorderStatsPub.Publish(msg);
+}
+
 /////////////////////////////////////////////////
 void VideoRecorderPrivate::OnRender()
 {
@@ -202,28 +235,25 @@ void VideoRecorderPrivate::OnRender()
           t = std::chrono::steady_clock::time_point(
               this->simTime);
         }
-        bool frameAdded = this->videoEncoder.AddFrame(
-            this->cameraImage.Data<unsigned char>(), width, height, t);
-
-        if (frameAdded)
+        if (this->startTime ==
+            std::chrono::steady_clock::time_point(
+            std::chrono::duration(std::chrono::seconds(0))))
         {
-          // publish recorder stats
-          if (this->startTime ==
-              std::chrono::steady_clock::time_point(
-              std::chrono::duration(std::chrono::seconds(0))))
-          {
-            // start time, i.e. time when first frame is added
-            this->startTime = t;
-          }
-
-          std::chrono::steady_clock::duration dt;
-          dt = t - this->startTime;
-          int64_t sec, nsec;
-          std::tie(sec, nsec) = ignition::math::durationToSecNsec(dt);
-          msgs::Time msg;
-          msg.set_sec(sec);
-          msg.set_nsec(nsec);
-          this->recorderStatsPub.Publish(msg);
+          // start time, i.e. time when first frame is added
+          this->startTime = t;
+        }
+        if (this->pipelinedEncoder)
+        {
+          // Stats are published from the encoding thread, which gets the
+          // start time along with the frame
+          this->pipelinedEncoder->AddFrame(
+              this->cameraImage.Data<unsigned char>(), width, height, t,
+              this->startTime);
+        }
+        else if (this->videoEncoder.AddFrame(
+            this->cameraImage.Data<unsigned char>(), width, height, t))
+        {
+          this->PublishStats(t, this->startTime);
         }
       }
       // Video recorder is idle. Start recording.
@@ -247,10 +277,26 @@ void VideoRecorderPrivate::OnRender()
             this->bitrate);
         this->startTime = std::chrono::steady_clock::time_point(
             std::chrono::duration(std::chrono::seconds(0)));
+
+        if (this->pipelined)
+        {
+          ignmsg << "Encoding video in a separate thread." << std::endl;
+          this->pipelinedEncoder =
+              std::make_unique<PipelinedVideoEncoder>(this->videoEncoder);
+          this->pipelinedEncoder->SetFrameAddedCallback(
+              [this](const std::chrono::steady_clock::time_point &_t,
+                  const std::chrono::steady_clock::time_point &_startTime)
+              {
+                this->PublishStats(_t, _startTime);
+              });
+          this->pipelinedEncoder->Start();
+        }
       }
     }
     else if (this->videoEncoder.IsEncoding())
     {
+      // Encode pending frames before finalizing the video
+      this->pipelinedEncoder.reset();
       this->videoEncoder.Stop();
     }
   }
@@ -266,7 +312,12 @@ VideoRecorder::VideoRecorder()
 }
 
 /////////////////////////////////////////////////
-VideoRecorder::~VideoRecorder() = default;
+VideoRecorder::~VideoRecorder()
+{
+  // The encoding thread publishes stats using other members, stop it before
+  // they're destroyed
+  this->dataPtr->pipelinedEncoder.reset();
+}
 
 //////////////////////////////////////////////////
 void VideoRecorder::Update(const UpdateInfo &_info,
@@ -325,6 +376,19 @@ void VideoRecorder::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
           this->dataPtr->lockstep = lockstep;
         }
       }
+      if (auto pipelinedElem = elem->FirstChildElement("pipelined"))
+      {
+        bool pipelined = false;
+        if (pipelinedElem->QueryBoolText(&pipelined) != tinyxml2::XML_SUCCESS)
+        {
+          ignerr << "Failed to parse <pipelined> value: "
+                 << pipelinedElem->GetText() << std::endl;
+        }
+        else
+        {
+          this->dataPtr->pipelined = pipelined;
+        }
+      }
       if (auto bitrateElem = elem->FirstChildElement("bitrate"))
       {
         unsigned int bitrate = 0u;
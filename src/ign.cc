@@ -17,8 +17,18 @@
 
 #include "ign.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <functional>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <ignition/common/Console.hh>
@@ -27,8 +37,11 @@
 #include <ignition/fuel_tools/ClientConfig.hh>
 #include <ignition/fuel_tools/Result.hh>
 #include <ignition/fuel_tools/WorldIdentifier.hh>
+#include <ignition/msgs/param_v.pb.h>
+#include <ignition/transport/Node.hh>
 
 #include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/LogQuery.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/ServerConfig.hh"
 
@@ -114,6 +127,197 @@ extern "C" const char *findFuelResource(
   return "";
 }
 
+//////////////////////////////////////////////////
+extern "C" int printPerformance(const char *_worldName)
+{
+  ignition::transport::Node node;
+
+  std::string topic;
+  if (nullptr != _worldName && std::strlen(_worldName) > 0)
+  {
+    topic = "/world/" + std::string(_worldName) + "/performance";
+  }
+  else
+  {
+    // Topics are discovered asynchronously, give them some time
+    const std::string suffix{"/performance"};
+    for (int i = 0; i < 30 && topic.empty(); ++i)
+    {
+      std::vector<std::string> topics;
+      node.TopicList(topics);
+      for (const auto &t : topics)
+      {
+        if (t.rfind("/world/", 0) == 0 && t.size() > suffix.size() &&
+            t.compare(t.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+          topic = t;
+          break;
+        }
+      }
+      if (topic.empty())
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (topic.empty())
+    {
+      ignerr << "Failed to find a running simulation." << std::endl;
+      return 1;
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool received{false};
+  ignition::msgs::Param_V msg;
+  std::function<void(const ignition::msgs::Param_V &)> cb =
+      [&](const ignition::msgs::Param_V &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    msg = _msg;
+    received = true;
+    cv.notify_all();
+  };
+
+  if (!node.Subscribe(topic, cb))
+  {
+    ignerr << "Failed to subscribe to [" << topic << "]." << std::endl;
+    return 1;
+  }
+
+  {
+    // Messages are published once per second
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!cv.wait_for(lock, std::chrono::seconds(5), [&]{return received;}))
+    {
+      ignerr << "Didn't receive performance data on [" << topic << "]."
+             << std::endl;
+      return 1;
+    }
+  }
+  node.Unsubscribe(topic);
+
+  auto getDouble = [](const ignition::msgs::Param &_param,
+      const std::string &_key)
+  {
+    auto it = _param.params().find(_key);
+    if (it == _param.params().end())
+      return 0.0;
+    if (it->second.type() == ignition::msgs::Any::INT32)
+      return static_cast<double>(it->second.int_value());
+    return it->second.double_value();
+  };
+
+  auto getString = [](const ignition::msgs::Param &_param,
+      const std::string &_key)
+  {
+    auto it = _param.params().find(_key);
+    return it == _param.params().end() ? std::string() :
+        it->second.string_value();
+  };
+
+  if (msg.param_size() == 0)
+    return 1;
+
+  const auto &world = msg.param(0);
+  std::cout << "World [" << getString(world, "name") << "]: "
+            << getDouble(world, "entity_count") << " entities, "
+            << getDouble(world, "component_count") << " components, "
+            << getDouble(world, "view_count") << " views, "
+            << getDouble(world, "system_count") << " systems, RTF "
+            << getDouble(world, "real_time_factor") << std::endl;
+  std::cout << "Steps in the last second: " << getDouble(world, "step_count")
+            << ", mean " << getDouble(world, "step_mean_us") << " us, max "
+            << getDouble(world, "step_max_us") << " us" << std::endl
+            << std::endl;
+
+  // Sort systems by the total time taken in the last second
+  std::vector<const ignition::msgs::Param *> systems;
+  for (int i = 1; i < msg.param_size(); ++i)
+    systems.push_back(&msg.param(i));
+
+  auto total = [&](const ignition::msgs::Param *_param)
+  {
+    return getDouble(*_param, "preupdate_total_us") +
+           getDouble(*_param, "update_total_us") +
+           getDouble(*_param, "postupdate_total_us");
+  };
+  std::sort(systems.begin(), systems.end(),
+      [&](const ignition::msgs::Param *_a, const ignition::msgs::Param *_b)
+      {
+        return total(_a) > total(_b);
+      });
+
+  // Mean / max per callback, in microseconds
+  std::cout << std::left << std::setw(48) << "System"
+            << std::right << std::setw(12) << "Total us"
+            << std::setw(22) << "PreUpdate mean/max"
+            << std::setw(22) << "Update mean/max"
+            << std::setw(22) << "PostUpdate mean/max" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  for (const auto *system : systems)
+  {
+    std::cout << std::left << std::setw(48) << getString(*system, "name")
+              << std::right << std::setw(12) << total(system);
+    for (const std::string prefix : {"preupdate_", "update_", "postupdate_"})
+    {
+      std::stringstream ss;
+      if (system->params().find(prefix + "count") == system->params().end())
+      {
+        ss << "-";
+      }
+      else
+      {
+        ss << std::fixed << std::setprecision(1)
+           << getDouble(*system, prefix + "mean_us") << "/"
+           << getDouble(*system, prefix + "max_us");
+      }
+      std::cout << std::setw(22) << ss.str();
+    }
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
+
+//////////////////////////////////////////////////
+extern "C" int queryLog(const char *_path, const char *_entity,
+    const char *_components, const char *_output)
+{
+  if (nullptr == _path || nullptr == _entity || nullptr == _components ||
+      std::strlen(_entity) == 0 || std::strlen(_components) == 0)
+  {
+    ignerr << "Querying a log requires --log-entity and at least one "
+           << "--log-component." << std::endl;
+    return 1;
+  }
+
+  ignition::gazebo::LogQuery query(_path);
+  if (!query.Valid())
+    return 1;
+
+  std::vector<std::string> components = ignition::common::split(
+      _components, ":");
+
+  bool result{false};
+  if (nullptr != _output && std::strlen(_output) > 0)
+  {
+    std::ofstream ofs(_output);
+    if (!ofs.is_open())
+    {
+      ignerr << "Failed to open [" << _output << "] for writing." << std::endl;
+      return 1;
+    }
+    result = query.WriteCsv(ofs, _entity, components);
+    if (result)
+      ignmsg << "Wrote [" << _entity << "] to [" << _output << "]" << std::endl;
+  }
+  else
+  {
+    result = query.WriteCsv(std::cout, _entity, components);
+  }
+
+  return result ? 0 : 1;
+}
+
 //////////////////////////////////////////////////
 extern "C" int runServer(const char *_sdfString,
     int _iterations, int _run, float _hz, int _levels, const char *_networkRole,
@@ -122,7 +326,7 @@ extern "C" int runServer(const char *_sdfString,
     const char *_playback, const char *_physicsEngine,
     const char *_renderEngineServer, const char *_renderEngineGui,
     const char *_file, const char *_recordTopics,
-    int _headless)
+    int _headless, int _batch, int _precisePacing)
 {
   ignition::gazebo::ServerConfig serverConfig;
 
@@ -336,6 +540,8 @@ extern "C" int runServer(const char *_sdfString,
   }
 
   serverConfig.SetHeadlessRendering(_headless);
+  serverConfig.SetBatchMode(_batch);
+  serverConfig.SetPrecisePacing(_precisePacing);
 
   if (_renderEngineServer != nullptr && std::strlen(_renderEngineServer) > 0)
   {
@@ -55,6 +55,8 @@ extern "C" const char *worldInstallDir();
 /// \param[in] _recordTopics Colon separated list of topics to record. Leave
 /// null to record the default topics.
 /// \param[in] _headless True if server rendering should run headless
+/// \param[in] _batch --batch option
+/// \param[in] _precisePacing --precise-pacing option
 /// \return 0 if successful, 1 if not.
 extern "C" int runServer(const char *_sdfString,
     int _iterations, int _run, float _hz, int _levels,
@@ -63,7 +65,26 @@ extern "C" int runServer(const char *_sdfString,
     int _logCompress, const char *_playback,
     const char *_physicsEngine, const char *_renderEngineServer,
     const char *_renderEngineGui, const char *_file,
-    const char *_recordTopics, int _headless);
+    const char *_recordTopics, int _headless, int _batch,
+    int _precisePacing);
+
+/// \brief External hook to print the wall time taken by each system of a
+/// running simulation, as published on the performance topic.
+/// \param[in] _worldName Name of the world. Leave empty to use the first
+/// world found.
+/// \return 0 if successful, 1 if not.
+extern "C" int printPerformance(const char *_worldName);
+
+/// \brief External hook to write the time series of components of an entity
+/// from a recorded log as comma separated values.
+/// \param[in] _path Path to the log directory or state file.
+/// \param[in] _entity --log-entity option
+/// \param[in] _components Colon separated list of component names.
+/// \param[in] _output --log-output option. Leave empty to write to the
+/// standard output.
+/// \return 0 if successful, 1 if not.
+extern "C" int queryLog(const char *_path, const char *_entity,
+    const char *_components, const char *_output);
 
 /// \brief External hook to run simulation GUI.
 /// \param[in] _guiConfig Path to Ignition GUI configuration file.
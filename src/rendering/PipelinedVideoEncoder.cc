@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gazebo/rendering/PipelinedVideoEncoder.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief A frame waiting to be encoded
+struct VideoFrame
+{
+  /// \brief RGB data
+  std::vector<unsigned char> data;
+
+  /// \brief Frame width
+  unsigned int width{0u};
+
+  /// \brief Frame height
+  unsigned int height{0u};
+
+  /// \brief Frame timestamp
+  std::chrono::steady_clock::time_point time;
+
+  /// \brief Start time of the recording
+  std::chrono::steady_clock::time_point startTime;
+};
+}
+
+/// \brief Private data for the PipelinedVideoEncoder class
+class ignition::gazebo::PipelinedVideoEncoderPrivate
+{
+  /// \brief Encoding thread loop. Runs until stopped and all queued frames
+  /// have been encoded.
+  public: void Run();
+
+  /// \brief Encoder which frames are fed to
+  public: common::VideoEncoder *encoder{nullptr};
+
+  /// \brief Maximum number of queued frames
+  public: unsigned int queueSize{8u};
+
+  /// \brief Frames waiting to be encoded
+  public: std::deque<VideoFrame> queue;
+
+  /// \brief Buffers of encoded frames, reused for new frames to avoid
+  /// allocating on every frame.
+  public: std::vector<std::vector<unsigned char>> freeBuffers;
+
+  /// \brief Protects the queue, the free buffers and the running flag
+  public: std::mutex mutex;
+
+  /// \brief Signaled when a frame is queued or the thread is stopped
+  public: std::condition_variable frameQueued;
+
+  /// \brief Signaled when a frame is taken off the queue
+  public: std::condition_variable frameTaken;
+
+  /// \brief Encoding thread
+  public: std::thread thread;
+
+  /// \brief Whether the encoding thread should keep running
+  public: bool running{false};
+
+  /// \brief Called for each frame accepted by the encoder
+  public: PipelinedVideoEncoder::FrameAddedCallback frameAddedCb;
+};
+
+/////////////////////////////////////////////////
+PipelinedVideoEncoder::PipelinedVideoEncoder(common::VideoEncoder &_encoder,
+    unsigned int _queueSize)
+  : dataPtr(std::make_unique<PipelinedVideoEncoderPrivate>())
+{
+  this->dataPtr->encoder = &_encoder;
+  this->dataPtr->queueSize = std::max(1u, _queueSize);
+}
+
+/////////////////////////////////////////////////
+PipelinedVideoEncoder::~PipelinedVideoEncoder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+void PipelinedVideoEncoder::SetFrameAddedCallback(
+    const FrameAddedCallback &_cb)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->frameAddedCb = _cb;
+}
+
+/////////////////////////////////////////////////
+void PipelinedVideoEncoder::Start()
+{
+  if (this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->running = true;
+  }
+  this->dataPtr->thread =
+      std::thread(&PipelinedVideoEncoderPrivate::Run, this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+void PipelinedVideoEncoder::Stop()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->running = false;
+  }
+  this->dataPtr->frameQueued.notify_all();
+  this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+bool PipelinedVideoEncoder::Running() const
+{
+  return this->dataPtr->thread.joinable();
+}
+
+/////////////////////////////////////////////////
+bool PipelinedVideoEncoder::AddFrame(const unsigned char *_frame,
+    unsigned int _width, unsigned int _height,
+    const std::chrono::steady_clock::time_point &_time,
+    const std::chrono::steady_clock::time_point &_startTime)
+{
+  IGN_PROFILE("PipelinedVideoEncoder::AddFrame");
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->running)
+    return false;
+
+  // Wait for the encoder to catch up
+  this->dataPtr->frameTaken.wait(lock, [this]
+  {
+    return this->dataPtr->queue.size() < this->dataPtr->queueSize;
+  });
+
+  VideoFrame frame;
+  if (!this->dataPtr->freeBuffers.empty())
+  {
+    frame.data = std::move(this->dataPtr->freeBuffers.back());
+    this->dataPtr->freeBuffers.pop_back();
+  }
+  frame.width = _width;
+  frame.height = _height;
+  frame.time = _time;
+  frame.startTime = _startTime;
+
+  // Copy without holding the lock, so the encoding thread isn't blocked
+  lock.unlock();
+  frame.data.resize(static_cast<size_t>(_width) * _height * 3u);
+  std::memcpy(frame.data.data(), _frame, frame.data.size());
+  lock.lock();
+
+  this->dataPtr->queue.push_back(std::move(frame));
+  lock.unlock();
+  this->dataPtr->frameQueued.notify_one();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void PipelinedVideoEncoderPrivate::Run()
+{
+  while (true)
+  {
+    VideoFrame frame;
+    PipelinedVideoEncoder::FrameAddedCallback cb;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->frameQueued.wait(lock, [this]
+      {
+        return !this->queue.empty() || !this->running;
+      });
+
+      // Only exit once all frames have been encoded
+      if (this->queue.empty())
+        break;
+
+      frame = std::move(this->queue.front());
+      this->queue.pop_front();
+      cb = this->frameAddedCb;
+    }
+
+    bool frameAdded{false};
+    {
+      IGN_PROFILE("PipelinedVideoEncoder Encode");
+      frameAdded = this->encoder->AddFrame(frame.data.data(), frame.width,
+          frame.height, frame.time);
+    }
+    if (frameAdded && cb)
+      cb(frame.time, frame.startTime);
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->freeBuffers.push_back(std::move(frame.data));
+    }
+    this->frameTaken.notify_one();
+  }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/VideoEncoder.hh>
+
+#include "ignition/gazebo/rendering/PipelinedVideoEncoder.hh"
+#include "ignition/gazebo/test_config.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+class PipelinedVideoEncoderTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    common::createDirectories(this->dir);
+    ASSERT_TRUE(this->encoder.Start("mp4", this->path, this->width,
+        this->height));
+  }
+
+  protected: void TearDown() override
+  {
+    this->encoder.Reset();
+    common::removeAll(this->dir);
+  }
+
+  /// \brief Timestamp of the _i-th frame, spaced so the encoder doesn't
+  /// drop any frames at its default 25 fps.
+  /// \param[in] _i Frame index
+  /// \return Frame timestamp
+  protected: std::chrono::steady_clock::time_point Time(unsigned int _i)
+  {
+    return std::chrono::steady_clock::time_point(100ms + _i * 50ms);
+  }
+
+  /// \brief Directory for test files
+  protected: std::string dir = common::joinPaths(PROJECT_BINARY_PATH, "test",
+      "pipelined_video_encoder");
+
+  /// \brief Video file
+  protected: std::string path = common::joinPaths(this->dir, "video.mp4");
+
+  /// \brief Frame width
+  protected: unsigned int width{32u};
+
+  /// \brief Frame height
+  protected: unsigned int height{24u};
+
+  /// \brief Frame data
+  protected: std::vector<unsigned char> frame =
+      std::vector<unsigned char>(this->width * this->height * 3u, 128u);
+
+  /// \brief Encoder the frames are fed to
+  protected: common::VideoEncoder encoder;
+};
+
+/////////////////////////////////////////////////
+TEST_F(PipelinedVideoEncoderTest, StartStop)
+{
+  PipelinedVideoEncoder pipelined(this->encoder);
+  EXPECT_FALSE(pipelined.Running());
+  EXPECT_FALSE(pipelined.AddFrame(this->frame.data(), this->width,
+      this->height, this->Time(0), this->Time(0)));
+
+  pipelined.Start();
+  EXPECT_TRUE(pipelined.Running());
+
+  // Starting twice is a no-op
+  pipelined.Start();
+  EXPECT_TRUE(pipelined.Running());
+  EXPECT_TRUE(pipelined.AddFrame(this->frame.data(), this->width,
+      this->height, this->Time(0), this->Time(0)));
+
+  pipelined.Stop();
+  EXPECT_FALSE(pipelined.Running());
+  EXPECT_FALSE(pipelined.AddFrame(this->frame.data(), this->width,
+      this->height, this->Time(1), this->Time(0)));
+
+  // Stopping twice is a no-op
+  pipelined.Stop();
+  EXPECT_FALSE(pipelined.Running());
+
+  // Can be restarted
+  pipelined.Start();
+  EXPECT_TRUE(pipelined.Running());
+  EXPECT_TRUE(pipelined.AddFrame(this->frame.data(), this->width,
+      this->height, this->Time(1), this->Time(0)));
+  pipelined.Stop();
+
+  EXPECT_TRUE(this->encoder.Stop());
+  EXPECT_TRUE(common::exists(this->path));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PipelinedVideoEncoderTest, StopFlushesQueue)
+{
+  std::vector<std::chrono::steady_clock::time_point> times;
+  std::vector<std::chrono::steady_clock::time_point> startTimes;
+
+  // A small queue, so AddFrame has to wait for the encoder
+  PipelinedVideoEncoder pipelined(this->encoder, 2u);
+  pipelined.SetFrameAddedCallback(
+      [&](const std::chrono::steady_clock::time_point &_time,
+          const std::chrono::steady_clock::time_point &_startTime)
+      {
+        times.push_back(_time);
+        startTimes.push_back(_startTime);
+      });
+  pipelined.Start();
+
+  const unsigned int frameCount{10u};
+  for (unsigned int i = 0; i < frameCount; ++i)
+  {
+    EXPECT_TRUE(pipelined.AddFrame(this->frame.data(), this->width,
+        this->height, this->Time(i), this->Time(0)));
+
+    // The frame was copied, so the buffer can be reused right away
+    this->frame[0] = static_cast<unsigned char>(i);
+  }
+
+  // All queued frames are encoded before the thread stops
+  pipelined.Stop();
+
+  ASSERT_EQ(frameCount, times.size());
+  ASSERT_EQ(frameCount, startTimes.size());
+  for (unsigned int i = 0; i < frameCount; ++i)
+  {
+    EXPECT_EQ(this->Time(i), times[i]);
+    EXPECT_EQ(this->Time(0), startTimes[i]);
+  }
+
+  EXPECT_TRUE(this->encoder.Stop());
+  EXPECT_TRUE(common::exists(this->path));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PipelinedVideoEncoderTest, DestructorFlushesQueue)
+{
+  unsigned int added{0u};
+  {
+    PipelinedVideoEncoder pipelined(this->encoder);
+    pipelined.SetFrameAddedCallback(
+        [&](const std::chrono::steady_clock::time_point &,
+            const std::chrono::steady_clock::time_point &)
+        {
+          ++added;
+        });
+    pipelined.Start();
+
+    for (unsigned int i = 0; i < 5u; ++i)
+    {
+      EXPECT_TRUE(pipelined.AddFrame(this->frame.data(), this->width,
+          this->height, this->Time(i), this->Time(0)));
+    }
+  }
+  EXPECT_EQ(5u, added);
+
+  EXPECT_TRUE(this->encoder.Stop());
+}
@@ -252,6 +252,11 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
             std::chrono::steady_clock::duration::zero())
         {
           this->autoStaticEntities[entity] = _info.simTime;
+          if (this->wakeUp)
+          {
+            this->wakeUp->WakeAt(_info.simTime + this->disablePhysicsTime +
+                std::chrono::steady_clock::duration(1));
+          }
         }
 
         if (this->isPerformer)
@@ -320,6 +325,10 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       this->pendingGeometryUpdate.erase(e);
     }
 
+    // Keep checking until the remaining breadcrumbs become performers
+    if (!this->pendingGeometryUpdate.empty() && this->wakeUp)
+      this->wakeUp->Wake();
+
     // make entities static when auto disable period is reached.
     for (auto it = this->autoStaticEntities.begin();
         it != this->autoStaticEntities.end();)
@@ -399,6 +408,24 @@ bool Breadcrumbs::MakeStatic(Entity _entity, EntityComponentManager &_ecm)
 }
 
 
+//////////////////////////////////////////////////
+void Breadcrumbs::Reset(const UpdateInfo &, EntityComponentManager &)
+{
+  IGN_PROFILE("Breadcrumbs::Reset");
+
+  // Breadcrumbs deployed after the initial state were removed by the reset
+  this->numDeployments = 0;
+  this->pendingGeometryUpdate.clear();
+  this->autoStaticEntities.clear();
+}
+
+//////////////////////////////////////////////////
+void Breadcrumbs::ConfigureWakeUp(const std::shared_ptr<SystemWakeUp> &_wakeUp)
+{
+  std::lock_guard<std::mutex> lock(this->pendingCmdsMutex);
+  this->wakeUp = _wakeUp;
+}
+
 //////////////////////////////////////////////////
 void Breadcrumbs::OnDeploy(const msgs::Empty &)
 {
@@ -407,6 +434,8 @@ void Breadcrumbs::OnDeploy(const msgs::Empty &)
     std::lock_guard<std::mutex> lock(this->pendingCmdsMutex);
 
     this->pendingCmds.push_back(true);
+    if (this->wakeUp)
+      this->wakeUp->Wake();
   }
 
   // Check topic statistics for dropped messages
@@ -436,6 +465,8 @@ void Breadcrumbs::OnDeploy(const msgs::Empty &)
 IGNITION_ADD_PLUGIN(Breadcrumbs,
                     ignition::gazebo::System,
                     Breadcrumbs::ISystemConfigure,
-                    Breadcrumbs::ISystemPreUpdate)
+                    Breadcrumbs::ISystemPreUpdate,
+                    Breadcrumbs::ISystemWakeUp,
+                    Breadcrumbs::ISystemReset)
 
 IGNITION_ADD_PLUGIN_ALIAS(Breadcrumbs, "ignition::gazebo::systems::Breadcrumbs")
@@ -88,7 +88,9 @@ namespace systems
   class Breadcrumbs
       : public System,
         public ISystemConfigure,
-        public ISystemPreUpdate
+        public ISystemPreUpdate,
+        public ISystemWakeUp,
+        public ISystemReset
   {
     /// \brief Constructor
     public: Breadcrumbs() = default;
@@ -104,6 +106,14 @@ namespace systems
                 const ignition::gazebo::UpdateInfo &_info,
                 ignition::gazebo::EntityComponentManager &_ecm) override;
 
+    // Documentation inherited
+    public: void ConfigureWakeUp(
+                const std::shared_ptr<SystemWakeUp> &_wakeUp) override;
+
+    // Documentation inherited
+    public: void Reset(const UpdateInfo &_info,
+                       EntityComponentManager &_ecm) override;
+
     /// \brief Callback to deployment topic
     private: void OnDeploy(const msgs::Empty &_msg);
 
@@ -156,6 +166,11 @@ namespace systems
     /// \brief Mutex to protect pending commands
     private: std::mutex pendingCmdsMutex;
 
+    /// \brief Wakes up PreUpdate when there are deployments to process or
+    /// breadcrumbs to make static. Protected by pendingCmdsMutex, because
+    /// deployments may arrive before it's set.
+    private: std::shared_ptr<SystemWakeUp> wakeUp;
+
     /// \brief Time when the entity should be made static after they are spawned
     private: std::chrono::steady_clock::duration disablePhysicsTime =
         std::chrono::steady_clock::duration::zero();
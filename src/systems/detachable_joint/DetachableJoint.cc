@@ -140,14 +140,7 @@ void DetachableJoint::PreUpdate(
 
       if (kNullEntity != this->childLinkEntity)
       {
-        // Attach the models
-        // We do this by creating a detachable joint entity.
-        this->detachableJointEntity = _ecm.CreateEntity();
-
-        _ecm.CreateComponent(
-            this->detachableJointEntity,
-            components::DetachableJoint({this->parentLinkEntity,
-                                         this->childLinkEntity, "fixed"}));
+        this->Attach(_ecm);
 
         this->node.Subscribe(
             this->topic, &DetachableJoint::OnDetachRequest, this);
@@ -181,18 +174,64 @@ void DetachableJoint::PreUpdate(
       this->detachRequested = false;
     }
   }
+  // Keep looking for the child model on every iteration
+  else if (this->validConfig && this->wakeUp)
+  {
+    this->wakeUp->Wake();
+  }
+}
+
+//////////////////////////////////////////////////
+void DetachableJoint::Reset(const UpdateInfo &, EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("DetachableJoint::Reset");
+  this->detachRequested = false;
+  if (!this->initialized)
+    return;
+
+  // The joint was created after the initial state, so the reset removed it,
+  // or it was detached. Either way, the models start attached again.
+  if (kNullEntity == this->detachableJointEntity ||
+      !_ecm.HasEntity(this->detachableJointEntity))
+  {
+    this->Attach(_ecm);
+  }
+}
+
+//////////////////////////////////////////////////
+void DetachableJoint::Attach(EntityComponentManager &_ecm)
+{
+  // Attach the models
+  // We do this by creating a detachable joint entity.
+  this->detachableJointEntity = _ecm.CreateEntity();
+
+  _ecm.CreateComponent(
+      this->detachableJointEntity,
+      components::DetachableJoint({this->parentLinkEntity,
+                                   this->childLinkEntity, "fixed"}));
+}
+
+//////////////////////////////////////////////////
+void DetachableJoint::ConfigureWakeUp(
+    const std::shared_ptr<SystemWakeUp> &_wakeUp)
+{
+  this->wakeUp = _wakeUp;
 }
 
 //////////////////////////////////////////////////
 void DetachableJoint::OnDetachRequest(const msgs::Empty &)
 {
   this->detachRequested = true;
+  if (this->wakeUp)
+    this->wakeUp->Wake();
 }
 
 IGNITION_ADD_PLUGIN(DetachableJoint,
                     ignition::gazebo::System,
                     DetachableJoint::ISystemConfigure,
-                    DetachableJoint::ISystemPreUpdate)
+                    DetachableJoint::ISystemPreUpdate,
+                    DetachableJoint::ISystemWakeUp,
+                    DetachableJoint::ISystemReset)
 
 IGNITION_ADD_PLUGIN_ALIAS(DetachableJoint,
   "ignition::gazebo::systems::DetachableJoint")
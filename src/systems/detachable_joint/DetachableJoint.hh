@@ -57,7 +57,9 @@ namespace systems
   class DetachableJoint
       : public System,
         public ISystemConfigure,
-        public ISystemPreUpdate
+        public ISystemPreUpdate,
+        public ISystemWakeUp,
+        public ISystemReset
   {
     /// Documentation inherited
     public: DetachableJoint() = default;
@@ -73,6 +75,19 @@ namespace systems
                 const ignition::gazebo::UpdateInfo &_info,
                 ignition::gazebo::EntityComponentManager &_ecm) final;
 
+    /// Documentation inherited
+    public: void ConfigureWakeUp(
+                const std::shared_ptr<SystemWakeUp> &_wakeUp) final;
+
+    /// Documentation inherited
+    public: void Reset(const UpdateInfo &_info,
+                       EntityComponentManager &_ecm) final;
+
+    /// \brief Attach the child link to the parent link by creating a
+    /// detachable joint entity.
+    /// \param[in] _ecm Entity component manager.
+    private: void Attach(EntityComponentManager &_ecm);
+
     /// \brief Callback for detach request topic
     private: void OnDetachRequest(const msgs::Empty &_msg);
 
@@ -111,6 +126,10 @@ namespace systems
 
     /// \brief Whether the system has been initialized
     private: bool initialized{false};
+
+    /// \brief Wakes up PreUpdate when a detachment is requested, so it isn't
+    /// called on every iteration once the models are attached.
+    private: std::shared_ptr<SystemWakeUp> wakeUp;
   };
   }
 }
@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LogArchive.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <ctime>
+#include <limits>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Profiler.hh>
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+namespace
+{
+  /// \brief Size of the compressed output buffer.
+  constexpr std::size_t kBufferSize{256u * 1024u};
+
+  /// \brief Largest value of 32 bit fields, which means the value is in the
+  /// ZIP64 extra field instead.
+  constexpr uint64_t kMax32{0xFFFFFFFFu};
+
+  /// \brief Largest value of 16 bit fields.
+  constexpr uint64_t kMax16{0xFFFFu};
+
+  /// \brief General purpose flag telling that sizes and CRC follow the data.
+  constexpr uint16_t kDataDescriptorFlag{0x0008u};
+
+  /// \brief Compression methods.
+  constexpr uint16_t kStored{0u};
+  constexpr uint16_t kDeflated{8u};
+
+  /// \brief Version needed to extract entries with and without ZIP64
+  /// records.
+  constexpr uint16_t kVersionZip64{45u};
+  constexpr uint16_t kVersionDefault{20u};
+
+  /// \brief Little-endian record being built.
+  class Record
+  {
+    /// \brief Append a 16 bit value.
+    /// \param[in] _value Value.
+    /// \return This record.
+    public: Record &U16(uint64_t _value)
+    {
+      for (int i = 0; i < 2; ++i)
+        this->data.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+      return *this;
+    }
+
+    /// \brief Append a 32 bit value.
+    /// \param[in] _value Value.
+    /// \return This record.
+    public: Record &U32(uint64_t _value)
+    {
+      for (int i = 0; i < 4; ++i)
+        this->data.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+      return *this;
+    }
+
+    /// \brief Append a 64 bit value.
+    /// \param[in] _value Value.
+    /// \return This record.
+    public: Record &U64(uint64_t _value)
+    {
+      for (int i = 0; i < 8; ++i)
+        this->data.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+      return *this;
+    }
+
+    /// \brief Append a string, without terminator.
+    /// \param[in] _value String.
+    /// \return This record.
+    public: Record &Str(const std::string &_value)
+    {
+      this->data.insert(this->data.end(), _value.begin(), _value.end());
+      return *this;
+    }
+
+    /// \brief Bytes of the record.
+    public: std::vector<char> data;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the current local time in MS-DOS format, with the date in
+  /// the high 16 bits.
+  /// \return Date and time.
+  uint32_t DosTime()
+  {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    if (local.tm_year < 80)
+      return (1u << 5 | 1u) << 16;
+
+    uint32_t date = static_cast<uint32_t>((local.tm_year - 80) << 9 |
+        (local.tm_mon + 1) << 5 | local.tm_mday);
+    uint32_t time = static_cast<uint32_t>(local.tm_hour << 11 |
+        local.tm_min << 5 | local.tm_sec / 2);
+    return date << 16 | time;
+  }
+}
+
+//////////////////////////////////////////////////
+LogArchiveWriter::LogArchiveWriter() = default;
+
+//////////////////////////////////////////////////
+LogArchiveWriter::~LogArchiveWriter()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::Open(const std::string &_path, int _level)
+{
+  this->Close();
+
+  this->file.open(_path, std::ios::binary | std::ios::trunc);
+  if (!this->file.is_open())
+  {
+    ignerr << "Failed to open archive [" << _path << "] for writing."
+           << std::endl;
+    return false;
+  }
+
+  this->path = _path;
+  this->level = std::clamp(_level, 1, 9);
+  this->failed = false;
+  this->offset = 0u;
+  this->dosTime = DosTime();
+  this->entries.clear();
+  this->buffer.resize(kBufferSize);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::IsOpen() const
+{
+  return this->file.is_open();
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::WriteRaw(const void *_data, std::size_t _size)
+{
+  if (this->failed)
+    return false;
+
+  this->file.write(static_cast<const char *>(_data),
+      static_cast<std::streamsize>(_size));
+  if (!this->file)
+  {
+    ignerr << "Failed to write to archive [" << this->path << "]."
+           << std::endl;
+    this->failed = true;
+    return false;
+  }
+  this->offset += _size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::WriteLocalHeader(const Entry &_entry)
+{
+  // Sizes aren't known yet, they're in the data descriptor. Files always
+  // have a ZIP64 field so the descriptor holds 64 bit sizes.
+  Record record;
+  record.U32(0x04034b50u)
+      .U16(_entry.directory ? kVersionDefault : kVersionZip64)
+      .U16(_entry.directory ? 0u : kDataDescriptorFlag)
+      .U16(_entry.directory ? kStored : kDeflated)
+      .U16(this->dosTime & 0xFFFFu)
+      .U16(this->dosTime >> 16)
+      .U32(0u)
+      .U32(_entry.directory ? 0u : kMax32)
+      .U32(_entry.directory ? 0u : kMax32)
+      .U16(_entry.name.size())
+      .U16(_entry.directory ? 0u : 20u)
+      .Str(_entry.name);
+  if (!_entry.directory)
+    record.U16(0x0001u).U16(16u).U64(0u).U64(0u);
+
+  return this->WriteRaw(record.data.data(), record.data.size());
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::AddDirectory(const std::string &_name)
+{
+  if (!this->IsOpen() || this->entryOpen)
+    return false;
+
+  Entry entry;
+  entry.name = _name;
+  if (entry.name.empty() || entry.name.back() != '/')
+    entry.name += '/';
+  entry.offset = this->offset;
+  entry.directory = true;
+  if (!this->WriteLocalHeader(entry))
+    return false;
+
+  this->entries.push_back(entry);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::BeginEntry(const std::string &_name)
+{
+  if (!this->IsOpen() || this->entryOpen)
+    return false;
+
+  if (!this->stream)
+  {
+    this->stream = std::make_unique<z_stream>();
+    // Raw deflate data, without zlib header, as used by zip
+    if (deflateInit2(this->stream.get(), this->level, Z_DEFLATED,
+          -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      ignerr << "Failed to initialize compressor." << std::endl;
+      this->stream.reset();
+      return false;
+    }
+  }
+  else
+  {
+    deflateReset(this->stream.get());
+  }
+
+  Entry entry;
+  entry.name = _name;
+  entry.offset = this->offset;
+  entry.crc = crc32(0L, Z_NULL, 0);
+  if (!this->WriteLocalHeader(entry))
+    return false;
+
+  this->entries.push_back(entry);
+  this->entryOpen = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::Deflate(int _flush)
+{
+  auto &entry = this->entries.back();
+  int ret{Z_OK};
+  do
+  {
+    this->stream->next_out = this->buffer.data();
+    this->stream->avail_out = static_cast<uInt>(this->buffer.size());
+    ret = deflate(this->stream.get(), _flush);
+    if (ret == Z_STREAM_ERROR)
+    {
+      ignerr << "Failed to compress [" << entry.name << "]." << std::endl;
+      this->failed = true;
+      return false;
+    }
+
+    std::size_t produced = this->buffer.size() - this->stream->avail_out;
+    if (produced > 0u && !this->WriteRaw(this->buffer.data(), produced))
+      return false;
+    entry.compressedSize += produced;
+  }
+  while (_flush == Z_FINISH ? ret != Z_STREAM_END :
+      this->stream->avail_out == 0u);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::Write(const char *_data, std::size_t _size)
+{
+  IGN_PROFILE("LogArchiveWriter::Write");
+  if (!this->entryOpen || this->failed)
+    return false;
+
+  auto &entry = this->entries.back();
+  constexpr std::size_t kMaxInput{std::numeric_limits<uInt>::max()};
+  while (_size > 0u)
+  {
+    auto input = static_cast<uInt>(std::min(_size, kMaxInput));
+    auto bytes = reinterpret_cast<const Bytef *>(_data);
+    entry.crc = crc32(entry.crc, bytes, input);
+    entry.size += input;
+
+    this->stream->next_in = const_cast<Bytef *>(bytes);
+    this->stream->avail_in = input;
+    if (!this->Deflate(Z_NO_FLUSH))
+      return false;
+
+    _data += input;
+    _size -= input;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::EndEntry()
+{
+  if (!this->entryOpen)
+    return false;
+  this->entryOpen = false;
+
+  this->stream->next_in = Z_NULL;
+  this->stream->avail_in = 0u;
+  if (!this->Deflate(Z_FINISH))
+    return false;
+
+  const auto &entry = this->entries.back();
+  Record record;
+  record.U32(0x08074b50u)
+      .U32(entry.crc)
+      .U64(entry.compressedSize)
+      .U64(entry.size);
+  return this->WriteRaw(record.data.data(), record.data.size());
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::AddFile(const std::string &_name,
+    const std::string &_path)
+{
+  std::ifstream input(_path, std::ios::binary);
+  if (!input.is_open())
+  {
+    ignerr << "Failed to open [" << _path << "] to add it to archive ["
+           << this->path << "]." << std::endl;
+    return false;
+  }
+
+  if (!this->BeginEntry(_name))
+    return false;
+
+  std::vector<char> chunk(kBufferSize);
+  while (input)
+  {
+    input.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    auto count = static_cast<std::size_t>(input.gcount());
+    if (count > 0u && !this->Write(chunk.data(), count))
+    {
+      this->EndEntry();
+      return false;
+    }
+  }
+  return this->EndEntry();
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::AddDirectoryTree(const std::string &_name,
+    const std::string &_path, const std::vector<std::string> &_skip)
+{
+  std::string name = _name;
+  if (name.empty() || name.back() != '/')
+    name += '/';
+
+  bool result{true};
+  for (common::DirIter file(_path); file != common::DirIter(); ++file)
+  {
+    std::string current(*file);
+    std::string base = common::basename(current);
+    if (std::find(_skip.begin(), _skip.end(), base) != _skip.end())
+      continue;
+
+    if (common::isDirectory(current))
+    {
+      result = this->AddDirectory(name + base + "/") &&
+          this->AddDirectoryTree(name + base + "/", current) && result;
+    }
+    else if (common::isFile(current))
+    {
+      result = this->AddFile(name + base, current) && result;
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LogArchiveWriter::Close()
+{
+  if (!this->IsOpen())
+    return false;
+
+  if (this->entryOpen)
+    this->EndEntry();
+
+  const uint64_t directoryOffset = this->offset;
+  for (const auto &entry : this->entries)
+  {
+    // Like their local header, files always have their sizes in a ZIP64
+    // field, so readers which compare both records see the same values
+    const bool zip64Sizes = !entry.directory;
+    const bool bigOffset = entry.offset >= kMax32;
+    const uint16_t extraSize = static_cast<uint16_t>(
+        ((zip64Sizes ? 2u : 0u) + (bigOffset ? 1u : 0u)) * 8u);
+
+    // Unix permissions in the high 16 bits, and the MS-DOS directory flag
+    const uint32_t attributes = entry.directory ?
+        (040755u << 16) | 0x10u : 0100644u << 16;
+
+    Record record;
+    record.U32(0x02014b50u)
+        .U16(3u << 8 | kVersionZip64)
+        .U16(entry.directory ? kVersionDefault : kVersionZip64)
+        .U16(entry.directory ? 0u : kDataDescriptorFlag)
+        .U16(entry.directory ? kStored : kDeflated)
+        .U16(this->dosTime & 0xFFFFu)
+        .U16(this->dosTime >> 16)
+        .U32(entry.crc)
+        .U32(zip64Sizes ? kMax32 : entry.compressedSize)
+        .U32(zip64Sizes ? kMax32 : entry.size)
+        .U16(entry.name.size())
+        .U16(extraSize > 0u ? extraSize + 4u : 0u)
+        .U16(0u)
+        .U16(0u)
+        .U16(0u)
+        .U32(attributes)
+        .U32(bigOffset ? kMax32 : entry.offset)
+        .Str(entry.name);
+
+    if (extraSize > 0u)
+    {
+      record.U16(0x0001u).U16(extraSize);
+      if (zip64Sizes)
+        record.U64(entry.size).U64(entry.compressedSize);
+      if (bigOffset)
+        record.U64(entry.offset);
+    }
+    this->WriteRaw(record.data.data(), record.data.size());
+  }
+
+  const uint64_t directorySize = this->offset - directoryOffset;
+  const uint64_t count = this->entries.size();
+  if (count >= kMax16 || directorySize >= kMax32 ||
+      directoryOffset >= kMax32)
+  {
+    const uint64_t zip64Offset = this->offset;
+    Record record;
+    record.U32(0x06064b50u)
+        .U64(44u)
+        .U16(3u << 8 | kVersionZip64)
+        .U16(kVersionZip64)
+        .U32(0u)
+        .U32(0u)
+        .U64(count)
+        .U64(count)
+        .U64(directorySize)
+        .U64(directoryOffset);
+
+    // Locator
+    record.U32(0x07064b50u)
+        .U32(0u)
+        .U64(zip64Offset)
+        .U32(1u);
+    this->WriteRaw(record.data.data(), record.data.size());
+  }
+
+  Record record;
+  record.U32(0x06054b50u)
+      .U16(0u)
+      .U16(0u)
+      .U16(std::min(count, kMax16))
+      .U16(std::min(count, kMax16))
+      .U32(std::min(directorySize, kMax32))
+      .U32(std::min(directoryOffset, kMax32))
+      .U16(0u);
+  this->WriteRaw(record.data.data(), record.data.size());
+
+  this->file.close();
+  if (!this->file)
+    this->failed = true;
+
+  if (this->stream)
+  {
+    deflateEnd(this->stream.get());
+    this->stream.reset();
+  }
+  this->entries.clear();
+
+  return !this->failed;
+}
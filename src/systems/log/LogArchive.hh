@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_LOG_LOGARCHIVE_HH_
+#define IGNITION_GAZEBO_SYSTEMS_LOG_LOGARCHIVE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/log-system/Export.hh>
+
+// Forward declaration from zlib
+struct z_stream_s;
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief Writes a zip archive sequentially, compressing each file as its
+  /// data is written. Files don't need to be complete, or even exist on
+  /// disk, before they're added, so a log can be compressed while it's
+  /// being recorded instead of once recording is done.
+  ///
+  /// Entries are written one at a time: an entry is started, its data is
+  /// written in as many chunks as needed, and it's ended before the next
+  /// one. Sizes and checksums are written after the data of each entry, and
+  /// ZIP64 records are used as needed, so entries can be larger than 4 GiB.
+  class IGNITION_GAZEBO_LOG_SYSTEM_VISIBLE LogArchiveWriter
+  {
+    /// \brief Constructor
+    public: LogArchiveWriter();
+
+    /// \brief Destructor. Closes the archive.
+    public: ~LogArchiveWriter();
+
+    /// \brief Create a new archive, overwriting any existing file.
+    /// \param[in] _path Path to the archive.
+    /// \param[in] _level Compression level, from 1, fastest, to 9, smallest.
+    /// \return True if successful.
+    public: bool Open(const std::string &_path, int _level = 1);
+
+    /// \brief Whether the archive is open for writing.
+    /// \return True if open.
+    public: bool IsOpen() const;
+
+    /// \brief Add a directory entry. Directories should be added before
+    /// the files in them.
+    /// \param[in] _name Path of the directory in the archive, ending in `/`.
+    /// \return True if successful.
+    public: bool AddDirectory(const std::string &_name);
+
+    /// \brief Start a compressed file entry. Its data is written with Write
+    /// until EndEntry is called.
+    /// \param[in] _name Path of the file in the archive.
+    /// \return True if successful.
+    public: bool BeginEntry(const std::string &_name);
+
+    /// \brief Compress data into the current entry.
+    /// \param[in] _data Data to write.
+    /// \param[in] _size Number of bytes to write.
+    /// \return True if successful.
+    public: bool Write(const char *_data, std::size_t _size);
+
+    /// \brief Finish the current entry.
+    /// \return True if successful.
+    public: bool EndEntry();
+
+    /// \brief Add a file from disk as a compressed entry.
+    /// \param[in] _name Path of the file in the archive.
+    /// \param[in] _path Path of the file on disk.
+    /// \return True if successful.
+    public: bool AddFile(const std::string &_name, const std::string &_path);
+
+    /// \brief Add a directory from disk with all its contents.
+    /// \param[in] _name Path of the directory in the archive, ending in `/`.
+    /// \param[in] _path Path of the directory on disk.
+    /// \param[in] _skip Names of files at the top of the directory which
+    /// shouldn't be added.
+    /// \return True if successful.
+    public: bool AddDirectoryTree(const std::string &_name,
+        const std::string &_path,
+        const std::vector<std::string> &_skip = {});
+
+    /// \brief Finish the current entry, if any, write the central directory
+    /// and close the archive.
+    /// \return True if successful and all entries were written.
+    public: bool Close();
+
+    /// \brief Entry of the central directory.
+    private: struct Entry
+    {
+      /// \brief Path in the archive.
+      std::string name;
+
+      /// \brief Offset of the local header from the start of the archive.
+      uint64_t offset{0u};
+
+      /// \brief CRC-32 of the uncompressed data.
+      uint32_t crc{0u};
+
+      /// \brief Size of the compressed data.
+      uint64_t compressedSize{0u};
+
+      /// \brief Size of the uncompressed data.
+      uint64_t size{0u};
+
+      /// \brief Whether this is a directory.
+      bool directory{false};
+    };
+
+    /// \brief Write the local header of a new entry.
+    /// \param[in] _entry Entry.
+    /// \return True if successful.
+    private: bool WriteLocalHeader(const Entry &_entry);
+
+    /// \brief Run the compressor over the pending input, writing all the
+    /// output it produces.
+    /// \param[in] _flush zlib flush mode.
+    /// \return True if successful.
+    private: bool Deflate(int _flush);
+
+    /// \brief Write raw bytes to the archive.
+    /// \param[in] _data Data.
+    /// \param[in] _size Number of bytes.
+    /// \return True if successful.
+    private: bool WriteRaw(const void *_data, std::size_t _size);
+
+    /// \brief Archive file.
+    private: std::ofstream file;
+
+    /// \brief Path of the archive.
+    private: std::string path;
+
+    /// \brief Compression level.
+    private: int level{1};
+
+    /// \brief Compressor of the current entry.
+    private: std::unique_ptr<z_stream_s> stream;
+
+    /// \brief Whether an entry is being written.
+    private: bool entryOpen{false};
+
+    /// \brief Whether any write failed.
+    private: bool failed{false};
+
+    /// \brief Number of bytes written to the archive.
+    private: uint64_t offset{0u};
+
+    /// \brief Date and time of the entries, in MS-DOS format.
+    private: uint32_t dosTime{0u};
+
+    /// \brief Compressed output buffer.
+    private: std::vector<unsigned char> buffer;
+
+    /// \brief All entries written so far.
+    private: std::vector<Entry> entries;
+  };
+}
+}
+}
+}
+#endif
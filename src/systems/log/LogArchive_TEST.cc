@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/fuel_tools/Zip.hh>
+
+#include "ignition/gazebo/test_config.hh"
+
+#include "LogArchive.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+class LogArchiveTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    common::removeAll(this->dir);
+    common::createDirectories(this->dir);
+  }
+
+  protected: void TearDown() override
+  {
+    common::removeAll(this->dir);
+  }
+
+  /// \brief Read a whole file
+  /// \param[in] _path Path to the file
+  /// \return File content
+  protected: std::string Read(const std::string &_path)
+  {
+    std::ifstream ifs(_path, std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+  }
+
+  /// \brief Directory for test files
+  protected: std::string dir = common::joinPaths(PROJECT_BINARY_PATH, "test",
+      "log_archive");
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogArchiveTest, Compress)
+{
+  // Files on disk to add after the streamed entry
+  auto srcPath = common::joinPaths(this->dir, "src");
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(srcPath, "sub")));
+  std::ofstream(common::joinPaths(srcPath, "a.txt")) << "file a";
+  std::ofstream(common::joinPaths(srcPath, "skipped.txt")) << "skipped";
+  std::ofstream(common::joinPaths(srcPath, "sub", "b.txt")) << "file b";
+
+  auto zipPath = common::joinPaths(this->dir, "log.zip");
+  std::string streamed;
+  {
+    LogArchiveWriter archive;
+    EXPECT_FALSE(archive.IsOpen());
+    EXPECT_FALSE(archive.BeginEntry("log/state.mlog"));
+
+    ASSERT_TRUE(archive.Open(zipPath));
+    EXPECT_TRUE(archive.IsOpen());
+    EXPECT_TRUE(archive.AddDirectory("log/"));
+    ASSERT_TRUE(archive.BeginEntry("log/streamed.bin"));
+
+    // Can't start another entry until the current one is done
+    EXPECT_FALSE(archive.BeginEntry("log/other.bin"));
+
+    // Write in chunks, larger than the compression buffer in total
+    for (int i = 0; i < 1000; ++i)
+    {
+      std::string chunk = std::to_string(i) + std::string(1000, 'a' + i % 26);
+      EXPECT_TRUE(archive.Write(chunk.data(), chunk.size()));
+      streamed += chunk;
+    }
+    EXPECT_TRUE(archive.EndEntry());
+    EXPECT_FALSE(archive.Write("a", 1u));
+
+    EXPECT_TRUE(archive.AddDirectoryTree("log/", srcPath, {"skipped.txt"}));
+    EXPECT_TRUE(archive.Close());
+    EXPECT_FALSE(archive.IsOpen());
+  }
+
+  auto outPath = common::joinPaths(this->dir, "out");
+  ASSERT_TRUE(common::createDirectories(outPath));
+  ASSERT_TRUE(fuel_tools::Zip::Extract(zipPath, outPath));
+
+  EXPECT_EQ(streamed, this->Read(common::joinPaths(outPath, "log",
+      "streamed.bin")));
+  EXPECT_EQ("file a", this->Read(common::joinPaths(outPath, "log",
+      "a.txt")));
+  EXPECT_EQ("file b", this->Read(common::joinPaths(outPath, "log", "sub",
+      "b.txt")));
+  EXPECT_FALSE(common::exists(common::joinPaths(outPath, "log",
+      "skipped.txt")));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogArchiveTest, Invalid)
+{
+  LogArchiveWriter archive;
+  EXPECT_FALSE(archive.Open(common::joinPaths(this->dir, "missing",
+      "log.zip")));
+  EXPECT_FALSE(archive.IsOpen());
+  EXPECT_FALSE(archive.AddDirectory("log/"));
+  EXPECT_FALSE(archive.Write("a", 1u));
+  EXPECT_FALSE(archive.EndEntry());
+  EXPECT_FALSE(archive.Close());
+}
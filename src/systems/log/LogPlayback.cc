@@ -19,6 +19,7 @@
 
 #include <ignition/msgs/log_playback_stats.pb.h>
 
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -47,6 +48,8 @@
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "ignition/gazebo/MappedStateLog.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
@@ -85,12 +88,31 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   public: void Parse(EntityComponentManager &_ecm,
       const msgs::SerializedStateMap &_msg);
 
+  /// \brief While seeking back in time, update the list of entities to be
+  /// removed so we do not remove any entities that are to be created.
+  /// \param[in] _msg Message containing state updates.
+  /// \param[in, out] _entitiesToRemove Entities to be removed.
+  public: void UpdateEntitiesToRemove(const msgs::SerializedStateMap &_msg,
+      std::set<Entity> &_entitiesToRemove) const;
+
+  /// \brief Sim time of the last state in the log.
+  /// \return End time.
+  public: std::chrono::steady_clock::duration EndTime() const;
+
   /// \brief A batch of data from log file, of all pose messages
   public: transport::log::Batch batch;
 
   /// \brief Pointer to ign-transport Log
   public: std::unique_ptr<transport::log::Log> log;
 
+  /// \brief Memory-mapped state log, used instead of the ign-transport log
+  /// if the state was recorded with the "mmap" backend.
+  public: std::unique_ptr<MappedStateLogReader> stateLog;
+
+  /// \brief Sim time of the last state applied from the memory-mapped state
+  /// log. States at or before it aren't applied again.
+  public: std::optional<std::chrono::steady_clock::duration> lastStateTime;
+
   /// \brief Indicator of whether any playback instance has ever been started
   public: static bool started;
 
@@ -150,6 +172,34 @@ void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
   _ecm.SetState(_msg);
 }
 
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::UpdateEntitiesToRemove(
+    const msgs::SerializedStateMap &_msg,
+    std::set<Entity> &_entitiesToRemove) const
+{
+  for (const auto &entIt : _msg.entities())
+  {
+    const auto &entityMsg = entIt.second;
+    Entity entity{entityMsg.id()};
+    if (entityMsg.remove())
+    {
+      _entitiesToRemove.insert(entity);
+    }
+    else
+    {
+      _entitiesToRemove.erase(entity);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration LogPlaybackPrivate::EndTime() const
+{
+  if (this->stateLog)
+    return this->stateLog->EndTime();
+  return this->log->EndTime();
+}
+
 //////////////////////////////////////////////////
 void LogPlayback::Configure(const Entity &,
     const std::shared_ptr<const sdf::Element> &_sdf,
@@ -206,56 +256,82 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
     return false;
   }
 
-  // Append file name
-  std::string dbPath = common::joinPaths(this->logPath, "state.tlog");
-  ignmsg << "Loading log file [" + dbPath + "]\n";
-  if (!common::exists(dbPath))
+  // Logs recorded with the "mmap" backend keep the state in their own file
+  std::string mlogPath = common::joinPaths(this->logPath, "state.mlog");
+  if (common::exists(mlogPath))
   {
-    ignerr << "Log path invalid. File [" << dbPath << "] "
-      << "does not exist. Nothing to play.\n";
-    return false;
-  }
+    ignmsg << "Loading state log file [" + mlogPath + "]\n";
+    this->stateLog = std::make_unique<MappedStateLogReader>();
+    if (!this->stateLog->Open(mlogPath))
+    {
+      ignerr << "Failed to open state log file [" << mlogPath << "]"
+             << std::endl;
+      this->stateLog.reset();
+      return false;
+    }
 
-  // Call Log.hh directly to load a .tlog file
-  this->log = std::make_unique<transport::log::Log>();
-  if (!this->log->Open(dbPath))
-  {
-    ignerr << "Failed to open log file [" << dbPath << "]" << std::endl;
+    // The first state sets the initial state of the world
+    msgs::SerializedStateMap msg;
+    if (this->stateLog->Message(0, msg))
+      this->Parse(_ecm, msg);
+    else
+      ignerr << "No states found in log file [" << mlogPath << "]" << std::endl;
   }
+  else
+  {
+    // Append file name
+    std::string dbPath = common::joinPaths(this->logPath, "state.tlog");
+    ignmsg << "Loading log file [" + dbPath + "]\n";
+    if (!common::exists(dbPath))
+    {
+      ignerr << "Log path invalid. File [" << dbPath << "] "
+        << "does not exist. Nothing to play.\n";
+      return false;
+    }
 
-  // Access all messages in .tlog file
-  this->batch = this->log->QueryMessages();
-  auto iter = this->batch.begin();
+    // Call Log.hh directly to load a .tlog file
+    this->log = std::make_unique<transport::log::Log>();
+    if (!this->log->Open(dbPath))
+    {
+      ignerr << "Failed to open log file [" << dbPath << "]" << std::endl;
+    }
 
-  if (iter == this->batch.end())
-  {
-    ignerr << "No messages found in log file [" << dbPath << "]" << std::endl;
-  }
+    // Access all messages in .tlog file
+    this->batch = this->log->QueryMessages();
+    auto iter = this->batch.begin();
 
-  // Look for the first SerializedState message and use it to set the initial
-  // state of the world. Messages received before this are ignored.
-  for (; iter != this->batch.end(); ++iter)
-  {
-    auto msgType = iter->Type();
-    if (msgType == "ignition.msgs.SerializedState")
+    if (iter == this->batch.end())
     {
-      msgs::SerializedState msg;
-      msg.ParseFromString(iter->Data());
-      this->Parse(_ecm, msg);
-      break;
+      ignerr << "No messages found in log file [" << dbPath << "]"
+             << std::endl;
     }
-    else if (msgType == "ignition.msgs.SerializedStateMap")
+
+    // Look for the first SerializedState message and use it to set the
+    // initial state of the world. Messages received before this are ignored.
+    for (; iter != this->batch.end(); ++iter)
     {
-      msgs::SerializedStateMap msg;
-      msg.ParseFromString(iter->Data());
-      this->Parse(_ecm, msg);
-      break;
+      auto msgType = iter->Type();
+      if (msgType == "ignition.msgs.SerializedState")
+      {
+        msgs::SerializedState msg;
+        msg.ParseFromString(iter->Data());
+        this->Parse(_ecm, msg);
+        break;
+      }
+      else if (msgType == "ignition.msgs.SerializedStateMap")
+      {
+        msgs::SerializedStateMap msg;
+        msg.ParseFromString(iter->Data());
+        this->Parse(_ecm, msg);
+        break;
+      }
     }
   }
 
   msgs::LogPlaybackStatistics logStats;
-  auto startTime = convert<msgs::Time>(this->log->StartTime());
-  auto endTime = convert<msgs::Time>(this->log->EndTime());
+  auto startTime = convert<msgs::Time>(this->stateLog ?
+      this->stateLog->StartTime() : this->log->StartTime());
+  auto endTime = convert<msgs::Time>(this->EndTime());
   logStats.mutable_start_time()->set_sec(startTime.sec());
   logStats.mutable_start_time()->set_nsec(startTime.nsec());
   logStats.mutable_end_time()->set_sec(endTime.sec());
@@ -485,78 +561,104 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
     startTime = std::chrono::steady_clock::duration::zero();
   }
 
-  this->dataPtr->batch = this->dataPtr->log->QueryMessages(
-      transport::log::AllTopics({startTime, endTime}));
-
-  auto iter = this->dataPtr->batch.begin();
-  while (iter != this->dataPtr->batch.end())
+  if (this->dataPtr->stateLog)
   {
-    auto msgType = iter->Type();
+    // Seek straight to the first state in the time range, without touching
+    // other iterations
+    const auto &stateLog = *this->dataPtr->stateLog;
+    if (seekRewind)
+      this->dataPtr->lastStateTime.reset();
+
+    // A state at the start of the range may have been applied at the end of
+    // the previous step's range, so only states after the last applied one
+    // are applied
+    auto i = stateLog.LowerBound(startTime);
+    while (this->dataPtr->lastStateTime && i < stateLog.Count() &&
+        stateLog.Time(i) <= *this->dataPtr->lastStateTime)
+    {
+      ++i;
+    }
 
-    if (msgType == "ignition.msgs.SerializedState")
+    msgs::SerializedStateMap msg;
+    for (; i < stateLog.Count() && stateLog.Time(i) <= endTime; ++i)
     {
-      msgs::SerializedState msg;
-      msg.ParseFromString(iter->Data());
+      this->dataPtr->lastStateTime = stateLog.Time(i);
 
-      // For seeking back in time only:
-      // While stepping, update the list of entities to be removed
-      // so we do not remove any entities that are to be created
-      if (seekRewind)
+      if (!stateLog.Message(i, msg))
       {
-        for (const auto &entIt : msg.entities())
-        {
-          Entity entity{entIt.id()};
-          if (entIt.remove())
-          {
-            entitiesToRemove.insert(entity);
-          }
-          else
-          {
-            entitiesToRemove.erase(entity);
-          }
-        }
+        ignwarn << "Failed to parse state [" << i << "] of state log."
+                << std::endl;
+        continue;
       }
 
+      if (seekRewind)
+        this->dataPtr->UpdateEntitiesToRemove(msg, entitiesToRemove);
+
       this->dataPtr->Parse(_ecm, msg);
+      this->dataPtr->ReplaceResourceURIs(_ecm);
     }
-    else if (msgType == "ignition.msgs.SerializedStateMap")
+  }
+  else
+  {
+    this->dataPtr->batch = this->dataPtr->log->QueryMessages(
+        transport::log::AllTopics({startTime, endTime}));
+
+    auto iter = this->dataPtr->batch.begin();
+    while (iter != this->dataPtr->batch.end())
     {
-      msgs::SerializedStateMap msg;
-      msg.ParseFromString(iter->Data());
+      auto msgType = iter->Type();
 
-      // For seeking back in time only:
-      // While stepping, update the list of entities to be removed
-      // so we do not remove any entities that are to be created
-      if (seekRewind)
+      if (msgType == "ignition.msgs.SerializedState")
       {
-        for (const auto &entIt : msg.entities())
+        msgs::SerializedState msg;
+        msg.ParseFromString(iter->Data());
+
+        // For seeking back in time only:
+        // While stepping, update the list of entities to be removed
+        // so we do not remove any entities that are to be created
+        if (seekRewind)
         {
-          const auto &entityMsg = entIt.second;
-          Entity entity{entityMsg.id()};
-          if (entityMsg.remove())
-          {
-            entitiesToRemove.insert(entity);
-          }
-          else
+          for (const auto &entIt : msg.entities())
           {
-            entitiesToRemove.erase(entity);
+            Entity entity{entIt.id()};
+            if (entIt.remove())
+            {
+              entitiesToRemove.insert(entity);
+            }
+            else
+            {
+              entitiesToRemove.erase(entity);
+            }
           }
         }
+
+        this->dataPtr->Parse(_ecm, msg);
       }
+      else if (msgType == "ignition.msgs.SerializedStateMap")
+      {
+        msgs::SerializedStateMap msg;
+        msg.ParseFromString(iter->Data());
 
-      this->dataPtr->Parse(_ecm, msg);
-    }
-    else if (msgType == "ignition.msgs.StringMsg")
-    {
-      // Do nothing, we assume this is the SDF string
-    }
-    else
-    {
-      ignwarn << "Trying to playback unsupported message type ["
-              << msgType << "]" << std::endl;
+        // For seeking back in time only:
+        // While stepping, update the list of entities to be removed
+        // so we do not remove any entities that are to be created
+        if (seekRewind)
+          this->dataPtr->UpdateEntitiesToRemove(msg, entitiesToRemove);
+
+        this->dataPtr->Parse(_ecm, msg);
+      }
+      else if (msgType == "ignition.msgs.StringMsg")
+      {
+        // Do nothing, we assume this is the SDF string
+      }
+      else
+      {
+        ignwarn << "Trying to playback unsupported message type ["
+                << msgType << "]" << std::endl;
+      }
+      this->dataPtr->ReplaceResourceURIs(_ecm);
+      ++iter;
     }
-    this->dataPtr->ReplaceResourceURIs(_ecm);
-    ++iter;
   }
 
     // particle emitters
@@ -592,11 +694,11 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   }
 
   // pause playback if end of log is reached
-  if (_info.simTime >= this->dataPtr->log->EndTime())
+  if (_info.simTime >= this->dataPtr->EndTime())
   {
     ignmsg << "End of log file reached. Time: " <<
       std::chrono::duration_cast<std::chrono::seconds>(
-      this->dataPtr->log->EndTime()).count() << " seconds" << std::endl;
+      this->dataPtr->EndTime()).count() << " seconds" << std::endl;
 
     this->dataPtr->eventManager->Emit<events::Pause>(true);
   }
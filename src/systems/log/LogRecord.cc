@@ -20,11 +20,35 @@
 #include <sys/stat.h>
 #include <ignition/msgs/stringmsg.pb.h>
 
+#ifndef __APPLE__
+  #if (defined(_MSVC_LANG))
+    #if (_MSVC_LANG >= 201703L || __cplusplus >= 201703L)
+      #include <filesystem>  // c++17
+    #else
+      #define _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
+      #include <experimental/filesystem>
+    #endif
+  #elif __GNUC__ < 8
+    #include <experimental/filesystem>
+  #else
+    #include <filesystem>
+  #endif
+#endif
+
+#include <condition_variable>
 #include <string>
+#include <deque>
 #include <fstream>
 #include <ctime>
 #include <set>
 #include <list>
+#include <mutex>
+#include <regex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
@@ -48,6 +72,7 @@
 #include <sdf/Visual.hh>
 #include <sdf/World.hh>
 
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Light.hh"
 #include "ignition/gazebo/components/Link.hh"
@@ -58,12 +83,55 @@
 #include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "ignition/gazebo/LogQuery.hh"
 #include "ignition/gazebo/Util.hh"
 
+#ifdef HAVE_ZLIB
+#include "LogArchive.hh"
+#endif
+#include "ignition/gazebo/MappedStateLog.hh"
+
 using namespace ignition;
 using namespace ignition::gazebo;
 using namespace ignition::gazebo::systems;
 
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Create a hard link to a file.
+  /// \param[in] _target Existing file.
+  /// \param[in] _link Path of the link to create.
+  /// \param[out] _error Reason of the failure, if any.
+  /// \return True if successful. Always false on macOS, where files are
+  /// copied instead.
+  bool HardLink(const std::string &_target, const std::string &_link,
+      std::string &_error)
+  {
+#ifndef __APPLE__
+  #if (defined(_MSVC_LANG))
+    #if (_MSVC_LANG >= 201703L || __cplusplus >= 201703L)
+    using namespace std::filesystem;
+    #else
+    using namespace std::experimental::filesystem;
+    #endif
+  #elif __GNUC__ < 8
+    using namespace std::experimental::filesystem;
+  #else
+    using namespace std::filesystem;
+  #endif
+    std::error_code ec;
+    create_hard_link(_target, _link, ec);
+    _error = ec.message();
+    return !ec;
+#else
+    (void)_target;
+    (void)_link;
+    _error = "hard links are not used on macOS";
+    return false;
+#endif
+  }
+}
+
 // Private data class.
 class ignition::gazebo::systems::LogRecordPrivate
 {
@@ -104,6 +172,80 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Compress model resource files and state file into one file.
   public: void CompressStateAndResources();
 
+  /// \brief Open the compressed file and start compressing the state into
+  /// it as it's recorded, in the mapped state log format. The state is also
+  /// written uncompressed to the log directory, so the log can be played
+  /// back if recording doesn't stop cleanly.
+  /// \param[in] _mlogPath Path of the uncompressed state log.
+  /// \return True if successful. If false, the log is compressed with
+  /// CompressStateAndResources once recording stops.
+  public: bool StartArchive(const std::string &_mlogPath);
+
+  /// \brief Finish compressing the state and add the rest of the recorded
+  /// files to the compressed file. The log directory is removed once the
+  /// compressed file is complete.
+  public: void FinishArchive();
+
+  /// \brief Stop compressing and close the compressed file, without adding
+  /// the rest of the recorded files.
+  public: void AbortArchive();
+
+  /// \brief Write the state chunks queued by stateStream to the state log
+  /// and compress them, until the stream is closed. Runs on compressThread.
+  public: void CompressStateChunks();
+
+  /// \brief Close the state stream and wait until all of it's compressed.
+  public: void StopCompressThread();
+
+  /// \brief Recursively copy a resource directory into the log directory.
+  /// Files whose content has already been recorded are hard linked to the
+  /// existing copy instead of being copied again.
+  /// \param[in] _src Source directory.
+  /// \param[in] _dest Destination directory, which must already exist.
+  /// \return True if all files were recorded successfully.
+  public: bool CopyResourceDirectory(const std::string &_src,
+      const std::string &_dest);
+
+  /// \brief Load the entity and component record filters from the plugin's
+  /// SDF.
+  public: void LoadFilters();
+
+  /// \brief Add new entities which pass the entity filters to the set of
+  /// recorded entities.
+  /// \param[in] _ecm Reference to an instance of entity component manager
+  public: void UpdateRecordedEntities(const EntityComponentManager &_ecm);
+
+  /// \brief Update the set of component types to be recorded in the current
+  /// iteration, taking into account the component filters and rates.
+  /// \param[in] _simTime Current simulation time.
+  /// \param[in] _ignoreRates True to record all component types regardless of
+  /// their rate, such as when new entities need their full state recorded.
+  public: void UpdateRecordedTypes(
+      const std::chrono::steady_clock::duration &_simTime, bool _ignoreRates);
+
+  /// \brief Rate limit for recording a component type
+  public: struct RateLimit
+  {
+    /// \brief Name of the component type
+    std::string name;
+
+    /// \brief Type of the component, or kComponentTypeIdInvalid while the
+    /// component hasn't been registered.
+    ComponentTypeId typeId{kComponentTypeIdInvalid};
+
+    /// \brief Minimum sim time between recordings
+    std::chrono::steady_clock::duration period{0};
+
+    /// \brief Last sim time the component type was recorded
+    std::chrono::steady_clock::duration lastRecorded{0};
+
+    /// \brief Whether the component type is recorded in this iteration
+    bool due{true};
+
+    /// \brief Whether the component type has been recorded at least once
+    bool recorded{false};
+  };
+
   /// \brief Indicator of whether any recorder instance has ever been started.
   /// Currently, only one instance is allowed. This enforcement may be removed
   /// in the future.
@@ -115,6 +257,40 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Ignition transport recorder
   public: transport::log::Recorder recorder;
 
+  /// \brief Writer for the state log, used instead of the recorder for the
+  /// state topic if the "mmap" state backend is chosen.
+  public: std::unique_ptr<MappedStateLogWriter> stateWriter;
+
+#ifdef HAVE_ZLIB
+  /// \brief Compressed file being written while recording, if compression
+  /// is enabled with the "mmap" state backend.
+  public: std::unique_ptr<LogArchiveWriter> archive;
+#endif
+
+  /// \brief Writer for the state log, used instead of stateWriter while
+  /// compressing into archive.
+  public: std::unique_ptr<StreamedStateLogWriter> stateStream;
+
+  /// \brief Uncompressed copy of the state compressed into archive, so
+  /// that it isn't lost if the compressed file can't be completed.
+  public: std::ofstream stateFile;
+
+  /// \brief Thread compressing the state chunks into archive, so that the
+  /// simulation thread only serializes states.
+  public: std::thread compressThread;
+
+  /// \brief State chunks waiting to be compressed.
+  public: std::deque<std::string> stateChunks;
+
+  /// \brief Protects stateChunks and stateStreamClosed.
+  public: std::mutex stateChunksMutex;
+
+  /// \brief Notified when stateChunks changes or the stream is closed.
+  public: std::condition_variable stateChunksCv;
+
+  /// \brief Whether the state stream has been closed.
+  public: bool stateStreamClosed{false};
+
   /// \brief Directory in which to place log file
   public: std::string logPath{""};
 
@@ -157,6 +333,38 @@ class ignition::gazebo::systems::LogRecordPrivate
 
   /// \brief List of saved models if record with resources is enabled.
   public: std::set<std::string> savedModels;
+
+  /// \brief Resource files already saved into the log directory, keyed by
+  /// their size and SHA-1 digest. Used to deduplicate identical files which
+  /// are used by different models.
+  public: std::unordered_map<std::string, std::string> savedResources;
+
+  /// \brief Patterns matched against entity names. If empty, all entities
+  /// are recorded.
+  public: std::vector<std::regex> entityPatterns;
+
+  /// \brief Entities which passed the entity filters. Only used if there
+  /// are entity patterns.
+  public: std::unordered_set<Entity> recordedEntities;
+
+  /// \brief Names of component types to be recorded. If empty, all
+  /// component types are recorded.
+  public: std::vector<std::string> componentNames;
+
+  /// \brief Type IDs of the component names which have already been
+  /// registered.
+  public: std::unordered_set<ComponentTypeId> componentWhitelist;
+
+  /// \brief Rate limits for each throttled component type.
+  public: std::vector<RateLimit> rateLimits;
+
+  /// \brief Component types to be recorded in the current iteration. Empty
+  /// means all types.
+  public: std::unordered_set<ComponentTypeId> recordedTypes;
+
+  /// \brief Number of registered component types the last time component
+  /// names were resolved.
+  public: size_t registeredTypeCount{0};
 };
 
 bool LogRecordPrivate::started{false};
@@ -187,10 +395,15 @@ LogRecord::~LogRecord()
   {
     // Use ign-transport directly
     this->dataPtr->recorder.Stop();
+    if (this->dataPtr->stateWriter)
+      this->dataPtr->stateWriter->Close();
 
-    if (this->dataPtr->compress)
+    if (this->dataPtr->stateStream)
+      this->dataPtr->FinishArchive();
+    else if (this->dataPtr->compress)
       this->dataPtr->CompressStateAndResources();
     this->dataPtr->savedModels.clear();
+    this->dataPtr->savedResources.clear();
 
     LogRecordPrivate::started = false;
     ignmsg << "Stopping recording" << std::endl;
@@ -212,6 +425,8 @@ void LogRecord::Configure(const Entity &_entity,
   this->dataPtr->compress = _sdf->Get<bool>("compress", false).first;
   this->dataPtr->cmpPath = _sdf->Get<std::string>("compress_path", "").first;
 
+  this->dataPtr->LoadFilters();
+
   // If plugin is specified in both the SDF tag and on command line, only
   //   activate one recorder.
   if (!LogRecordPrivate::started)
@@ -320,9 +535,50 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
 
   // Add default topics if no topics were specified.
   igndbg << "Recording default topic[" << sdfTopic << "].\n";
-  igndbg << "Recording default topic[" << stateTopic << "].\n";
   this->recorder.AddTopic(sdfTopic);
-  this->recorder.AddTopic(stateTopic);
+
+  auto backend = this->sdf->Get<std::string>("state_backend", "sqlite").first;
+  if (backend == "mmap")
+  {
+    std::string mlogPath = common::joinPaths(this->logPath, "state.mlog");
+    if (common::exists(mlogPath))
+    {
+      ignmsg << "Overwriting existing file [" << mlogPath << "]\n";
+      common::removeFile(mlogPath);
+    }
+
+    if (this->compress && this->StartArchive(mlogPath))
+    {
+      ignmsg << "Recording state to [" << mlogPath << "] and compressing "
+             << "it into [" << this->cmpPath << "]" << std::endl;
+    }
+    else
+    {
+      this->stateWriter = std::make_unique<MappedStateLogWriter>();
+      if (!this->stateWriter->Open(mlogPath))
+      {
+        ignerr << "Failed to open state log [" << mlogPath << "]. "
+               << "Recording state to [" << dbPath << "] instead."
+               << std::endl;
+        this->stateWriter.reset();
+      }
+      else
+      {
+        ignmsg << "Recording state to [" << mlogPath << "]" << std::endl;
+      }
+    }
+  }
+  else if (backend != "sqlite")
+  {
+    ignwarn << "Unknown state backend [" << backend << "]. Using [sqlite]."
+            << std::endl;
+  }
+
+  if (!this->stateWriter && !this->stateStream)
+  {
+    igndbg << "Recording default topic[" << stateTopic << "].\n";
+    this->recorder.AddTopic(stateTopic);
+  }
 
   // Get the topics to record, if any.
   if (this->sdf->HasElement("record_topic"))
@@ -365,7 +621,11 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
     return true;
   }
   else
+  {
+    if (this->stateStream)
+      this->AbortArchive();
     return false;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -584,7 +844,7 @@ bool LogRecordPrivate::SaveModels(const std::set<std::string> &_models)
 
       // Copy entire model directory
       if (!common::createDirectories(destPath) ||
-          !common::copyDirectory(srcPath, destPath))
+          !this->CopyResourceDirectory(srcPath, destPath))
       {
         ignerr << "Failed to copy model directory from [" << srcPath
                << "] to [" << destPath << "]" << std::endl;
@@ -608,6 +868,55 @@ bool LogRecordPrivate::SaveModels(const std::set<std::string> &_models)
   return !saveError;
 }
 
+//////////////////////////////////////////////////
+bool LogRecordPrivate::CopyResourceDirectory(const std::string &_src,
+    const std::string &_dest)
+{
+  bool result{true};
+  for (common::DirIter file(_src); file != common::DirIter(); ++file)
+  {
+    std::string current(*file);
+    std::string dest = common::joinPaths(_dest, common::basename(current));
+
+    if (common::isDirectory(current))
+    {
+      result = common::createDirectories(dest) &&
+          this->CopyResourceDirectory(current, dest) && result;
+      continue;
+    }
+
+    if (!common::isFile(current))
+      continue;
+
+    std::ifstream ifs(current, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(ifs)),
+        std::istreambuf_iterator<char>());
+    std::string key = std::to_string(content.size()) + ":" +
+        common::sha1(content);
+
+    auto it = this->savedResources.find(key);
+    if (it != this->savedResources.end())
+    {
+      std::string error;
+      if (HardLink(it->second, dest, error))
+        continue;
+
+      igndbg << "Failed to link [" << dest << "] to [" << it->second
+             << "]: " << error << ". Copying instead." << std::endl;
+    }
+
+    if (!common::copyFile(current, dest))
+    {
+      ignerr << "Failed to copy resource [" << current << "] to [" << dest
+             << "]" << std::endl;
+      result = false;
+      continue;
+    }
+    this->savedResources[key] = dest;
+  }
+  return result;
+}
+
 //////////////////////////////////////////////////
 void LogRecordPrivate::CompressStateAndResources()
 {
@@ -634,6 +943,343 @@ void LogRecordPrivate::CompressStateAndResources()
   }
 }
 
+//////////////////////////////////////////////////
+bool LogRecordPrivate::StartArchive(const std::string &_mlogPath)
+{
+#if defined(_WIN32) || !defined(HAVE_ZLIB)
+  (void)_mlogPath;
+  return false;
+#else
+  if (common::exists(this->cmpPath))
+  {
+    ignmsg << "Removing existing file [" << this->cmpPath << "].\n";
+    common::removeFile(this->cmpPath);
+  }
+
+  this->stateFile.open(_mlogPath, std::ios::binary | std::ios::trunc);
+  if (!this->stateFile.is_open())
+  {
+    ignwarn << "Failed to open state log [" << _mlogPath << "]." << std::endl;
+    return false;
+  }
+
+  // Use the same layout as fuel_tools::Zip::Compress, which playback expects
+  std::string prefix = common::basename(this->logPath) + "/";
+  this->archive = std::make_unique<LogArchiveWriter>();
+  if (!this->archive->Open(this->cmpPath) ||
+      !this->archive->AddDirectory(prefix) ||
+      !this->archive->BeginEntry(prefix + "state.mlog"))
+  {
+    ignwarn << "Failed to start compressing into [" << this->cmpPath
+            << "]. The log will be compressed when recording stops."
+            << std::endl;
+    this->archive.reset();
+    this->stateFile.close();
+    common::removeFile(_mlogPath);
+    return false;
+  }
+
+  this->stateStreamClosed = false;
+  this->stateStream = std::make_unique<StreamedStateLogWriter>(
+      [this](std::string &&_chunk) -> bool
+      {
+        // Bound the memory used if compression falls behind
+        constexpr std::size_t kMaxPendingChunks{16u};
+        std::unique_lock<std::mutex> lock(this->stateChunksMutex);
+        this->stateChunksCv.wait(lock, [this]
+        {
+          return this->stateChunks.size() < kMaxPendingChunks;
+        });
+        this->stateChunks.push_back(std::move(_chunk));
+        this->stateChunksCv.notify_all();
+        return true;
+      });
+  this->compressThread =
+      std::thread(&LogRecordPrivate::CompressStateChunks, this);
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::CompressStateChunks()
+{
+  std::unique_lock<std::mutex> lock(this->stateChunksMutex);
+  while (true)
+  {
+    this->stateChunksCv.wait(lock, [this]
+    {
+      return !this->stateChunks.empty() || this->stateStreamClosed;
+    });
+    if (this->stateChunks.empty())
+      break;
+
+    std::string chunk = std::move(this->stateChunks.front());
+    this->stateChunks.pop_front();
+    this->stateChunksCv.notify_all();
+
+    lock.unlock();
+    // The uncompressed copy is flushed first, so it's readable up to the
+    // last chunk if the server is killed
+    this->stateFile.write(chunk.data(),
+        static_cast<std::streamsize>(chunk.size()));
+    this->stateFile.flush();
+#ifdef HAVE_ZLIB
+    this->archive->Write(chunk.data(), chunk.size());
+#endif
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::StopCompressThread()
+{
+  if (this->stateStream)
+  {
+    this->stateStream->Close();
+    this->stateStream.reset();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->stateChunksMutex);
+    this->stateStreamClosed = true;
+  }
+  this->stateChunksCv.notify_all();
+
+  if (this->compressThread.joinable())
+    this->compressThread.join();
+
+  this->stateFile.close();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::FinishArchive()
+{
+  this->StopCompressThread();
+  bool result = !this->stateFile.fail();
+
+#ifdef HAVE_ZLIB
+  // The state is already in the archive, add everything else recorded
+  std::string prefix = common::basename(this->logPath) + "/";
+  result = this->archive->EndEntry() && result;
+  result = this->archive->AddDirectoryTree(prefix, this->logPath,
+      {"state.mlog"}) && result;
+  result = this->archive->Close() && result;
+  this->archive.reset();
+#endif
+
+  if (result)
+  {
+    ignmsg << "Compressed log file and resources to [" << this->cmpPath
+           << "].\nRemoving recorded directory [" << this->logPath << "]."
+           << std::endl;
+    common::removeAll(this->logPath);
+  }
+  else
+  {
+    ignerr << "Failed to compress log file and resources to ["
+           << this->cmpPath << "]. Keeping recorded directory ["
+           << this->logPath << "]." << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::AbortArchive()
+{
+  this->StopCompressThread();
+#ifdef HAVE_ZLIB
+  this->archive->Close();
+  this->archive.reset();
+#endif
+  common::removeFile(this->cmpPath);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::LoadFilters()
+{
+  auto ptr = const_cast<sdf::Element *>(this->sdf.get());
+
+  if (ptr->HasElement("record_entity"))
+  {
+    auto elem = ptr->GetElement("record_entity");
+    while (elem)
+    {
+      auto pattern = elem->Get<std::string>();
+      try
+      {
+        this->entityPatterns.emplace_back(pattern);
+        igndbg << "Recording entities matching [" << pattern << "].\n";
+      }
+      catch (const std::regex_error &_e)
+      {
+        ignerr << "Invalid <record_entity> pattern [" << pattern << "]: "
+               << _e.what() << std::endl;
+      }
+      elem = elem->GetNextElement("record_entity");
+    }
+  }
+
+  if (ptr->HasElement("record_component"))
+  {
+    auto elem = ptr->GetElement("record_component");
+    while (elem)
+    {
+      auto name = elem->Get<std::string>();
+      if (!name.empty())
+      {
+        this->componentNames.push_back(name);
+        igndbg << "Recording component [" << name << "].\n";
+      }
+      elem = elem->GetNextElement("record_component");
+    }
+  }
+
+  if (ptr->HasElement("record_rate"))
+  {
+    auto elem = ptr->GetElement("record_rate");
+    while (elem)
+    {
+      RateLimit limit;
+      limit.name = elem->Get<std::string>("component", "").first;
+      auto rate = elem->Get<double>();
+      if (limit.name.empty() || rate <= 0.0)
+      {
+        ignerr << "<record_rate> needs a component attribute and a positive "
+               << "rate. Ignoring." << std::endl;
+      }
+      else
+      {
+        limit.period = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+        this->rateLimits.push_back(limit);
+        igndbg << "Recording component [" << limit.name << "] at [" << rate
+               << "] Hz.\n";
+      }
+      elem = elem->GetNextElement("record_rate");
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::UpdateRecordedEntities(
+    const EntityComponentManager &_ecm)
+{
+  if (this->entityPatterns.empty() || !_ecm.HasNewEntities())
+    return;
+
+  _ecm.EachNew<components::Name>(
+      [&](const Entity &_entity, const components::Name *_name) -> bool
+  {
+    if (this->recordedEntities.find(_entity) != this->recordedEntities.end())
+      return true;
+
+    // Always record the world so that global state is kept
+    if (_ecm.Component<components::World>(_entity) != nullptr)
+    {
+      this->recordedEntities.insert(_entity);
+      return true;
+    }
+
+    // Children inherit the inclusion of their parent, except for the world,
+    // which is recorded regardless of the filter
+    const auto parent = _ecm.ParentEntity(_entity);
+    bool record = _ecm.Component<components::World>(parent) == nullptr &&
+        this->recordedEntities.find(parent) != this->recordedEntities.end();
+    for (const auto &pattern : this->entityPatterns)
+    {
+      if (record)
+        break;
+      record = std::regex_match(_name->Data(), pattern);
+    }
+
+    // Record the whole subtree
+    if (record)
+    {
+      auto descendants = _ecm.Descendants(_entity);
+      this->recordedEntities.insert(descendants.begin(), descendants.end());
+    }
+    return true;
+  });
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::UpdateRecordedTypes(
+    const std::chrono::steady_clock::duration &_simTime, bool _ignoreRates)
+{
+  if (this->componentNames.empty() && this->rateLimits.empty())
+    return;
+
+  bool changed{false};
+
+  // Components may be registered at any time as plugins are loaded, so keep
+  // trying to resolve names which haven't been found yet.
+  auto registeredCount = components::Factory::Instance()->namesById.size();
+  if (registeredCount != this->registeredTypeCount)
+  {
+    this->registeredTypeCount = registeredCount;
+    changed = true;
+
+    this->componentWhitelist.clear();
+    for (const auto &name : this->componentNames)
+    {
+      auto typeId = LogQuery::ComponentTypeIdFromName(name);
+      if (typeId != kComponentTypeIdInvalid)
+        this->componentWhitelist.insert(typeId);
+    }
+
+    for (auto &limit : this->rateLimits)
+    {
+      if (limit.typeId == kComponentTypeIdInvalid)
+        limit.typeId = LogQuery::ComponentTypeIdFromName(limit.name);
+    }
+  }
+
+  bool allDue{true};
+  for (auto &limit : this->rateLimits)
+  {
+    bool due = _ignoreRates || !limit.recorded ||
+        _simTime - limit.lastRecorded >= limit.period ||
+        _simTime < limit.lastRecorded;
+    if (due)
+    {
+      limit.lastRecorded = _simTime;
+      limit.recorded = true;
+    }
+    if (due != limit.due)
+      changed = true;
+    limit.due = due;
+    allDue = allDue && due;
+  }
+
+  if (!changed)
+    return;
+
+  this->recordedTypes.clear();
+  if (!this->componentNames.empty())
+  {
+    this->recordedTypes = this->componentWhitelist;
+  }
+  else if (!allDue)
+  {
+    for (const auto &it : components::Factory::Instance()->namesById)
+      this->recordedTypes.insert(it.first);
+  }
+
+  for (const auto &limit : this->rateLimits)
+  {
+    if (!limit.due)
+      this->recordedTypes.erase(limit.typeId);
+  }
+
+  // An empty set means all types, so use an invalid type to record no
+  // components while still recording entity creation and removal.
+  if (this->recordedTypes.empty() &&
+      (!this->componentNames.empty() || !allDue))
+  {
+    this->recordedTypes.insert(kComponentTypeIdInvalid);
+  }
+}
+
 //////////////////////////////////////////////////
 void LogRecord::PreUpdate(const UpdateInfo &_info,
     EntityComponentManager &)
@@ -690,6 +1336,13 @@ void LogRecord::PostUpdate(const UpdateInfo &_info,
     }
   }
 
+  // Apply record filters
+  this->dataPtr->UpdateRecordedEntities(_ecm);
+
+  // New entities need all their components recorded so they can be
+  // recreated on playback
+  this->dataPtr->UpdateRecordedTypes(_info.simTime, _ecm.HasNewEntities());
+
   // TODO(louise) Use the SceneBroadcaster's topic once that publishes
   // the changed state
   // \todo(anyone) A potential enhancement here is have a keyframe mechanism
@@ -697,9 +1350,44 @@ void LogRecord::PostUpdate(const UpdateInfo &_info,
   // that. It would reduce some of the compute on replaying
   // (especially in tools like plotting or seeking through logs).
   msgs::SerializedStateMap stateMsg;
-  _ecm.ChangedState(stateMsg);
+  if (this->dataPtr->entityPatterns.empty() &&
+      this->dataPtr->recordedTypes.empty())
+  {
+    _ecm.ChangedState(stateMsg);
+  }
+  else
+  {
+    _ecm.ChangedState(stateMsg, this->dataPtr->recordedEntities,
+        this->dataPtr->recordedTypes);
+  }
   if (!stateMsg.entities().empty())
-    this->dataPtr->statePub.Publish(stateMsg);
+  {
+    if (this->dataPtr->stateWriter || this->dataPtr->stateStream)
+    {
+      if (this->dataPtr->stateWriter)
+        this->dataPtr->stateWriter->Append(_info.simTime, stateMsg);
+      else
+        this->dataPtr->stateStream->Append(_info.simTime, stateMsg);
+
+      // The state is only published for other subscribers
+      if (this->dataPtr->statePub.HasConnections())
+        this->dataPtr->statePub.Publish(stateMsg);
+    }
+    else
+    {
+      this->dataPtr->statePub.Publish(stateMsg);
+    }
+  }
+
+  if (!this->dataPtr->entityPatterns.empty())
+  {
+    _ecm.EachRemoved<components::Name>(
+        [&](const Entity &_entity, const components::Name *) -> bool
+    {
+      this->dataPtr->recordedEntities.erase(_entity);
+      return true;
+    });
+  }
 
   // If there are new models loaded, save meshes and textures
   if (this->dataPtr->RecordResources() && _ecm.HasNewEntities())
@@ -35,6 +35,47 @@ namespace systems
 
   /// \class LogRecord LogRecord.hh ignition/gazebo/systems/log/LogRecord.hh
   /// \brief Log state recorder
+  ///
+  /// By default, all changed components of all entities are recorded. The
+  /// following optional parameters can be used to reduce the amount of state
+  /// recorded. Filtering happens before state is serialized, so it also
+  /// reduces the cost of recording.
+  ///
+  /// <record_entity>    : Regular expression matched against entity names.
+  ///                      Only entities whose name, or whose ancestor's name,
+  ///                      matches are recorded. The world entity is always
+  ///                      recorded. Repeat to match multiple patterns.
+  /// <record_component> : Name of a component type to record, such as
+  ///                      `ign_gazebo_components.Pose`. The
+  ///                      `ign_gazebo_components.` prefix may be omitted.
+  ///                      When set, only the listed component types are
+  ///                      recorded. Repeat to record multiple types.
+  /// <record_rate>      : Maximum rate in Hz at which changes to the component
+  ///                      type given in the `component` attribute are
+  ///                      recorded, i.e.
+  ///                      `<record_rate component="Pose">30</record_rate>`.
+  ///                      Components that change on every iteration, such as
+  ///                      poses and joint states, have their latest value
+  ///                      recorded at that rate. One-time changes that happen
+  ///                      in between are not recorded, so this should only be
+  ///                      used for components which change periodically.
+  ///                      Repeat for multiple types.
+  /// <state_backend>    : Where the state is stored. `sqlite`, the default,
+  ///                      records the state topic into `state.tlog` together
+  ///                      with other topics. `mmap` writes the state straight
+  ///                      into an append-only memory-mapped `state.mlog`
+  ///                      file, which is cheaper to write at high rates and
+  ///                      can be seeked without parsing other iterations.
+  ///                      Only supported on POSIX systems.
+  ///
+  /// When the log is compressed with the `mmap` state backend, the state is
+  /// compressed into the `.zip` file on a separate thread as it's recorded,
+  /// and the other recorded files are added when recording stops. The state
+  /// is also written to `state.mlog` in the log directory, which is only
+  /// removed once the `.zip` file is complete, so the log can still be played
+  /// back if the server doesn't stop cleanly. With the `sqlite` backend, on
+  /// Windows, or if ign-gazebo was built without zlib, the whole log is
+  /// compressed when recording stops.
   class LogRecord:
     public System,
     public ISystemConfigure,
@@ -18,9 +18,12 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_PHYSICS_ENTITY_FEATURE_MAP_HH_
 #define IGNITION_GAZEBO_SYSTEMS_PHYSICS_ENTITY_FEATURE_MAP_HH_
 
+#include <cstddef>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <ignition/physics/Entity.hh>
 #include <ignition/physics/FindFeatures.hh>
@@ -43,6 +46,11 @@ namespace systems::physics_system
   // reference counts are properly zeroed out in the underlying physics engines
   // and the memory associated with the physics entities can be freed.
   //
+  // The physics entity is cast to all the optional feature lists once, when
+  // it's added. The results are kept in one array per feature list, indexed
+  // by a dense index per entity, so casting in the simulation loop is a
+  // single lookup, even when the engine doesn't support a feature.
+  //
   // DEV WARNING: There is an implicit conversion between physics EntityPtr and
   // std::size_t in ign-physics. This seems also implicitly convert between
   // EntityPtr and gazebo Entity. Therefore, any member function that takes a
@@ -76,17 +84,15 @@ namespace systems::physics_system
             using HasFeatureList =
                 std::disjunction<std::is_same<T, OptionalFeatureLists>...>;
 
-    /// \brief A tuple where the first element is an EntityPtr with made from
-    /// RequiredFeatureList and the remaining elements are made from
-    /// types in OptionalFeatureLists
-    private: using ValueType =
-                 std::tuple<RequiredEntityPtr,
-                            PhysicsEntityPtr<OptionalFeatureLists>...>;
+    /// \brief Array of physics entities with the features in T, indexed by
+    /// dense index
+    /// \tparam T A FeatureList in OptionalFeatureLists
+    private: template <typename T>
+    using CastArray = std::vector<PhysicsEntityPtr<T>>;
 
     /// \brief Helper function to cast from an entity type with minimum features
-    /// to an entity with a different set of features. When the entity is cast
-    /// successfully, it is added to an internal cache so that subsequent casts
-    /// will use the entity from the cache.
+    /// to an entity with a different set of features. All casts are resolved
+    /// when the entity is added, so this doesn't query the physics engine.
     /// \tparam ToFeatureList The list of features of the resulting entity.
     /// \param[in] _entity Gazebo entity.
     /// \return Physics entity with features in ToFeatureList. nullptr if the
@@ -107,34 +113,12 @@ namespace systems::physics_system
       }
       else
       {
-        using ToEntityPtr = PhysicsEntityPtr<ToFeatureList>;
-        // Has already been cast
-        auto castIt = this->castCache.find(_entity);
-        if (castIt != this->castCache.end())
-        {
-          auto castEntity = std::get<ToEntityPtr>(castIt->second);
-          if (nullptr != castEntity)
-          {
-            return castEntity;
-          }
-        }
-
-        auto reqEntity = this->Get(_entity);
-        if (nullptr == reqEntity)
+        auto it = this->denseIndex.find(_entity);
+        if (it == this->denseIndex.end())
         {
           return nullptr;
         }
-
-        // Cast
-        auto castEntity = physics::RequestFeatures<ToFeatureList>::From(
-            this->Get(_entity));
-
-        if (castEntity)
-        {
-          std::get<ToEntityPtr>(this->castCache[_entity]) = castEntity;
-        }
-
-        return castEntity;
+        return std::get<CastArray<ToFeatureList>>(this->casts)[it->second];
       }
     }
 
@@ -232,6 +216,40 @@ namespace systems::physics_system
       this->entityMap[_entity] = _physicsEntity;
       this->reverseMap[_physicsEntity] = _entity;
       this->physEntityById[_physicsEntity->EntityID()] = _physicsEntity;
+
+      // Resolve all optional features now, so they don't need to be requested
+      // from the physics engine every time they're used.
+      auto indexIt = this->denseIndex.find(_entity);
+      if (indexIt == this->denseIndex.end())
+      {
+        indexIt = this->denseIndex.emplace(_entity,
+            this->denseEntities.size()).first;
+        this->denseEntities.push_back(_entity);
+        (std::get<CastArray<OptionalFeatureLists>>(this->casts).emplace_back(),
+            ...);
+      }
+      const auto index = indexIt->second;
+      ((std::get<CastArray<OptionalFeatureLists>>(this->casts)[index] =
+          physics::RequestFeatures<OptionalFeatureLists>::From(
+              _physicsEntity)), ...);
+    }
+
+    /// \brief Reserve space for a number of entities, so that adding many
+    /// entities at once, such as when a world is loaded, doesn't rehash the
+    /// maps repeatedly.
+    /// \param[in] _count Total number of entities expected in the map.
+    public: void Reserve(std::size_t _count)
+    {
+      if (_count <= this->entityMap.size())
+        return;
+
+      this->entityMap.reserve(_count);
+      this->reverseMap.reserve(_count);
+      this->physEntityById.reserve(_count);
+      this->denseIndex.reserve(_count);
+      this->denseEntities.reserve(_count);
+      (std::get<CastArray<OptionalFeatureLists>>(this->casts).reserve(_count),
+          ...);
     }
 
     /// \brief Remove entity from all associated maps
@@ -244,7 +262,7 @@ namespace systems::physics_system
       {
         this->reverseMap.erase(it->second);
         this->physEntityById.erase(it->second->EntityID());
-        this->castCache.erase(_entity);
+        this->RemoveCasts(_entity);
         this->entityMap.erase(it);
         return true;
       }
@@ -261,13 +279,24 @@ namespace systems::physics_system
       {
         this->entityMap.erase(it->second);
         this->physEntityById.erase(it->first->EntityID());
-        this->castCache.erase(it->second);
+        this->RemoveCasts(it->second);
         this->reverseMap.erase(it);
         return true;
       }
       return false;
     }
 
+    /// \brief Remove all entities from all associated maps.
+    public: void Clear()
+    {
+      this->entityMap.clear();
+      this->reverseMap.clear();
+      this->physEntityById.clear();
+      this->denseIndex.clear();
+      this->denseEntities.clear();
+      (std::get<CastArray<OptionalFeatureLists>>(this->casts).clear(), ...);
+    }
+
     /// \brief Get the map from Gazebo entity to physics entities with required
     /// features
     /// \return Immumtable entity map
@@ -282,7 +311,32 @@ namespace systems::physics_system
     public: std::size_t TotalMapEntryCount() const
     {
       return this->entityMap.size() + this->reverseMap.size() +
-             this->castCache.size() + this->physEntityById.size();
+             this->denseIndex.size() + this->physEntityById.size();
+    }
+
+    /// \brief Remove the casts of an entity, moving the casts of the last
+    /// entity into its place so the arrays stay dense.
+    /// \param[in] _entity Gazebo entity.
+    private: void RemoveCasts(Entity _entity)
+    {
+      auto it = this->denseIndex.find(_entity);
+      if (it == this->denseIndex.end())
+        return;
+
+      const auto index = it->second;
+      const auto last = this->denseEntities.size() - 1;
+      if (index != last)
+      {
+        const auto lastEntity = this->denseEntities[last];
+        this->denseEntities[index] = lastEntity;
+        this->denseIndex[lastEntity] = index;
+        ((std::get<CastArray<OptionalFeatureLists>>(this->casts)[index] =
+            std::move(std::get<CastArray<OptionalFeatureLists>>(
+            this->casts)[last])), ...);
+      }
+      this->denseEntities.pop_back();
+      (std::get<CastArray<OptionalFeatureLists>>(this->casts).pop_back(), ...);
+      this->denseIndex.erase(it);
     }
 
     /// \brief Map from Gazebo entity to physics entities with required features
@@ -295,9 +349,15 @@ namespace systems::physics_system
     /// with required features
     private: std::unordered_map<std::size_t, RequiredEntityPtr> physEntityById;
 
-    /// \brief Cache map from Gazebo entity to physics entities with optional
-    /// features
-    private: mutable std::unordered_map<Entity, ValueType> castCache;
+    /// \brief Map from Gazebo entity to its dense index in the cast arrays
+    private: std::unordered_map<Entity, std::size_t> denseIndex;
+
+    /// \brief Gazebo entity at each dense index
+    private: std::vector<Entity> denseEntities;
+
+    /// \brief Physics entities with optional features, one array per feature
+    /// list. Entries are nullptr if the engine doesn't support the features.
+    private: std::tuple<CastArray<OptionalFeatureLists>...> casts;
   };
 
   /// \brief Convenience template that presets EntityFeatureMap with
@@ -122,10 +122,15 @@ TEST_F(EntityFeatureMapFixture,
   EXPECT_EQ(gazebo::kNullEntity, testMap.Get(testWorld1));
   EXPECT_EQ(0u, testMap.TotalMapEntryCount());
 
+  // Reserving space doesn't add entries
+  testMap.Reserve(2u);
+  EXPECT_EQ(0u, testMap.TotalMapEntryCount());
+
   testMap.AddEntity(gazeboWorld1Entity, testWorld1);
 
-  // After adding the entity, there should be one entry each in three maps
-  EXPECT_EQ(3u, testMap.TotalMapEntryCount());
+  // After adding the entity, there should be one entry each in four maps,
+  // since the casts are resolved when the entity is added
+  EXPECT_EQ(4u, testMap.TotalMapEntryCount());
   EXPECT_EQ(testWorld1, testMap.Get(gazeboWorld1Entity));
   EXPECT_EQ(gazeboWorld1Entity, testMap.Get(testWorld1));
 
@@ -133,7 +138,7 @@ TEST_F(EntityFeatureMapFixture,
   auto testWorld1Feature1 =
       testMap.EntityCast<TestOptionalFeatures1>(gazeboWorld1Entity);
   ASSERT_NE(nullptr, testWorld1Feature1);
-  // After the cast, there should be one more entry in the cache map.
+  // Casting doesn't add entries
   EXPECT_EQ(4u, testMap.TotalMapEntryCount());
 
   // Cast to optional feature2
@@ -147,14 +152,14 @@ TEST_F(EntityFeatureMapFixture,
   // Add another entity
   WorldPtrType testWorld2 = this->engine->ConstructEmptyWorld("world2");
   testMap.AddEntity(gazeboWorld2Entity, testWorld2);
-  EXPECT_EQ(7u, testMap.TotalMapEntryCount());
+  EXPECT_EQ(8u, testMap.TotalMapEntryCount());
   EXPECT_EQ(testWorld2, testMap.Get(gazeboWorld2Entity));
   EXPECT_EQ(gazeboWorld2Entity, testMap.Get(testWorld2));
 
   auto testWorld2Feature1 =
       testMap.EntityCast<TestOptionalFeatures1>(testWorld2);
   ASSERT_NE(nullptr, testWorld2Feature1);
-  // After the cast, there should be one more entry in the cache map.
+  // Casting doesn't add entries
   EXPECT_EQ(8u, testMap.TotalMapEntryCount());
 
   auto testWorld2Feature2 =
@@ -171,6 +176,13 @@ TEST_F(EntityFeatureMapFixture,
   EXPECT_EQ(gazebo::kNullEntity, testMap.Get(testWorld1));
   EXPECT_EQ(4u, testMap.TotalMapEntryCount());
 
+  // The remaining entity's casts are still valid after the first entity's
+  // casts were removed
+  EXPECT_EQ(testWorld2Feature1,
+      testMap.EntityCast<TestOptionalFeatures1>(gazeboWorld2Entity));
+  EXPECT_EQ(nullptr,
+      testMap.EntityCast<TestOptionalFeatures1>(gazeboWorld1Entity));
+
   testMap.Remove(testWorld2);
   EXPECT_FALSE(testMap.HasEntity(gazeboWorld2Entity));
   EXPECT_EQ(nullptr, testMap.Get(gazeboWorld2Entity));
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_PHYSICS_LINK_FRAME_DATA_BUFFER_HH_
+#define IGNITION_GAZEBO_SYSTEMS_PHYSICS_LINK_FRAME_DATA_BUFFER_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <ignition/physics/FrameData.hh>
+
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/config.hh"
+
+namespace ignition::gazebo
+{
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems::physics_system
+{
+  /// \brief Flat buffer of links that changed in a physics step, together
+  /// with their frame data, sorted by entity.
+  ///
+  /// Entity IDs are created in ascending order, so sorting by entity keeps
+  /// links in topological order, which is needed to update the poses of
+  /// nested models. The buffer is meant to be cleared and refilled on every
+  /// step, reusing its memory, instead of allocating a node per link in a
+  /// std::map.
+  class LinkFrameDataBuffer
+  {
+    /// \brief Frame data of a link relative to the world
+    public: using FrameData = ignition::physics::FrameData3d;
+
+    /// \brief A link and its frame data
+    public: using Entry = std::pair<Entity, FrameData>;
+
+    /// \brief Remove all entries, keeping the allocated memory.
+    public: void Clear()
+    {
+      this->entries.clear();
+    }
+
+    /// \brief Reserve memory for a number of entries.
+    /// \param[in] _size Number of entries.
+    public: void Reserve(std::size_t _size)
+    {
+      this->entries.reserve(_size);
+    }
+
+    /// \brief Append an entry without keeping the buffer sorted. Sort must be
+    /// called once all entries have been appended.
+    /// \param[in] _link Link entity. It must not be in the buffer yet.
+    /// \param[in] _data Frame data of the link.
+    public: void Append(const Entity _link, const FrameData &_data)
+    {
+      this->entries.emplace_back(_link, _data);
+    }
+
+    /// \brief Sort appended entries by entity.
+    public: void Sort()
+    {
+      std::sort(this->entries.begin(), this->entries.end(),
+          [](const Entry &_a, const Entry &_b)
+          {
+            return _a.first < _b.first;
+          });
+    }
+
+    /// \brief Find the frame data of a link.
+    /// \param[in] _link Link entity.
+    /// \return Pointer to the frame data, or nullptr if the link isn't in the
+    /// buffer. The pointer is invalidated by Insert, Append and Sort.
+    public: const FrameData *Find(const Entity _link) const
+    {
+      auto it = this->LowerBound(_link);
+      if (it == this->entries.end() || it->first != _link)
+        return nullptr;
+      return &it->second;
+    }
+
+    /// \brief Insert an entry, keeping the buffer sorted. This can be called
+    /// while iterating over the buffer by index. Links inserted after the
+    /// current index will be visited, and the index is adjusted if the link
+    /// is inserted before it.
+    /// \param[in] _link Link entity.
+    /// \param[in] _data Frame data of the link.
+    /// \param[in, out] _index Index of the entry currently being visited.
+    /// \return False if the link was already in the buffer.
+    public: bool Insert(const Entity _link, const FrameData &_data,
+                std::size_t &_index)
+    {
+      auto it = this->LowerBound(_link);
+      if (it != this->entries.end() && it->first == _link)
+        return false;
+
+      const auto pos = static_cast<std::size_t>(it - this->entries.begin());
+      this->entries.emplace(it, _link, _data);
+      if (pos <= _index)
+        ++_index;
+      return true;
+    }
+
+    /// \brief Number of entries.
+    /// \return Number of links in the buffer.
+    public: std::size_t Size() const
+    {
+      return this->entries.size();
+    }
+
+    /// \brief Whether the buffer is empty.
+    /// \return True if there are no entries.
+    public: bool Empty() const
+    {
+      return this->entries.empty();
+    }
+
+    /// \brief Access an entry by index.
+    /// \param[in] _index Index, must be smaller than Size().
+    /// \return The entry.
+    public: const Entry &operator[](std::size_t _index) const
+    {
+      return this->entries[_index];
+    }
+
+    /// \brief Iterator to the first entry.
+    /// \return Iterator.
+    public: std::vector<Entry>::const_iterator begin() const
+    {
+      return this->entries.begin();
+    }
+
+    /// \brief Iterator past the last entry.
+    /// \return Iterator.
+    public: std::vector<Entry>::const_iterator end() const
+    {
+      return this->entries.end();
+    }
+
+    /// \brief Find the first entry whose entity isn't smaller than a link.
+    /// \param[in] _link Link entity.
+    /// \return Iterator to the entry.
+    private: std::vector<Entry>::const_iterator LowerBound(
+                 const Entity _link) const
+    {
+      return std::lower_bound(this->entries.begin(), this->entries.end(),
+          _link, [](const Entry &_entry, const Entity _value)
+          {
+            return _entry.first < _value;
+          });
+    }
+
+    /// \brief Entries, sorted by entity.
+    private: std::vector<Entry> entries;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LinkFrameDataBuffer.hh"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace ignition;
+using namespace ignition::gazebo::systems::physics_system;
+
+/////////////////////////////////////////////////
+/// \brief Create frame data with the given X position
+LinkFrameDataBuffer::FrameData frameDataAtX(double _x)
+{
+  LinkFrameDataBuffer::FrameData data;
+  data.pose.translation() = Eigen::Vector3d(_x, 0, 0);
+  return data;
+}
+
+/////////////////////////////////////////////////
+TEST(LinkFrameDataBuffer, AppendSortFind)
+{
+  LinkFrameDataBuffer buffer;
+  EXPECT_TRUE(buffer.Empty());
+
+  buffer.Append(7u, frameDataAtX(7));
+  buffer.Append(3u, frameDataAtX(3));
+  buffer.Append(5u, frameDataAtX(5));
+  buffer.Sort();
+
+  ASSERT_EQ(3u, buffer.Size());
+  EXPECT_EQ(3u, buffer[0].first);
+  EXPECT_EQ(5u, buffer[1].first);
+  EXPECT_EQ(7u, buffer[2].first);
+
+  auto data = buffer.Find(5u);
+  ASSERT_NE(nullptr, data);
+  EXPECT_DOUBLE_EQ(5.0, data->pose.translation().x());
+  EXPECT_EQ(nullptr, buffer.Find(4u));
+  EXPECT_EQ(nullptr, buffer.Find(8u));
+
+  // Memory is kept, but entries are gone
+  buffer.Clear();
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(nullptr, buffer.Find(5u));
+}
+
+/////////////////////////////////////////////////
+TEST(LinkFrameDataBuffer, InsertWhileIterating)
+{
+  LinkFrameDataBuffer buffer;
+  buffer.Append(2u, frameDataAtX(2));
+  buffer.Append(6u, frameDataAtX(6));
+  buffer.Sort();
+
+  std::vector<gazebo::Entity> visited;
+  for (std::size_t i = 0u; i < buffer.Size(); ++i)
+  {
+    const auto entity = buffer[i].first;
+    if (entity == 6u)
+    {
+      // Inserted before the current entry, so not visited, and the index
+      // keeps pointing at the current entry
+      EXPECT_TRUE(buffer.Insert(1u, frameDataAtX(1), i));
+      EXPECT_EQ(6u, buffer[i].first);
+
+      // Inserted after the current entry, so visited
+      EXPECT_TRUE(buffer.Insert(9u, frameDataAtX(9), i));
+      EXPECT_EQ(6u, buffer[i].first);
+
+      // Already there
+      EXPECT_FALSE(buffer.Insert(2u, frameDataAtX(0), i));
+    }
+    visited.push_back(entity);
+  }
+
+  EXPECT_EQ((std::vector<gazebo::Entity>{2u, 6u, 9u}), visited);
+
+  ASSERT_EQ(4u, buffer.Size());
+  EXPECT_EQ(1u, buffer[0].first);
+  EXPECT_EQ(2u, buffer[1].first);
+  EXPECT_EQ(6u, buffer[2].first);
+  EXPECT_EQ(9u, buffer[3].first);
+
+  // The entry which was already there wasn't overwritten
+  EXPECT_DOUBLE_EQ(2.0, buffer.Find(2u)->pose.translation().x());
+}
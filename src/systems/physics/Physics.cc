@@ -23,11 +23,15 @@
 #include <ignition/msgs/Utility.hh>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
-#include <deque>
-#include <map>
+#include <limits>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -129,6 +133,7 @@
 #include "ignition/gazebo/components/PoseCmd.hh"
 #include "ignition/gazebo/components/Recreate.hh"
 #include "ignition/gazebo/components/SelfCollide.hh"
+#include "ignition/gazebo/components/Sleeping.hh"
 #include "ignition/gazebo/components/SlipComplianceCmd.hh"
 #include "ignition/gazebo/components/Static.hh"
 #include "ignition/gazebo/components/ThreadPitch.hh"
@@ -140,6 +145,8 @@
 #include "ignition/gazebo/physics/Events.hh"
 
 #include "EntityFeatureMap.hh"
+#include "LinkFrameDataBuffer.hh"
+#include "WorkerThreads.hh"
 
 using namespace ignition;
 using namespace ignition::gazebo;
@@ -147,6 +154,78 @@ using namespace ignition::gazebo::systems;
 using namespace ignition::gazebo::systems::physics_system;
 namespace components = ignition::gazebo::components;
 
+/// \brief Minimum number of changed links each thread should write back
+/// when updating link states in parallel.
+static constexpr std::size_t kMinLinksPerThread{32u};
+
+/// \brief A component state change made while writing back link states, to
+/// be applied to the ECM once all threads are done.
+struct LinkStateChange
+{
+  /// \brief Entity whose component changed.
+  Entity entity;
+
+  /// \brief Type of the component.
+  ComponentTypeId type;
+
+  /// \brief New component state.
+  ComponentState state;
+};
+
+/// \brief Reset joint force, joint velocity and slip compliance commands.
+/// \param[in, out] _data Command data.
+static void resetCommand(std::vector<double> &_data)
+{
+  std::fill(_data.begin(), _data.end(), 0.0);
+}
+
+/// \brief Reset joint limits commands.
+/// \param[in, out] _data Command data.
+static void resetCommand(std::vector<math::Vector2d> &_data)
+{
+  _data.clear();
+}
+
+/// \brief Reset wrench commands.
+/// \param[in, out] _data Command data.
+static void resetCommand(msgs::Wrench &_data)
+{
+  _data.Clear();
+}
+
+/// \brief Reset linear and angular velocity commands.
+/// \param[in, out] _data Command data.
+static void resetCommand(math::Vector3d &_data)
+{
+  _data = math::Vector3d::Zero;
+}
+
+/// \brief Resets a command component in place when going out of scope.
+/// Commands are only valid for one step, so they're consumed by the same
+/// pass that applies them, whichever way it returns. This way command
+/// components are kept around for controllers to write to on the next step,
+/// without being removed and recreated, and without extra passes over all
+/// command components.
+template <typename CommandT>
+class ConsumedCommand
+{
+  /// \brief Constructor
+  /// \param[in] _command Command component, may be null.
+  public: explicit ConsumedCommand(CommandT *_command)
+      : command(_command)
+  {
+  }
+
+  /// \brief Destructor, resets the command.
+  public: ~ConsumedCommand()
+  {
+    if (nullptr != this->command)
+      resetCommand(this->command->Data());
+  }
+
+  /// \brief Command component
+  private: CommandT *command;
+};
 
 // Private data class.
 class ignition::gazebo::systems::PhysicsPrivate
@@ -191,6 +270,40 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \param[in] _ecm Constant reference to ECM.
   public: void CreatePhysicsEntities(const EntityComponentManager &_ecm);
 
+  /// \brief Reserve space in the entity maps for all entities which are new
+  /// in this step, so loading large worlds doesn't rehash the maps many
+  /// times while entities are created one by one.
+  /// \param[in] _ecm Constant reference to ECM.
+  public: void ReserveNewEntities(const EntityComponentManager &_ecm);
+
+  /// \brief Call a function for each new entity with the given components,
+  /// or for all of them if all physics entities must be recreated.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \param[in] _f Function to call, as for EntityComponentManager::Each.
+  public: template <typename... ComponentTypeTs, typename FunctionT>
+          void EachNewOrAll(const EntityComponentManager &_ecm,
+              FunctionT _f) const
+  {
+    if (this->recreateAll)
+      _ecm.Each<ComponentTypeTs...>(_f);
+    else
+      _ecm.EachNew<ComponentTypeTs...>(_f);
+  }
+
+  /// \brief Remove all models from the physics engine and forget about all
+  /// entities except worlds, so they're all created again from the ECM on
+  /// the next update.
+  public: void Reset();
+
+  /// \brief Get the top level model of an entity, using the top level model
+  /// already cached for its parent if available, instead of walking up the
+  /// entity tree.
+  /// \param[in] _entity Model, link, collision or joint entity.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \return The top level model, or kNullEntity if there isn't one.
+  public: Entity CachedTopLevelModel(const Entity _entity,
+              const EntityComponentManager &_ecm) const;
+
   /// \brief Create world entities
   /// \param[in] _ecm Constant reference to ECM.
   public: void CreateWorldEntities(const EntityComponentManager &_ecm);
@@ -230,34 +343,74 @@ class ignition::gazebo::systems::PhysicsPrivate
   public: ignition::physics::ForwardStep::Output Step(
               const std::chrono::steady_clock::duration &_dt);
 
+  /// \brief Re-apply the commands held from the last UpdatePhysics call.
+  public: void ApplyHeldCommands();
+
   /// \brief Get data of links that were updated in the latest physics step.
   /// \param[in] _ecm Mutable reference to ECM.
   /// \param[in] _updatedLinks Updated link poses from the latest physics step
   /// that were written to by the physics engine (some physics engines may
-  /// not write this data to ForwardStep::Output. If not, _ecm is used to get
-  /// this updated link pose data).
-  /// \return A map of gazebo link entities to their updated pose data.
-  /// std::map is used because canonical links must be in topological order
-  /// to ensure that nested models with multiple canonical links are updated
-  /// properly (models must be updated in topological order).
-  public: std::map<Entity, physics::FrameData3d> ChangedLinks(
-              EntityComponentManager &_ecm,
-              const ignition::physics::ForwardStep::Output &_updatedLinks);
+  /// not write this data to ForwardStep::Output. If not, the poses of all
+  /// non-static links are compared against the previous step).
+  /// \param[out] _linkFrameData Gazebo link entities and their updated pose
+  /// data, sorted by entity because canonical links must be in topological
+  /// order to ensure that nested models with multiple canonical links are
+  /// updated properly (models must be updated in topological order).
+  public: void ChangedLinks(EntityComponentManager &_ecm,
+              const ignition::physics::ForwardStep::Output &_updatedLinks,
+              LinkFrameDataBuffer &_linkFrameData);
+
+  /// \brief Update the AxisAlignedBox components of models which haven't been
+  /// computed yet, whose top level model moved since they were last
+  /// computed, or whose box was changed by another system.
+  /// \param[in] _ecm Mutable reference to ECM.
+  /// \param[in] _simTime Current sim time, used to throttle updates.
+  public: void UpdateBoundingBoxes(EntityComponentManager &_ecm,
+              const std::chrono::steady_clock::duration &_simTime);
+
+  /// \brief Rebuild trackedLinks and trackedModels from the ECM if links or
+  /// models were added or removed.
+  /// \param[in] _ecm The entity component manager.
+  public: void UpdateTrackedLinks(const EntityComponentManager &_ecm);
+
+  /// \brief Mark links which haven't moved for sleepIdleSteps, and models
+  /// whose top-level model has no links awake, as sleeping. Wake them up as
+  /// soon as they move.
+  /// \param[in] _ecm Mutable reference to ECM.
+  /// \param[in] _changedLinks Links which moved in the latest step.
+  /// \param[in] _paused Whether simulation is paused. Links don't fall
+  /// asleep while paused, but may be woken up.
+  public: void UpdateSleeping(EntityComponentManager &_ecm,
+              const LinkFrameDataBuffer &_changedLinks, bool _paused);
+
+  /// \brief Whether updating a component of an entity attached to a link
+  /// can be skipped because the link is sleeping and the component was
+  /// already updated after the link fell asleep, and the entity's pose
+  /// hasn't changed since.
+  /// \param[in] _ecm The entity component manager.
+  /// \param[in] _entity Entity attached to the link, such as a collision.
+  /// \param[in] _link The link.
+  /// \param[in] _type Type of the component to be updated.
+  /// \return True if the update can be skipped.
+  public: bool SkipSleepingChild(const EntityComponentManager &_ecm,
+              const Entity _entity, const Entity _link,
+              const ComponentTypeId _type);
 
   /// \brief Helper function to update the pose of a model.
   /// \param[in] _model The model to update.
   /// \param[in] _canonicalLink The canonical link of _model.
   /// \param[in] _ecm The entity component manager.
   /// \param[in, out] _linkFrameData Links that experienced a pose change in the
-  /// most recent physics step. The key is the entity of the link, and the
-  /// value is the updated frame data corresponding to that entity. The
+  /// most recent physics step, with their updated frame data. The
   /// canonical links of _model's nested models are added to _linkFrameData to
   /// ensure that all of _model's nested models are marked as models to be
   /// updated (if a parent model's pose changes, all nested model poses must be
   /// updated since nested model poses are saved w.r.t. the parent model).
+  /// \param[in, out] _index Index of _canonicalLink in _linkFrameData, which
+  /// is kept pointing at it when links are inserted.
   public: void UpdateModelPose(const Entity _model,
               const Entity _canonicalLink, EntityComponentManager &_ecm,
-              std::map<Entity, physics::FrameData3d> &_linkFrameData);
+              LinkFrameDataBuffer &_linkFrameData, std::size_t &_index);
 
   /// \brief Get an entity's frame data relative to world from physics.
   /// \param[in] _entity The entity.
@@ -270,10 +423,23 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \brief Update components from physics simulation
   /// \param[in] _ecm Mutable reference to ECM.
   /// \param[in, out] _linkFrameData Links that experienced a pose change in the
-  /// most recent physics step. The key is the entity of the link, and the
-  /// value is the updated frame data corresponding to that entity.
+  /// most recent physics step, with their updated frame data.
   public: void UpdateSim(EntityComponentManager &_ecm,
-              std::map<Entity, physics::FrameData3d> &_linkFrameData);
+              LinkFrameDataBuffer &_linkFrameData);
+
+  /// \brief Write back the local pose, velocities and accelerations of a
+  /// link to its components. This doesn't change the ECM's structure, so
+  /// links of different top-level models can be updated from different
+  /// threads.
+  /// \param[in] _entity The link entity.
+  /// \param[in] _frameData Frame data of the link from the physics engine.
+  /// \param[in] _ecm Mutable reference to ECM.
+  /// \param[out] _changes Component state changes to be applied to the ECM
+  /// by the caller.
+  public: void UpdateLinkState(const Entity _entity,
+              const physics::FrameData3d &_frameData,
+              EntityComponentManager &_ecm,
+              std::vector<LinkStateChange> &_changes) const;
 
   /// \brief Update collision components from physics simulation
   /// \param[in] _ecm Mutable reference to ECM.
@@ -306,13 +472,88 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// The key is an entity and the value is its top level model.
   public: std::unordered_map<Entity, Entity> topLevelModelMap;
 
+  /// \brief Changed links grouped by top-level model, in topological order
+  /// within each group. Kept across steps to reuse the allocations.
+  public: std::vector<std::vector<
+              std::pair<Entity, const physics::FrameData3d *>>> linkPartitions;
+
+  /// \brief Index into linkPartitions of each top-level model with changed
+  /// links in the current step.
+  public: std::unordered_map<Entity, std::size_t> linkPartitionIndex;
+
+  /// \brief Component state changes recorded by each thread while writing
+  /// back link states.
+  public: std::vector<std::vector<LinkStateChange>> linkStateChanges;
+
+  /// \brief Threads which write back link states in parallel. They're kept
+  /// across steps.
+  public: WorkerThreads writeBackThreads;
+
+  /// \brief Joints with a JointPositionReset consumed in the current step,
+  /// to be removed at the end of it.
+  public: std::vector<Entity> jointPositionResetsToRemove;
+
+  /// \brief Joints with a JointVelocityReset consumed in the current step,
+  /// to be removed at the end of it.
+  public: std::vector<Entity> jointVelocityResetsToRemove;
+
   /// \brief Keep track of what entities are static (models and links).
   public: std::unordered_set<Entity> staticEntities;
 
-  /// \brief Keep track of poses for links attached to non-static models.
-  /// This allows for skipping pose updates if a link's pose didn't change
-  /// after a physics step.
-  public: std::unordered_map<Entity, ignition::math::Pose3d> linkWorldPoses;
+  /// \brief A link attached to a non-static model, whose pose is checked
+  /// for changes after each step if the physics engine doesn't report which
+  /// links moved.
+  public: struct TrackedLink
+  {
+    /// \brief Link entity
+    Entity entity;
+
+    /// \brief Link in the physics engine
+    LinkPtrType link;
+
+    /// \brief World pose of the link after the last step it was reported as
+    /// changed, or nullopt if it hasn't been reported yet.
+    std::optional<math::Pose3d> worldPose;
+
+    /// \brief Index in trackedModels of the link's top-level model.
+    std::size_t topLevelIndex{std::numeric_limits<std::size_t>::max()};
+
+    /// \brief Number of consecutive steps in which the link didn't move,
+    /// up to sleepIdleSteps.
+    unsigned int idleSteps{0u};
+
+    /// \brief Whether the link is marked as sleeping.
+    bool sleeping{false};
+  };
+
+  /// \brief A model which isn't static, used to mark models as sleeping.
+  public: struct TrackedModel
+  {
+    /// \brief Model entity
+    Entity entity;
+
+    /// \brief Index in trackedModels of the model's top-level model.
+    std::size_t topLevelIndex{std::numeric_limits<std::size_t>::max()};
+
+    /// \brief Whether the model is marked as sleeping.
+    bool sleeping{false};
+  };
+
+  /// \brief Models which aren't static, in creation order.
+  public: std::vector<TrackedModel> trackedModels;
+
+  /// \brief Links attached to non-static models, in creation order. Keeping
+  /// their poses here allows for skipping pose updates if a link's pose
+  /// didn't change after a physics step, without going through the ECM.
+  public: std::vector<TrackedLink> trackedLinks;
+
+  /// \brief Whether links were added or removed since trackedLinks was
+  /// built.
+  public: bool trackedLinksDirty{true};
+
+  /// \brief Links that changed in the latest step. Kept across steps to
+  /// reuse its memory.
+  public: LinkFrameDataBuffer changedLinks;
 
   /// \brief Keep a mapping of canonical links to models that have this
   /// canonical link. Useful for updating model poses efficiently after a
@@ -338,6 +579,10 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \brief used to store whether physics objects have been created.
   public: bool initialized = false;
 
+  /// \brief Whether all entities should be created on the next update, not
+  /// only new ones, such as after a reset.
+  public: bool recreateAll{false};
+
   /// \brief Pointer to the underlying ign-physics Engine entity.
   public: EnginePtrType engine = nullptr;
 
@@ -687,9 +932,121 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// of joints. This also lets us suppress some invalid error messages.
   public: std::set<Entity> jointAddedToModel;
 
+  /// \brief Number of physics engine steps per simulation iteration.
+  public: unsigned int substeps{1u};
+
+  /// \brief Joint command held across substeps.
+  public: struct HeldJointCommand
+  {
+    /// \brief Joint entity
+    Entity joint{kNullEntity};
+
+    /// \brief Index of the first value in HeldCommands::jointValues
+    std::size_t offset{0u};
+
+    /// \brief Number of values, one per degree of freedom
+    std::size_t count{0u};
+  };
+
+  /// \brief Commands applied by UpdatePhysics in the current iteration,
+  /// which are re-applied before each substep after the first one. They're
+  /// only recorded when there's more than one substep, and the containers
+  /// keep their capacity across iterations.
+  public: struct HeldCommands
+  {
+    /// \brief Joint force commands
+    std::vector<HeldJointCommand> jointForces;
+
+    /// \brief Joint velocity commands
+    std::vector<HeldJointCommand> jointVelocities;
+
+    /// \brief Values of all joint commands
+    std::vector<double> jointValues;
+
+    /// \brief Link entity, and the world force and torque applied to it
+    std::vector<std::tuple<Entity, math::Vector3d, math::Vector3d>>
+        linkWrenches;
+
+    /// \brief Model or link entity of a free group, and its world linear
+    /// velocity
+    std::vector<std::pair<Entity, math::Vector3d>> linearVelocities;
+
+    /// \brief Model or link entity of a free group, and its world angular
+    /// velocity
+    std::vector<std::pair<Entity, math::Vector3d>> angularVelocities;
+  };
+
+  /// \brief Commands held across substeps
+  public: HeldCommands heldCommands;
+
   /// \brief Flag to store whether the names of colliding entities should
   /// be populated in the contact points.
   public: bool contactsEntityNames = true;
+
+  /// \brief Maximum number of contact points reported per pair of
+  /// collisions. Zero means there's no limit.
+  public: std::size_t maxContactsPerPair{0u};
+
+  /// \brief A contact point from the point of view of one of the collisions.
+  public: struct CollisionContact
+  {
+    /// \brief Collision whose contacts are being reported.
+    Entity collision1;
+
+    /// \brief The other collision.
+    Entity collision2;
+
+    /// \brief Order in which the engine reported the contact.
+    std::size_t order;
+
+    /// \brief Contact point in the world frame.
+    math::Vector3d point;
+  };
+
+  /// \brief Contacts from the last step, sorted by collision. Kept across
+  /// steps to reuse its memory.
+  public: std::vector<CollisionContact> collisionContacts;
+
+  /// \brief Message reused to build the contacts of each collision.
+  public: msgs::Contacts contactsMsg;
+
+  /// \brief Models whose AxisAlignedBox has been computed, with the box
+  /// which was written to the component, to tell whether another system
+  /// changed it since.
+  public: std::unordered_map<Entity, math::AxisAlignedBox> boundingBoxModels;
+
+  /// \brief Top level models which moved since bounding boxes were last
+  /// updated.
+  public: std::unordered_set<Entity> boundingBoxDirtyModels;
+
+  /// \brief Minimum sim time between bounding box updates. Zero to update
+  /// on every iteration.
+  public: std::chrono::steady_clock::duration boundingBoxPeriod{0};
+
+  /// \brief Sim time of the last bounding box update.
+  public: std::optional<std::chrono::steady_clock::duration>
+      lastBoundingBoxUpdate;
+
+  /// \brief Whether links and models at rest are marked with
+  /// components::Sleeping.
+  public: bool sleepingEnabled{false};
+
+  /// \brief Number of steps a link must go without moving before it's
+  /// marked as sleeping.
+  public: unsigned int sleepIdleSteps{50u};
+
+  /// \brief Links which are currently marked as sleeping.
+  public: std::unordered_set<Entity> sleepingLinks;
+
+  /// \brief Entities attached to sleeping links whose components have been
+  /// updated since their link fell asleep, per component type. These don't
+  /// need to be updated again until the link wakes up.
+  public: std::unordered_map<ComponentTypeId, std::unordered_set<Entity>>
+              sleepingSynced;
+
+  /// \brief Whether the top-level model at each index of trackedModels has
+  /// any link awake in the current step. Kept to reuse its memory.
+  public: std::vector<char> topLevelAwake;
 };
 
 //////////////////////////////////////////////////
@@ -742,6 +1099,58 @@ void Physics::Configure(const Entity &_entity,
   {
     this->dataPtr->contactsEntityNames = contactsElement->Get<bool>(
       "include_entity_names", true).first;
+
+    auto maxContacts = contactsElement->Get<int>(
+      "max_contacts_per_pair", 0).first;
+    if (maxContacts < 0)
+    {
+      ignerr << "<max_contacts_per_pair> must not be negative, got ["
+             << maxContacts << "]. Contacts won't be limited." << std::endl;
+      maxContacts = 0;
+    }
+    this->dataPtr->maxContactsPerPair = static_cast<std::size_t>(maxContacts);
+  }
+
+  // Check if bounding boxes should be updated at a lower rate
+  auto boundingBoxesElement = _sdf->FindElement("bounding_boxes");
+  if (boundingBoxesElement && boundingBoxesElement->HasElement("update_rate"))
+  {
+    auto rate = boundingBoxesElement->Get<double>("update_rate");
+    if (rate > 0.0)
+    {
+      this->dataPtr->boundingBoxPeriod = std::chrono::duration_cast<
+          std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / rate));
+    }
+    else
+    {
+      ignerr << "<bounding_boxes><update_rate> must be positive, got ["
+             << rate << "]. Bounding boxes will be updated on every "
+             << "iteration." << std::endl;
+    }
+  }
+
+  // Check if physics should take multiple steps per iteration
+  if (_sdf->HasElement("substeps"))
+  {
+    auto substeps = _sdf->Get<int>("substeps");
+    if (substeps < 1)
+    {
+      ignerr << "<substeps> must be at least 1, got [" << substeps
+             << "]. Using 1." << std::endl;
+      substeps = 1;
+    }
+    this->dataPtr->substeps = static_cast<unsigned int>(substeps);
+  }
+
+  // Check if links and models at rest should be marked as sleeping
+  auto sleepingElement = _sdf->FindElement("sleeping");
+  if (sleepingElement)
+  {
+    this->dataPtr->sleepingEnabled = true;
+    this->dataPtr->sleepIdleSteps = std::max(1u,
+        sleepingElement->Get<unsigned int>("idle_steps",
+        this->dataPtr->sleepIdleSteps).first);
   }
 
   // Find engine shared library
@@ -848,13 +1257,17 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   {
     this->dataPtr->CreatePhysicsEntities(_ecm);
     this->dataPtr->UpdatePhysics(_ecm);
+    this->dataPtr->UpdateBoundingBoxes(_ecm, _info.simTime);
     ignition::physics::ForwardStep::Output stepOutput;
     // Only step if not paused.
     if (!_info.paused)
     {
       stepOutput = this->dataPtr->Step(_info.dt);
     }
-    auto changedLinks = this->dataPtr->ChangedLinks(_ecm, stepOutput);
+    auto &changedLinks = this->dataPtr->changedLinks;
+    this->dataPtr->ChangedLinks(_ecm, stepOutput, changedLinks);
+    if (this->dataPtr->sleepingEnabled)
+      this->dataPtr->UpdateSleeping(_ecm, changedLinks, _info.paused);
     this->dataPtr->UpdateSim(_ecm, changedLinks);
 
     // Entities scheduled to be removed should be removed from physics after the
@@ -864,6 +1277,53 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   }
 }
 
+//////////////////////////////////////////////////
+void Physics::Reset(const UpdateInfo &, EntityComponentManager &)
+{
+  IGN_PROFILE("Physics::Reset");
+  this->dataPtr->Reset();
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::Reset()
+{
+  // Nested models are removed along with their top level model
+  for (const auto &[model, topLevel] : this->topLevelModelMap)
+  {
+    if (model != topLevel)
+      continue;
+
+    if (auto modelPtrPhys = this->entityModelMap.Get(model))
+      modelPtrPhys->Remove();
+  }
+
+  this->entityModelMap.Clear();
+  this->entityLinkMap.Clear();
+  this->entityJointMap.Clear();
+  this->entityCollisionMap.Clear();
+  this->entityFreeGroupMap.Clear();
+  this->topLevelModelMap.clear();
+  this->staticEntities.clear();
+  this->modelWorldPoses.clear();
+  this->entityOffMap.clear();
+  this->worldPoseCmdsToRemove.clear();
+  this->jointPositionResetsToRemove.clear();
+  this->jointVelocityResetsToRemove.clear();
+  this->trackedModels.clear();
+  this->trackedLinks.clear();
+  this->trackedLinksDirty = true;
+  this->sleepingLinks.clear();
+  this->sleepingSynced.clear();
+  this->boundingBoxModels.clear();
+  this->boundingBoxDirtyModels.clear();
+  this->lastBoundingBoxUpdate.reset();
+
+  // Worlds and contact surface customizations are kept, since the entities
+  // are restored with the same IDs. Clearing keeps the capacity of the maps,
+  // so they don't need to be reserved again to recreate the entities.
+  this->recreateAll = true;
+}
+
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
 {
@@ -871,6 +1331,7 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
   this->linkAddedToModel.clear();
   this->jointAddedToModel.clear();
 
+  this->ReserveNewEntities(_ecm);
   this->CreateWorldEntities(_ecm);
   this->CreateModelEntities(_ecm);
   this->CreateLinkEntities(_ecm);
@@ -878,6 +1339,80 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
   this->CreateCollisionEntities(_ecm);
   this->CreateJointEntities(_ecm);
   this->CreateBatteryEntities(_ecm);
+
+  this->recreateAll = false;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::ReserveNewEntities(const EntityComponentManager &_ecm)
+{
+  // Only worth it when many entities are added at once, such as when the
+  // world is loaded
+  constexpr std::size_t kMinNewEntities{64u};
+
+  // Skip the counting passes in the usual iterations, where nothing is added
+  if (!_ecm.HasNewEntities())
+    return;
+
+  std::size_t newModels{0u};
+  _ecm.EachNew<components::Model>(
+      [&](const Entity &, const components::Model *) -> bool
+      {
+        ++newModels;
+        return true;
+      });
+
+  std::size_t newLinks{0u};
+  _ecm.EachNew<components::Link>(
+      [&](const Entity &, const components::Link *) -> bool
+      {
+        ++newLinks;
+        return true;
+      });
+
+  std::size_t newCollisions{0u};
+  _ecm.EachNew<components::Collision>(
+      [&](const Entity &, const components::Collision *) -> bool
+      {
+        ++newCollisions;
+        return true;
+      });
+
+  std::size_t newJoints{0u};
+  _ecm.EachNew<components::Joint>(
+      [&](const Entity &, const components::Joint *) -> bool
+      {
+        ++newJoints;
+        return true;
+      });
+
+  const auto newTotal = newModels + newLinks + newCollisions + newJoints;
+  if (newTotal < kMinNewEntities)
+    return;
+
+  IGN_PROFILE("PhysicsPrivate::ReserveNewEntities");
+  this->entityModelMap.Reserve(this->entityModelMap.Map().size() + newModels);
+  this->entityLinkMap.Reserve(this->entityLinkMap.Map().size() + newLinks);
+  this->entityCollisionMap.Reserve(
+      this->entityCollisionMap.Map().size() + newCollisions);
+  this->entityJointMap.Reserve(this->entityJointMap.Map().size() + newJoints);
+  this->topLevelModelMap.reserve(this->topLevelModelMap.size() + newTotal);
+}
+
+//////////////////////////////////////////////////
+Entity PhysicsPrivate::CachedTopLevelModel(const Entity _entity,
+    const EntityComponentManager &_ecm) const
+{
+  // Parents are created before their children, and an entity nested in a
+  // model has the same top level model as its parent
+  auto parentComp = _ecm.Component<components::ParentEntity>(_entity);
+  if (parentComp)
+  {
+    auto it = this->topLevelModelMap.find(parentComp->Data());
+    if (it != this->topLevelModelMap.end())
+      return it->second;
+  }
+  return topLevelModel(_entity, _ecm);
 }
 
 //////////////////////////////////////////////////
@@ -964,8 +1499,8 @@ void PhysicsPrivate::CreateWorldEntities(const EntityComponentManager &_ecm)
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreateModelEntities(const EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<components::Model, components::Name, components::Pose,
-            components::ParentEntity>(
+  this->EachNewOrAll<components::Model, components::Name, components::Pose,
+            components::ParentEntity>(_ecm,
       [&](const Entity &_entity,
           const components::Model *,
           const components::Name *_name,
@@ -1027,15 +1562,17 @@ void PhysicsPrivate::CreateModelEntities(const EntityComponentManager &_ecm)
             }
             auto modelPtrPhys = nestedModelFeature->ConstructNestedModel(model);
             this->entityModelMap.AddEntity(_entity, modelPtrPhys);
+            this->trackedLinksDirty = true;
             this->topLevelModelMap.insert(std::make_pair(_entity,
-                topLevelModel(_entity, _ecm)));
+                this->CachedTopLevelModel(_entity, _ecm)));
           }
           else
           {
             auto modelPtrPhys = worldPtrPhys->ConstructModel(model);
             this->entityModelMap.AddEntity(_entity, modelPtrPhys);
+            this->trackedLinksDirty = true;
             this->topLevelModelMap.insert(std::make_pair(_entity,
-                topLevelModel(_entity, _ecm)));
+                this->CachedTopLevelModel(_entity, _ecm)));
           }
         }
         // check if parent is a model (nested model)
@@ -1074,8 +1611,9 @@ void PhysicsPrivate::CreateModelEntities(const EntityComponentManager &_ecm)
             if (modelPtrPhys)
             {
               this->entityModelMap.AddEntity(_entity, modelPtrPhys);
+              this->trackedLinksDirty = true;
               this->topLevelModelMap.insert(std::make_pair(_entity,
-                  topLevelModel(_entity, _ecm)));
+                  this->CachedTopLevelModel(_entity, _ecm)));
             }
             else
             {
@@ -1099,8 +1637,8 @@ void PhysicsPrivate::CreateModelEntities(const EntityComponentManager &_ecm)
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreateLinkEntities(const EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<components::Link, components::Name, components::Pose,
-            components::ParentEntity>(
+  this->EachNewOrAll<components::Link, components::Name, components::Pose,
+            components::ParentEntity>(_ecm,
       [&](const Entity &_entity,
         const components::Link * /* _link */,
         const components::Name *_name,
@@ -1159,8 +1697,9 @@ void PhysicsPrivate::CreateLinkEntities(const EntityComponentManager &_ecm)
 
         auto linkPtrPhys = modelPtrPhys->ConstructLink(link);
         this->entityLinkMap.AddEntity(_entity, linkPtrPhys);
+        this->trackedLinksDirty = true;
         this->topLevelModelMap.insert(std::make_pair(_entity,
-            topLevelModel(_entity, _ecm)));
+            this->CachedTopLevelModel(_entity, _ecm)));
 
         return true;
       });
@@ -1169,9 +1708,9 @@ void PhysicsPrivate::CreateLinkEntities(const EntityComponentManager &_ecm)
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<components::Collision, components::Name, components::Pose,
-            components::Geometry, components::CollisionElement,
-            components::ParentEntity>(
+  this->EachNewOrAll<components::Collision, components::Name,
+            components::Pose, components::Geometry,
+            components::CollisionElement, components::ParentEntity>(_ecm,
       [&](const Entity &_entity,
           const components::Collision *,
           const components::Name *_name,
@@ -1360,7 +1899,7 @@ void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm)
         }
 
         this->topLevelModelMap.insert(std::make_pair(_entity,
-            topLevelModel(_entity, _ecm)));
+            this->CachedTopLevelModel(_entity, _ecm)));
         return true;
       });
 }
@@ -1368,10 +1907,10 @@ void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm)
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<components::Joint, components::Name, components::JointType,
-               components::Pose, components::ThreadPitch,
-               components::ParentEntity, components::ParentLinkName,
-               components::ChildLinkName>(
+  this->EachNewOrAll<components::Joint, components::Name,
+               components::JointType, components::Pose,
+               components::ThreadPitch, components::ParentEntity,
+               components::ParentLinkName, components::ChildLinkName>(_ecm,
       [&](const Entity &_entity,
           const components::Joint * /* _joint */,
           const components::Name *_name,
@@ -1459,13 +1998,13 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
           // the physics entity is valid
           this->entityJointMap.AddEntity(_entity, jointPtrPhys);
           this->topLevelModelMap.insert(std::make_pair(_entity,
-              topLevelModel(_entity, _ecm)));
+              this->CachedTopLevelModel(_entity, _ecm)));
         }
         return true;
       });
 
   // Detachable joints
-  _ecm.EachNew<components::DetachableJoint>(
+  this->EachNewOrAll<components::DetachableJoint>(_ecm,
       [&](const Entity &_entity,
           const components::DetachableJoint *_jointInfo) -> bool
       {
@@ -1543,7 +2082,7 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
                  << std::endl;
           this->entityJointMap.AddEntity(_entity, jointPtrPhys);
           this->topLevelModelMap.insert(std::make_pair(_entity,
-              topLevelModel(_entity, _ecm)));
+              this->CachedTopLevelModel(_entity, _ecm)));
         }
         else
         {
@@ -1591,7 +2130,7 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreateBatteryEntities(const EntityComponentManager &_ecm)
 {
-  _ecm.EachNew<components::BatterySoC>(
+  this->EachNewOrAll<components::BatterySoC>(_ecm,
       [&](const Entity & _entity, const components::BatterySoC *)->bool
       {
         // Parent entity of battery is model entity
@@ -1642,7 +2181,7 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
             this->entityLinkMap.Remove(childLink);
             this->topLevelModelMap.erase(childLink);
             this->staticEntities.erase(childLink);
-            this->linkWorldPoses.erase(childLink);
+            this->trackedLinksDirty = true;
             this->canonicalLinkModelTracker.RemoveLink(childLink);
           }
 
@@ -1657,6 +2196,7 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
           // Remove the model from the physics engine
           modelPtrPhys->Remove();
           this->entityModelMap.Remove(_entity);
+          this->trackedLinksDirty = true;
           this->topLevelModelMap.erase(_entity);
           this->staticEntities.erase(_entity);
           this->modelWorldPoses.erase(_entity);
@@ -1703,6 +2243,13 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
 void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 {
   IGN_PROFILE("PhysicsPrivate::UpdatePhysics");
+  this->heldCommands.jointForces.clear();
+  this->heldCommands.jointVelocities.clear();
+  this->heldCommands.jointValues.clear();
+  this->heldCommands.linkWrenches.clear();
+  this->heldCommands.linearVelocities.clear();
+  this->heldCommands.angularVelocities.clear();
+
   // Battery state
   _ecm.Each<components::BatterySoC>(
       [&](const Entity & _entity, const components::BatterySoC *_bat)
@@ -1719,6 +2266,30 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
       [&](const Entity &_entity, const components::Joint *,
           const components::Name *_name)
       {
+        auto force = _ecm.Component<components::JointForceCmd>(_entity);
+        auto velCmd = _ecm.Component<components::JointVelocityCmd>(_entity);
+        auto posLimits = _ecm.Component<components::JointPositionLimitsCmd>(
+            _entity);
+        auto velLimits = _ecm.Component<components::JointVelocityLimitsCmd>(
+            _entity);
+        auto effLimits = _ecm.Component<components::JointEffortLimitsCmd>(
+            _entity);
+        ConsumedCommand consumedForce(force);
+        ConsumedCommand consumedVelCmd(velCmd);
+        ConsumedCommand consumedPosLimits(posLimits);
+        ConsumedCommand consumedVelLimits(velLimits);
+        ConsumedCommand consumedEffLimits(effLimits);
+
+        // Reset components are removed at the end of the step
+        auto posReset = _ecm.Component<components::JointPositionReset>(
+            _entity);
+        auto velReset = _ecm.Component<components::JointVelocityReset>(
+            _entity);
+        if (posReset)
+          this->jointPositionResetsToRemove.push_back(_entity);
+        if (velReset)
+          this->jointVelocityResetsToRemove.push_back(_entity);
+
         auto jointPhys = this->entityJointMap.Get(_entity);
         if (nullptr == jointPhys)
           return true;
@@ -1764,8 +2335,6 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           return true;
         }
 
-        auto posLimits = _ecm.Component<components::JointPositionLimitsCmd>(
-            _entity);
         if (posLimits && !posLimits->Data().empty())
         {
           const auto& limits = posLimits->Data();
@@ -1795,8 +2364,6 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           }
         }
 
-        auto velLimits = _ecm.Component<components::JointVelocityLimitsCmd>(
-            _entity);
         if (velLimits && !velLimits->Data().empty())
         {
           const auto& limits = velLimits->Data();
@@ -1826,8 +2393,6 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           }
         }
 
-        auto effLimits = _ecm.Component<components::JointEffortLimitsCmd>(
-            _entity);
         if (effLimits && !effLimits->Data().empty())
         {
           const auto& limits = effLimits->Data();
@@ -1857,11 +2422,6 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           }
         }
 
-        auto posReset = _ecm.Component<components::JointPositionReset>(
-            _entity);
-        auto velReset = _ecm.Component<components::JointVelocityReset>(
-            _entity);
-
         // Reset the velocity
         if (velReset)
         {
@@ -1910,9 +2470,6 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
             }
         }
 
-        auto force = _ecm.Component<components::JointForceCmd>(_entity);
-        auto velCmd = _ecm.Component<components::JointVelocityCmd>(_entity);
-
         if (force)
         {
           if (force->Data().size() != jointPhys->GetDegreesOfFreedom())
@@ -1929,6 +2486,15 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           {
             jointPhys->SetForce(i, force->Data()[i]);
           }
+
+          if (this->substeps > 1u)
+          {
+            auto &values = this->heldCommands.jointValues;
+            this->heldCommands.jointForces.push_back(
+                {_entity, values.size(), nDofs});
+            values.insert(values.end(), force->Data().begin(),
+                force->Data().begin() + nDofs);
+          }
         }
         // Only set joint velocity if joint force is not set.
         // If both the cmd and reset components are found, cmd is ignored.
@@ -1970,6 +2536,15 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           {
             jointVelFeature->SetVelocityCommand(i, velocityCmd[i]);
           }
+
+          if (this->substeps > 1u)
+          {
+            auto &values = this->heldCommands.jointValues;
+            this->heldCommands.jointVelocities.push_back(
+                {_entity, values.size(), nDofs});
+            values.insert(values.end(), velocityCmd.begin(),
+                velocityCmd.begin() + nDofs);
+          }
         }
 
         return true;
@@ -1978,8 +2553,10 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
   // Link wrenches
   _ecm.Each<components::ExternalWorldWrenchCmd>(
       [&](const Entity &_entity,
-          const components::ExternalWorldWrenchCmd *_wrenchComp)
+          components::ExternalWorldWrenchCmd *_wrenchComp)
       {
+        ConsumedCommand consumed(_wrenchComp);
+
         if (!this->entityLinkMap.HasEntity(_entity))
         {
           ignwarn << "Failed to find link [" << _entity
@@ -2001,8 +2578,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
             informed = true;
           }
 
-          // Break Each call since no ExternalWorldWrenchCmd's can be processed
-          return false;
+          // Keep going so all wrenches are consumed
+          return true;
         }
 
         math::Vector3 force = msgs::Convert(_wrenchComp->Data().force());
@@ -2010,6 +2587,9 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         linkForceFeature->AddExternalForce(math::eigen3::convert(force));
         linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
 
+        if (this->substeps > 1u)
+          this->heldCommands.linkWrenches.emplace_back(_entity, force, torque);
+
         return true;
       });
 
@@ -2055,6 +2635,7 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 
         freeGroup->SetWorldPose(math::eigen3::convert(_poseCmd->Data() *
                                 linkPose));
+        this->boundingBoxDirtyModels.insert(_entity);
 
         // Process pose commands for static models here, as one-time changes
         if (this->staticEntities.find(_entity) != this->staticEntities.end())
@@ -2081,10 +2662,15 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
   }
 
   // Slip compliance on Collisions
+  bool slipComplianceSupported{true};
   _ecm.Each<components::SlipComplianceCmd>(
       [&](const Entity &_entity,
-          const components::SlipComplianceCmd *_slipCmdComp)
+          components::SlipComplianceCmd *_slipCmdComp)
       {
+        ConsumedCommand consumed(_slipCmdComp);
+        if (!slipComplianceSupported)
+          return true;
+
         if (!this->entityCollisionMap.HasEntity(_entity))
         {
           ignwarn << "Failed to find shape [" << _entity << "]." << std::endl;
@@ -2101,8 +2687,10 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
                   << "missing SetShapeFrictionPyramidSlipCompliance"
                   << std::endl;
 
-          // Break Each call since no SlipCompliances can be processed
-          return false;
+          // No SlipCompliances can be processed, but keep going so they're
+          // all consumed
+          slipComplianceSupported = false;
+          return true;
         }
 
         if (_slipCmdComp->Data().size() == 2)
@@ -2119,8 +2707,10 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
   // Update model angular velocity
   _ecm.Each<components::Model, components::AngularVelocityCmd>(
       [&](const Entity &_entity, const components::Model *,
-          const components::AngularVelocityCmd *_angularVelocityCmd)
+          components::AngularVelocityCmd *_angularVelocityCmd)
       {
+        ConsumedCommand consumed(_angularVelocityCmd);
+
         auto modelPtrPhys = this->entityModelMap.Get(_entity);
         if (nullptr == modelPtrPhys)
           return true;
@@ -2162,14 +2752,22 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 
         worldAngularVelFeature->SetWorldAngularVelocity(
             math::eigen3::convert(worldAngularVel));
+
+        if (this->substeps > 1u)
+        {
+          this->heldCommands.angularVelocities.emplace_back(
+              _entity, worldAngularVel);
+        }
         return true;
       });
 
   // Update model linear velocity
   _ecm.Each<components::Model, components::LinearVelocityCmd>(
       [&](const Entity &_entity, const components::Model *,
-          const components::LinearVelocityCmd *_linearVelocityCmd)
+          components::LinearVelocityCmd *_linearVelocityCmd)
       {
+        ConsumedCommand consumed(_linearVelocityCmd);
+
         auto modelPtrPhys = this->entityModelMap.Get(_entity);
         if (nullptr == modelPtrPhys)
           return true;
@@ -2213,14 +2811,21 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         worldLinearVelFeature->SetWorldLinearVelocity(
             math::eigen3::convert(worldLinearVel));
 
+        if (this->substeps > 1u)
+        {
+          this->heldCommands.linearVelocities.emplace_back(
+              _entity, worldLinearVel);
+        }
         return true;
       });
 
   // Update link angular velocity
   _ecm.Each<components::Link, components::AngularVelocityCmd>(
       [&](const Entity &_entity, const components::Link *,
-          const components::AngularVelocityCmd *_angularVelocityCmd)
+          components::AngularVelocityCmd *_angularVelocityCmd)
       {
+        ConsumedCommand consumed(_angularVelocityCmd);
+
         if (!this->entityLinkMap.HasEntity(_entity))
         {
           ignwarn << "Failed to find link [" << _entity
@@ -2265,14 +2870,21 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         worldAngularVelFeature->SetWorldAngularVelocity(
             math::eigen3::convert(worldAngularVel));
 
+        if (this->substeps > 1u)
+        {
+          this->heldCommands.angularVelocities.emplace_back(
+              _entity, worldAngularVel);
+        }
         return true;
       });
 
   // Update link linear velocity
   _ecm.Each<components::Link, components::LinearVelocityCmd>(
       [&](const Entity &_entity, const components::Link *,
-          const components::LinearVelocityCmd *_linearVelocityCmd)
+          components::LinearVelocityCmd *_linearVelocityCmd)
       {
+        ConsumedCommand consumed(_linearVelocityCmd);
+
         if (!this->entityLinkMap.HasEntity(_entity))
         {
           ignwarn << "Failed to find link [" << _entity
@@ -2317,17 +2929,87 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         worldLinearVelFeature->SetWorldLinearVelocity(
             math::eigen3::convert(worldLinearVel));
 
+        if (this->substeps > 1u)
+        {
+          this->heldCommands.linearVelocities.emplace_back(
+              _entity, worldLinearVel);
+        }
         return true;
       });
+}  // NOLINT readability/fn_size
+// TODO (azeey) Reduce size of function and remove the NOLINT above
 
-
-  // Populate bounding box info
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateBoundingBoxes(EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_simTime)
+{
   // Only compute bounding box if component exists to avoid unnecessary
   // computations
+  if (!_ecm.HasComponentType(components::AxisAlignedBox::typeId))
+    return;
+
+  IGN_PROFILE("PhysicsPrivate::UpdateBoundingBoxes");
+
+  // Boxes which were removed, or models which were created again, for
+  // example by a reset, need to be computed again
+  _ecm.EachRemoved<components::Model>(
+      [&](const Entity &_entity, const components::Model *) -> bool
+      {
+        this->boundingBoxModels.erase(_entity);
+        this->boundingBoxDirtyModels.erase(_entity);
+        return true;
+      });
+  _ecm.EachRemoved<components::AxisAlignedBox>(
+      [&](const Entity &_entity, const components::AxisAlignedBox *) -> bool
+      {
+        this->boundingBoxModels.erase(_entity);
+        return true;
+      });
+  _ecm.EachNew<components::Model, components::AxisAlignedBox>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::AxisAlignedBox *) -> bool
+      {
+        this->boundingBoxModels.erase(_entity);
+        return true;
+      });
+
+  // Models whose links moved in the last step. Keep collecting them while
+  // updates are throttled.
+  for (const auto &[link, frameData] : this->changedLinks)
+  {
+    auto it = this->topLevelModelMap.find(link);
+    if (it != this->topLevelModelMap.end())
+      this->boundingBoxDirtyModels.insert(it->second);
+  }
+
+  if (this->boundingBoxPeriod > std::chrono::steady_clock::duration::zero() &&
+      this->lastBoundingBoxUpdate &&
+      _simTime >= *this->lastBoundingBoxUpdate &&
+      _simTime - *this->lastBoundingBoxUpdate < this->boundingBoxPeriod)
+  {
+    return;
+  }
+  this->lastBoundingBoxUpdate = _simTime;
+
+  // Only models which haven't been computed yet, whose top level model
+  // moved, or whose box doesn't hold the value computed last, because
+  // another system wrote it, need to be recomputed
   _ecm.Each<components::Model, components::AxisAlignedBox>(
       [&](const Entity &_entity, const components::Model *,
           components::AxisAlignedBox *_bbox)
       {
+        auto topIt = this->topLevelModelMap.find(_entity);
+        const auto topLevel = topIt == this->topLevelModelMap.end() ?
+            _entity : topIt->second;
+        auto computedIt = this->boundingBoxModels.find(_entity);
+        if (computedIt != this->boundingBoxModels.end() &&
+            this->axisAlignedBoxEql(computedIt->second, _bbox->Data()) &&
+            this->boundingBoxDirtyModels.find(topLevel) ==
+            this->boundingBoxDirtyModels.end())
+        {
+          return true;
+        }
+
         if (!this->entityModelMap.HasEntity(_entity))
         {
           ignwarn << "Failed to find model [" << _entity << "]." << std::endl;
@@ -2336,7 +3018,6 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 
         auto bbModel =
             this->entityModelMap.EntityCast<BoundingBoxFeatureList>(_entity);
-
         if (!bbModel)
         {
           static bool informed{false};
@@ -2344,12 +3025,12 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
           {
             igndbg << "Attempting to get a bounding box, but the physics "
                    << "engine doesn't support feature "
-                   << "[GetModelBoundingBox]. Bounding box won't be populated."
-                   << std::endl;
+                   << "[GetModelBoundingBox]. Bounding box won't be "
+                   << "populated." << std::endl;
             informed = true;
           }
 
-          // Break Each call since no AxisAlignedBox'es can be processed
+          // Break Each call since no AxisAlignedBox'es can be computed
           return false;
         }
 
@@ -2359,11 +3040,12 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
             ComponentState::PeriodicChange :
             ComponentState::NoChange;
         _ecm.SetChanged(_entity, components::AxisAlignedBox::typeId, state);
+        this->boundingBoxModels[_entity] = bbox;
 
         return true;
       });
-}  // NOLINT readability/fn_size
-// TODO (azeey) Reduce size of function and remove the NOLINT above
+  this->boundingBoxDirtyModels.clear();
+}
 
 //////////////////////////////////////////////////
 ignition::physics::ForwardStep::Output PhysicsPrivate::Step(
@@ -2374,16 +3056,120 @@ ignition::physics::ForwardStep::Output PhysicsPrivate::Step(
   ignition::physics::ForwardStep::State state;
   ignition::physics::ForwardStep::Output output;
 
-  input.Get<std::chrono::steady_clock::duration>() = _dt;
+  if (this->substeps <= 1u)
+  {
+    input.Get<std::chrono::steady_clock::duration>() = _dt;
+
+    for (const auto &world : this->entityWorldMap.Map())
+    {
+      world.second->Step(output, state, input);
+    }
+
+    return output;
+  }
+
+  // Split the step into substeps. Engines reset commands after each step,
+  // so the commands applied by UpdatePhysics are held by re-applying them
+  // before each of the following substeps.
+  // The last substep also takes the remainder of the division, so the
+  // substeps add up to the full step.
+  const auto substepDt = _dt / this->substeps;
+  const auto lastSubstepDt = _dt - substepDt * (this->substeps - 1u);
+
+  // Links reported as changed by any of the substeps
+  std::vector<ignition::physics::WorldPose> changedPoses;
+  std::unordered_set<std::size_t> changedBodies;
+  bool hasChangedPoses{false};
+
+  for (unsigned int substep = 0u; substep < this->substeps; ++substep)
+  {
+    if (substep > 0u)
+      this->ApplyHeldCommands();
+
+    input.Get<std::chrono::steady_clock::duration>() =
+        substep + 1u < this->substeps ? substepDt : lastSubstepDt;
+
+    ignition::physics::ForwardStep::Output substepOutput;
+    for (const auto &world : this->entityWorldMap.Map())
+    {
+      world.second->Step(substepOutput, state, input);
+    }
+
+    // Entries only hold link IDs and poses, which are read back from the
+    // engine after the step, so keep one entry per link.
+    if (substepOutput.Has<ignition::physics::ChangedWorldPoses>())
+    {
+      hasChangedPoses = true;
+      for (const auto &entry :
+          substepOutput.Query<ignition::physics::ChangedWorldPoses>()->entries)
+      {
+        if (changedBodies.insert(entry.body).second)
+          changedPoses.push_back(entry);
+      }
+    }
+  }
 
-  for (const auto &world : this->entityWorldMap.Map())
+  if (hasChangedPoses)
   {
-    world.second->Step(output, state, input);
+    output.Get<ignition::physics::ChangedWorldPoses>().entries =
+        std::move(changedPoses);
   }
 
   return output;
 }
 
+//////////////////////////////////////////////////
+void PhysicsPrivate::ApplyHeldCommands()
+{
+  IGN_PROFILE("PhysicsPrivate::ApplyHeldCommands");
+  const auto &values = this->heldCommands.jointValues;
+
+  for (const auto &command : this->heldCommands.jointForces)
+  {
+    auto jointPhys = this->entityJointMap.Get(command.joint);
+    if (nullptr == jointPhys)
+      continue;
+    for (std::size_t i = 0; i < command.count; ++i)
+      jointPhys->SetForce(i, values[command.offset + i]);
+  }
+
+  for (const auto &command : this->heldCommands.jointVelocities)
+  {
+    auto jointVelFeature = this->entityJointMap.EntityCast<
+        JointVelocityCommandFeatureList>(command.joint);
+    if (!jointVelFeature)
+      continue;
+    for (std::size_t i = 0; i < command.count; ++i)
+      jointVelFeature->SetVelocityCommand(i, values[command.offset + i]);
+  }
+
+  for (const auto &[link, force, torque] : this->heldCommands.linkWrenches)
+  {
+    auto linkForceFeature =
+        this->entityLinkMap.EntityCast<LinkForceFeatureList>(link);
+    if (!linkForceFeature)
+      continue;
+    linkForceFeature->AddExternalForce(math::eigen3::convert(force));
+    linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
+  }
+
+  for (const auto &[entity, vel] : this->heldCommands.linearVelocities)
+  {
+    auto worldVelFeature = this->entityFreeGroupMap
+        .EntityCast<WorldVelocityCommandFeatureList>(entity);
+    if (worldVelFeature)
+      worldVelFeature->SetWorldLinearVelocity(math::eigen3::convert(vel));
+  }
+
+  for (const auto &[entity, vel] : this->heldCommands.angularVelocities)
+  {
+    auto worldVelFeature = this->entityFreeGroupMap
+        .EntityCast<WorldVelocityCommandFeatureList>(entity);
+    if (worldVelFeature)
+      worldVelFeature->SetWorldAngularVelocity(math::eigen3::convert(vel));
+  }
+}
+
 //////////////////////////////////////////////////
 ignition::math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
   const Entity &_to, const EntityComponentManager &_ecm) const
@@ -2421,20 +3207,23 @@ ignition::math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
 }
 
 //////////////////////////////////////////////////
-std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
-    EntityComponentManager &_ecm,
-    const ignition::physics::ForwardStep::Output &_updatedLinks)
+void PhysicsPrivate::ChangedLinks(EntityComponentManager &_ecm,
+    const ignition::physics::ForwardStep::Output &_updatedLinks,
+    LinkFrameDataBuffer &_linkFrameData)
 {
   IGN_PROFILE("Links Frame Data");
 
-  std::map<Entity, physics::FrameData3d> linkFrameData;
+  _linkFrameData.Clear();
 
   // Check to see if the physics engine gave a list of changed poses. If not, we
-  // will iterate through all of the links via the ECM to see which ones changed
+  // will check all of the non-static links to see which ones changed. Links
+  // which the engine didn't report, such as sleeping ones, aren't touched.
   if (_updatedLinks.Has<ignition::physics::ChangedWorldPoses>())
   {
-    for (const auto &link :
-        _updatedLinks.Query<ignition::physics::ChangedWorldPoses>()->entries)
+    const auto &entries =
+        _updatedLinks.Query<ignition::physics::ChangedWorldPoses>()->entries;
+    _linkFrameData.Reserve(entries.size());
+    for (const auto &link : entries)
     {
       // get the gazebo entity that matches the updated physics link entity
       const auto linkPhys = this->entityLinkMap.GetPhysicsEntityPtr(link.body);
@@ -2452,63 +3241,253 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
         continue;
       }
 
-      auto frameData = linkPhys->FrameDataRelativeToWorld();
-      linkFrameData[entity] = frameData;
+      _linkFrameData.Append(entity, linkPhys->FrameDataRelativeToWorld());
     }
+
+    // The engine reports links in its own order
+    _linkFrameData.Sort();
   }
   else
   {
-    _ecm.Each<components::Link>(
-      [&](const Entity &_entity, components::Link *) -> bool
+    this->UpdateTrackedLinks(_ecm);
+
+    const bool checkRecreate =
+        _ecm.HasComponentType(components::Recreate::typeId);
+
+    // trackedLinks is in creation order, so no sorting is needed
+    for (auto &tracked : this->trackedLinks)
+    {
+      if (checkRecreate && _ecm.EntityHasComponentType(tracked.entity,
+            components::Recreate::typeId))
       {
-        if (this->staticEntities.find(_entity) != this->staticEntities.end() ||
-            _ecm.EntityHasComponentType(_entity, components::Recreate::typeId))
-        {
-          return true;
-        }
+        continue;
+      }
 
-        // This `once` variable is here to aid in debugging, make sure to
-        // remove it.
-        auto linkPhys = this->entityLinkMap.Get(_entity);
-        if (nullptr == linkPhys)
-        {
-          if (this->linkAddedToModel.find(_entity) ==
-              this->linkAddedToModel.end())
-          {
-            ignerr << "Internal error: link [" << _entity
-              << "] not in entity map" << std::endl;
-          }
-          return true;
-        }
+      auto frameData = tracked.link->FrameDataRelativeToWorld();
 
-        auto frameData = linkPhys->FrameDataRelativeToWorld();
+      // update the link pose if this is the first update,
+      // or if the link pose has changed since the last update
+      // (if the link pose hasn't changed, there's no need for a pose update)
+      const auto worldPoseMath3d = ignition::math::eigen3::convert(
+          frameData.pose);
+      if (!tracked.worldPose ||
+          !this->pose3Eql(*tracked.worldPose, worldPoseMath3d))
+      {
+        // cache the updated link pose to check if the link pose has changed
+        // during the next iteration
+        tracked.worldPose = worldPoseMath3d;
 
-        // update the link pose if this is the first update,
-        // or if the link pose has changed since the last update
-        // (if the link pose hasn't changed, there's no need for a pose update)
-        const auto worldPoseMath3d = ignition::math::eigen3::convert(
-            frameData.pose);
-        if ((this->linkWorldPoses.find(_entity) == this->linkWorldPoses.end())
-            || !this->pose3Eql(this->linkWorldPoses[_entity], worldPoseMath3d))
-        {
-          // cache the updated link pose to check if the link pose has changed
-          // during the next iteration
-          this->linkWorldPoses[_entity] = worldPoseMath3d;
+        _linkFrameData.Append(tracked.entity, frameData);
+      }
+    }
+  }
+}
 
-          linkFrameData[_entity] = frameData;
-        }
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateTrackedLinks(const EntityComponentManager &_ecm)
+{
+  if (!this->trackedLinksDirty)
+    return;
 
+  IGN_PROFILE("PhysicsPrivate::UpdateTrackedLinks");
+
+  // Keep the state of links and models which were already being tracked
+  std::unordered_map<Entity, TrackedLink> previousLinks;
+  for (auto &tracked : this->trackedLinks)
+    previousLinks.emplace(tracked.entity, std::move(tracked));
+  std::unordered_set<Entity> previousSleepingModels;
+  for (const auto &tracked : this->trackedModels)
+  {
+    if (tracked.sleeping)
+      previousSleepingModels.insert(tracked.entity);
+  }
+
+  this->trackedLinks.clear();
+  this->trackedModels.clear();
+  this->sleepingLinks.clear();
+  this->trackedLinksDirty = false;
+
+  _ecm.Each<components::Model>(
+    [&](const Entity &_entity, const components::Model *) -> bool
+    {
+      if (this->staticEntities.find(_entity) != this->staticEntities.end() ||
+          !this->entityModelMap.HasEntity(_entity))
+      {
         return true;
+      }
+
+      TrackedModel tracked;
+      tracked.entity = _entity;
+      tracked.sleeping = previousSleepingModels.find(_entity) !=
+          previousSleepingModels.end();
+      this->trackedModels.push_back(tracked);
+      return true;
+    });
+
+  std::sort(this->trackedModels.begin(), this->trackedModels.end(),
+      [](const TrackedModel &_a, const TrackedModel &_b)
+      {
+        return _a.entity < _b.entity;
       });
+
+  std::unordered_map<Entity, std::size_t> modelIndices;
+  for (std::size_t i = 0u; i < this->trackedModels.size(); ++i)
+    modelIndices[this->trackedModels[i].entity] = i;
+
+  auto topLevelIndex = [&](const Entity _entity)
+  {
+    auto topLevelIt = this->topLevelModelMap.find(_entity);
+    if (topLevelIt != this->topLevelModelMap.end())
+    {
+      auto indexIt = modelIndices.find(topLevelIt->second);
+      if (indexIt != modelIndices.end())
+        return indexIt->second;
+    }
+    return std::numeric_limits<std::size_t>::max();
+  };
+
+  for (auto &tracked : this->trackedModels)
+    tracked.topLevelIndex = topLevelIndex(tracked.entity);
+
+  _ecm.Each<components::Link>(
+    [&](const Entity &_entity, const components::Link *) -> bool
+    {
+      if (this->staticEntities.find(_entity) != this->staticEntities.end())
+        return true;
+
+      auto linkPhys = this->entityLinkMap.Get(_entity);
+      if (nullptr == linkPhys)
+      {
+        if (this->linkAddedToModel.find(_entity) ==
+            this->linkAddedToModel.end())
+        {
+          ignerr << "Internal error: link [" << _entity
+            << "] not in entity map" << std::endl;
+        }
+        // Try again on the next step
+        this->trackedLinksDirty = true;
+        return true;
+      }
+
+      TrackedLink tracked;
+      auto previousIt = previousLinks.find(_entity);
+      if (previousIt != previousLinks.end())
+        tracked = std::move(previousIt->second);
+      tracked.entity = _entity;
+      tracked.link = linkPhys;
+      tracked.topLevelIndex = topLevelIndex(_entity);
+      if (tracked.sleeping)
+        this->sleepingLinks.insert(_entity);
+      this->trackedLinks.push_back(std::move(tracked));
+      return true;
+    });
+
+  std::sort(this->trackedLinks.begin(), this->trackedLinks.end(),
+      [](const TrackedLink &_a, const TrackedLink &_b)
+      {
+        return _a.entity < _b.entity;
+      });
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateSleeping(EntityComponentManager &_ecm,
+    const LinkFrameDataBuffer &_changedLinks, bool _paused)
+{
+  IGN_PROFILE("PhysicsPrivate::UpdateSleeping");
+
+  this->UpdateTrackedLinks(_ecm);
+
+  auto setSleeping = [&](const Entity _entity, bool _sleeping)
+  {
+    auto sleepingComp = _ecm.Component<components::Sleeping>(_entity);
+    if (nullptr == sleepingComp)
+    {
+      _ecm.CreateComponent(_entity, components::Sleeping(_sleeping));
+      return;
+    }
+    *sleepingComp = components::Sleeping(_sleeping);
+    _ecm.SetChanged(_entity, components::Sleeping::typeId,
+        ComponentState::OneTimeChange);
+  };
+
+  this->topLevelAwake.assign(this->trackedModels.size(), 0);
+  bool wokeUp{false};
+
+  // Both trackedLinks and _changedLinks are sorted by entity
+  auto changedIt = _changedLinks.begin();
+  for (auto &tracked : this->trackedLinks)
+  {
+    while (changedIt != _changedLinks.end() &&
+        changedIt->first < tracked.entity)
+    {
+      ++changedIt;
+    }
+
+    if (changedIt != _changedLinks.end() && changedIt->first == tracked.entity)
+      tracked.idleSteps = 0u;
+    else if (!_paused && tracked.idleSteps < this->sleepIdleSteps)
+      ++tracked.idleSteps;
+
+    const bool sleeping = tracked.idleSteps >= this->sleepIdleSteps;
+    if (sleeping != tracked.sleeping)
+    {
+      tracked.sleeping = sleeping;
+      setSleeping(tracked.entity, sleeping);
+      if (sleeping)
+      {
+        this->sleepingLinks.insert(tracked.entity);
+      }
+      else
+      {
+        this->sleepingLinks.erase(tracked.entity);
+        wokeUp = true;
+      }
+    }
+
+    if (!sleeping && tracked.topLevelIndex < this->topLevelAwake.size())
+      this->topLevelAwake[tracked.topLevelIndex] = 1;
+  }
+
+  // A model sleeps when none of the links of its top-level model are awake
+  for (auto &tracked : this->trackedModels)
+  {
+    const bool sleeping =
+        tracked.topLevelIndex < this->topLevelAwake.size() &&
+        !this->topLevelAwake[tracked.topLevelIndex];
+    if (sleeping != tracked.sleeping)
+    {
+      tracked.sleeping = sleeping;
+      setSleeping(tracked.entity, sleeping);
+    }
+  }
+
+  // Entities attached to links that woke up need to be updated again once
+  // the links fall asleep
+  if (wokeUp)
+    this->sleepingSynced.clear();
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::SkipSleepingChild(const EntityComponentManager &_ecm,
+    const Entity _entity, const Entity _link, const ComponentTypeId _type)
+{
+  if (this->sleepingLinks.empty() ||
+      this->sleepingLinks.find(_link) == this->sleepingLinks.end())
+  {
+    return false;
   }
 
-  return linkFrameData;
+  // Update once after the link falls asleep, then skip unless the entity
+  // was moved with respect to the link
+  return !this->sleepingSynced[_type].insert(_entity).second &&
+      _ecm.ComponentState(_entity, components::Pose::typeId) ==
+      ComponentState::NoChange;
 }
 
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateModelPose(const Entity _model,
     const Entity _canonicalLink, EntityComponentManager &_ecm,
-    std::map<Entity, physics::FrameData3d> &_linkFrameData)
+    LinkFrameDataBuffer &_linkFrameData, std::size_t &_index)
 {
   std::optional<math::Pose3d> parentWorldPose;
 
@@ -2547,7 +3526,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   // And X_WM is calculated from X_WL, which is obtained from physics as:
   //   X_WM = X_WL * (X_ML)^-1
   auto linkPoseFromModel = this->RelativePose(_model, _canonicalLink, _ecm);
-  const auto &linkWorldPose = _linkFrameData[_canonicalLink].pose;
+  const auto linkWorldPose = _linkFrameData[_index].second.pose;
   const auto &modelWorldPose =
       math::eigen3::convert(linkWorldPose) * linkPoseFromModel.Inverse();
 
@@ -2577,14 +3556,14 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   for (const auto &childLink : model.Links(_ecm))
   {
     // skip links that are already marked as a link to be updated
-    if (_linkFrameData.find(childLink) != _linkFrameData.end())
+    if (nullptr != _linkFrameData.Find(childLink))
       continue;
 
     physics::FrameData3d childLinkFrameData;
     if (!this->GetFrameDataRelativeToWorld(childLink, childLinkFrameData))
       continue;
 
-    _linkFrameData[childLink] = childLinkFrameData;
+    _linkFrameData.Insert(childLink, childLinkFrameData, _index);
   }
 
   // since nested model poses are saved w.r.t. the nested model's parent
@@ -2606,7 +3585,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
 
     // skip links that are already marked as a link to be updated
     if (nestedCanonicalLink == _canonicalLink ||
-        _linkFrameData.find(nestedCanonicalLink) != _linkFrameData.end())
+        nullptr != _linkFrameData.Find(nestedCanonicalLink))
       continue;
 
     // mark this canonical link as one that needs to be updated so that all of
@@ -2616,7 +3595,8 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
           canonicalLinkFrameData))
       continue;
 
-    _linkFrameData[nestedCanonicalLink] = canonicalLinkFrameData;
+    _linkFrameData.Insert(nestedCanonicalLink, canonicalLinkFrameData,
+        _index);
   }
 }
 
@@ -2640,9 +3620,174 @@ bool PhysicsPrivate::GetFrameDataRelativeToWorld(const Entity _entity,
   return true;
 }
 
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateLinkState(const Entity _entity,
+    const physics::FrameData3d &_frameData, EntityComponentManager &_ecm,
+    std::vector<LinkStateChange> &_changes) const
+{
+  auto canonicalLink =
+      _ecm.Component<components::CanonicalLink>(_entity);
+
+  const auto &worldPose = _frameData.pose;
+  const auto parentEntity = _ecm.ParentEntity(_entity);
+
+  if (!canonicalLink)
+  {
+    // Compute the relative pose of this link from the parent model
+    auto parentModelPoseIt = this->modelWorldPoses.find(parentEntity);
+    if (parentModelPoseIt == this->modelWorldPoses.end())
+    {
+      ignerr << "Internal error: parent model [" << parentEntity
+            << "] does not have a world pose available for child entity["
+            << _entity << "]" << std::endl;
+      return;
+    }
+    const math::Pose3d &parentWorldPose = parentModelPoseIt->second;
+
+    // Unlike canonical links, pose of regular links can move relative.
+    // to the parent. Same for links inside nested models.
+    auto pose = _ecm.Component<components::Pose>(_entity);
+    *pose = components::Pose(parentWorldPose.Inverse() *
+                              math::eigen3::convert(worldPose));
+    _changes.push_back({_entity, components::Pose::typeId,
+        ComponentState::PeriodicChange});
+  }
+
+  // Populate world poses, velocities and accelerations of the link. For
+  // now these components are updated only if another system has created
+  // the corresponding component on the entity.
+  auto worldPoseComp = _ecm.Component<components::WorldPose>(_entity);
+  if (worldPoseComp)
+  {
+    auto state =
+        worldPoseComp->SetData(math::eigen3::convert(_frameData.pose),
+        this->pose3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::WorldPose::typeId, state});
+  }
+
+  // Velocity in world coordinates
+  auto worldLinVelComp =
+      _ecm.Component<components::WorldLinearVelocity>(_entity);
+  if (worldLinVelComp)
+  {
+    auto state = worldLinVelComp->SetData(
+          math::eigen3::convert(_frameData.linearVelocity),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+    _changes.push_back({_entity, components::WorldLinearVelocity::typeId,
+        state});
+  }
+
+  // Angular velocity in world frame coordinates
+  auto worldAngVelComp =
+      _ecm.Component<components::WorldAngularVelocity>(_entity);
+  if (worldAngVelComp)
+  {
+    auto state = worldAngVelComp->SetData(
+        math::eigen3::convert(_frameData.angularVelocity),
+        this->vec3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::WorldAngularVelocity::typeId,
+        state});
+  }
+
+  // Acceleration in world frame coordinates
+  auto worldLinAccelComp =
+      _ecm.Component<components::WorldLinearAcceleration>(_entity);
+  if (worldLinAccelComp)
+  {
+    auto state = worldLinAccelComp->SetData(
+        math::eigen3::convert(_frameData.linearAcceleration),
+        this->vec3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::WorldLinearAcceleration::typeId,
+        state});
+  }
+
+  // Angular acceleration in world frame coordinates
+  auto worldAngAccelComp =
+      _ecm.Component<components::WorldAngularAcceleration>(_entity);
+
+  if (worldAngAccelComp)
+  {
+    auto state = worldAngAccelComp->SetData(
+        math::eigen3::convert(_frameData.angularAcceleration),
+        this->vec3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::WorldAngularAcceleration::typeId,
+        state});
+  }
+
+  const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
+
+  // Velocity in body-fixed frame coordinates
+  auto bodyLinVelComp =
+      _ecm.Component<components::LinearVelocity>(_entity);
+  if (bodyLinVelComp)
+  {
+    Eigen::Vector3d bodyLinVel = R_bs * _frameData.linearVelocity;
+    auto state =
+        bodyLinVelComp->SetData(math::eigen3::convert(bodyLinVel),
+        this->vec3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::LinearVelocity::typeId, state});
+  }
+
+  // Angular velocity in body-fixed frame coordinates
+  auto bodyAngVelComp =
+      _ecm.Component<components::AngularVelocity>(_entity);
+  if (bodyAngVelComp)
+  {
+    Eigen::Vector3d bodyAngVel = R_bs * _frameData.angularVelocity;
+    auto state =
+        bodyAngVelComp->SetData(math::eigen3::convert(bodyAngVel),
+        this->vec3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::AngularVelocity::typeId, state});
+  }
+
+  // Acceleration in body-fixed frame coordinates
+  auto bodyLinAccelComp =
+      _ecm.Component<components::LinearAcceleration>(_entity);
+  if (bodyLinAccelComp)
+  {
+    Eigen::Vector3d bodyLinAccel = R_bs * _frameData.linearAcceleration;
+    auto state =
+        bodyLinAccelComp->SetData(math::eigen3::convert(bodyLinAccel),
+        this->vec3Eql)?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::LinearAcceleration::typeId,
+        state});
+  }
+
+  // Angular acceleration in world frame coordinates
+  auto bodyAngAccelComp =
+      _ecm.Component<components::AngularAcceleration>(_entity);
+  if (bodyAngAccelComp)
+  {
+    Eigen::Vector3d bodyAngAccel = R_bs * _frameData.angularAcceleration;
+    auto state =
+        bodyAngAccelComp->SetData(math::eigen3::convert(bodyAngAccel),
+        this->vec3Eql) ?
+        ComponentState::PeriodicChange :
+        ComponentState::NoChange;
+    _changes.push_back({_entity, components::AngularAcceleration::typeId,
+        state});
+  }
+}
+
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
-    std::map<Entity, physics::FrameData3d> &_linkFrameData)
+    LinkFrameDataBuffer &_linkFrameData)
 {
   IGN_PROFILE("PhysicsPrivate::UpdateSim");
 
@@ -2687,18 +3832,21 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // make sure we have an up-to-date mapping of canonical links to their models
   this->canonicalLinkModelTracker.AddNewModels(_ecm);
 
-  for (const auto &[linkEntity, frameData] : _linkFrameData)
+  // Links may be inserted while iterating, so iterate by index
+  for (std::size_t i = 0u; i < _linkFrameData.Size(); ++i)
   {
+    const Entity linkEntity = _linkFrameData[i].first;
+
     // get a topological ordering of the models that have linkEntity as the
     // model's canonical link. If linkEntity isn't a canonical link for any
     // models, canonicalLinkModels will be empty
-    auto canonicalLinkModels =
+    const auto &canonicalLinkModels =
       this->canonicalLinkModelTracker.CanonicalLinkModels(linkEntity);
 
     // Update poses for all of the models that have this changed canonical link
     // (linkEntity). Since we have the models in topological order and
-    // _linkFrameData stores links in topological order thanks to the ordering
-    // of std::map (entity IDs are created in ascending order), this should
+    // _linkFrameData stores links in topological order since it's sorted by
+    // entity (entity IDs are created in ascending order), this should
     // properly handle pose updates for nested models that share the same
     // canonical link.
     //
@@ -2707,175 +3855,68 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
     // parent model, which just experienced a pose update. The UpdateModelPose
     // method also handles this case.
     for (auto &modelEnt : canonicalLinkModels)
-      this->UpdateModelPose(modelEnt, linkEntity, _ecm, _linkFrameData);
+      this->UpdateModelPose(modelEnt, linkEntity, _ecm, _linkFrameData, i);
   }
   IGN_PROFILE_END();
 
-  // Link poses, velocities...
+  // Link poses, velocities... Links are partitioned by top-level model, and
+  // partitions are written back in parallel. Links within a partition keep
+  // the topological order of _linkFrameData.
   IGN_PROFILE_BEGIN("Links");
+  std::size_t partitionCount{0u};
+  std::size_t linkCount{0u};
+  this->linkPartitionIndex.clear();
   for (const auto &[entity, frameData] : _linkFrameData)
   {
-    IGN_PROFILE_BEGIN("Local pose");
-    auto canonicalLink =
-        _ecm.Component<components::CanonicalLink>(entity);
-
-    const auto &worldPose = frameData.pose;
-    const auto parentEntity = _ecm.ParentEntity(entity);
-
-    if (!canonicalLink)
-    {
-      // Compute the relative pose of this link from the parent model
-      auto parentModelPoseIt = this->modelWorldPoses.find(parentEntity);
-      if (parentModelPoseIt == this->modelWorldPoses.end())
-      {
-        ignerr << "Internal error: parent model [" << parentEntity
-              << "] does not have a world pose available for child entity["
-              << entity << "]" << std::endl;
-        continue;
-      }
-      const math::Pose3d &parentWorldPose = parentModelPoseIt->second;
-
-      // Unlike canonical links, pose of regular links can move relative.
-      // to the parent. Same for links inside nested models.
-      auto pose = _ecm.Component<components::Pose>(entity);
-      *pose = components::Pose(parentWorldPose.Inverse() *
-                                math::eigen3::convert(worldPose));
-      _ecm.SetChanged(entity, components::Pose::typeId,
-          ComponentState::PeriodicChange);
-    }
-    IGN_PROFILE_END();
-
-    // Populate world poses, velocities and accelerations of the link. For
-    // now these components are updated only if another system has created
-    // the corresponding component on the entity.
-    auto worldPoseComp = _ecm.Component<components::WorldPose>(entity);
-    if (worldPoseComp)
-    {
-      auto state =
-          worldPoseComp->SetData(math::eigen3::convert(frameData.pose),
-          this->pose3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::WorldPose::typeId, state);
-    }
+    auto topLevelIt = this->topLevelModelMap.find(entity);
+    const Entity topLevel = topLevelIt != this->topLevelModelMap.end() ?
+        topLevelIt->second : entity;
 
-    // Velocity in world coordinates
-    auto worldLinVelComp =
-        _ecm.Component<components::WorldLinearVelocity>(entity);
-    if (worldLinVelComp)
+    auto [partitionIt, inserted] =
+        this->linkPartitionIndex.emplace(topLevel, partitionCount);
+    if (inserted)
     {
-      auto state = worldLinVelComp->SetData(
-            math::eigen3::convert(frameData.linearVelocity),
-            this->vec3Eql) ?
-            ComponentState::PeriodicChange :
-            ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldLinearVelocity::typeId, state);
+      if (this->linkPartitions.size() <= partitionCount)
+        this->linkPartitions.emplace_back();
+      this->linkPartitions[partitionCount].clear();
+      ++partitionCount;
     }
+    this->linkPartitions[partitionIt->second].emplace_back(entity,
+        &frameData);
+    ++linkCount;
+  }
 
-    // Angular velocity in world frame coordinates
-    auto worldAngVelComp =
-        _ecm.Component<components::WorldAngularVelocity>(entity);
-    if (worldAngVelComp)
-    {
-      auto state = worldAngVelComp->SetData(
-          math::eigen3::convert(frameData.angularVelocity),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldAngularVelocity::typeId, state);
-    }
-
-    // Acceleration in world frame coordinates
-    auto worldLinAccelComp =
-        _ecm.Component<components::WorldLinearAcceleration>(entity);
-    if (worldLinAccelComp)
-    {
-      auto state = worldLinAccelComp->SetData(
-          math::eigen3::convert(frameData.linearAcceleration),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldLinearAcceleration::typeId, state);
-    }
-
-    // Angular acceleration in world frame coordinates
-    auto worldAngAccelComp =
-        _ecm.Component<components::WorldAngularAcceleration>(entity);
-
-    if (worldAngAccelComp)
-    {
-      auto state = worldAngAccelComp->SetData(
-          math::eigen3::convert(frameData.angularAcceleration),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldAngularAcceleration::typeId, state);
-    }
-
-    const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
-
-    // Velocity in body-fixed frame coordinates
-    auto bodyLinVelComp =
-        _ecm.Component<components::LinearVelocity>(entity);
-    if (bodyLinVelComp)
-    {
-      Eigen::Vector3d bodyLinVel = R_bs * frameData.linearVelocity;
-      auto state =
-          bodyLinVelComp->SetData(math::eigen3::convert(bodyLinVel),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::LinearVelocity::typeId, state);
-    }
+  // Waking up threads isn't worth it for a handful of links
+  std::size_t threadCount{1u};
+  if (linkCount >= kMinLinksPerThread * 2u)
+  {
+    threadCount = std::min({partitionCount,
+        linkCount / kMinLinksPerThread,
+        static_cast<std::size_t>(
+        std::max(1u, std::thread::hardware_concurrency()))});
+  }
+  if (this->linkStateChanges.size() < threadCount)
+    this->linkStateChanges.resize(threadCount);
 
-    // Angular velocity in body-fixed frame coordinates
-    auto bodyAngVelComp =
-        _ecm.Component<components::AngularVelocity>(entity);
-    if (bodyAngVelComp)
+  std::atomic<std::size_t> nextPartition{0u};
+  auto writeBack = [&](std::size_t _thread)
+  {
+    auto &changes = this->linkStateChanges[_thread];
+    changes.clear();
+    for (auto i = nextPartition++; i < partitionCount; i = nextPartition++)
     {
-      Eigen::Vector3d bodyAngVel = R_bs * frameData.angularVelocity;
-      auto state =
-          bodyAngVelComp->SetData(math::eigen3::convert(bodyAngVel),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::AngularVelocity::typeId,
-          state);
+      for (const auto &[entity, frameData] : this->linkPartitions[i])
+        this->UpdateLinkState(entity, *frameData, _ecm, changes);
     }
+  };
 
-    // Acceleration in body-fixed frame coordinates
-    auto bodyLinAccelComp =
-        _ecm.Component<components::LinearAcceleration>(entity);
-    if (bodyLinAccelComp)
-    {
-      Eigen::Vector3d bodyLinAccel = R_bs * frameData.linearAcceleration;
-      auto state =
-          bodyLinAccelComp->SetData(math::eigen3::convert(bodyLinAccel),
-          this->vec3Eql)?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::LinearAcceleration::typeId,
-          state);
-    }
+  this->writeBackThreads.Run(threadCount, writeBack);
 
-    // Angular acceleration in world frame coordinates
-    auto bodyAngAccelComp =
-        _ecm.Component<components::AngularAcceleration>(entity);
-    if (bodyAngAccelComp)
-    {
-      Eigen::Vector3d bodyAngAccel = R_bs * frameData.angularAcceleration;
-      auto state =
-          bodyAngAccelComp->SetData(math::eigen3::convert(bodyAngAccel),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::AngularAcceleration::typeId,
-          state);
-    }
+  // The ECM's change tracking isn't thread safe, so changes are applied here
+  for (std::size_t t = 0u; t < threadCount; ++t)
+  {
+    for (const auto &change : this->linkStateChanges[t])
+      _ecm.SetChanged(change.entity, change.type, change.state);
   }
   IGN_PROFILE_END();
 
@@ -2892,10 +3933,17 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // world pose
   _ecm.Each<components::Pose, components::WorldPose,
             components::ParentEntity>(
-      [&](const Entity &,
+      [&](const Entity &_entity,
           const components::Pose *_pose, components::WorldPose *_worldPose,
           const components::ParentEntity *_parent)->bool
       {
+        // The link's pose and velocities don't change while it's sleeping
+        if (this->SkipSleepingChild(_ecm, _entity, _parent->Data(),
+              components::WorldPose::typeId))
+        {
+          return true;
+        }
+
         // check if parent entity is a link, e.g. entity is sensor / collision
         if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
         {
@@ -2912,11 +3960,17 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // world linear velocity
   _ecm.Each<components::Pose, components::WorldLinearVelocity,
             components::ParentEntity>(
-      [&](const Entity &,
+      [&](const Entity &_entity,
           const components::Pose *_pose,
           components::WorldLinearVelocity *_worldLinearVel,
           const components::ParentEntity *_parent)->bool
       {
+        if (this->SkipSleepingChild(_ecm, _entity, _parent->Data(),
+              components::WorldLinearVelocity::typeId))
+        {
+          return true;
+        }
+
         // check if parent entity is a link, e.g. entity is sensor / collision
         if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
         {
@@ -2934,11 +3988,17 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // body angular velocity
   _ecm.Each<components::Pose, components::AngularVelocity,
             components::ParentEntity>(
-      [&](const Entity &,
+      [&](const Entity &_entity,
           const components::Pose *_pose,
           components::AngularVelocity *_angularVel,
           const components::ParentEntity *_parent)->bool
       {
+        if (this->SkipSleepingChild(_ecm, _entity, _parent->Data(),
+              components::AngularVelocity::typeId))
+        {
+          return true;
+        }
+
         // check if parent entity is a link, e.g. entity is sensor / collision
         if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
         {
@@ -2960,11 +4020,17 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // body linear acceleration
   _ecm.Each<components::Pose, components::LinearAcceleration,
             components::ParentEntity>(
-      [&](const Entity &,
+      [&](const Entity &_entity,
           const components::Pose *_pose,
           components::LinearAcceleration *_linearAcc,
           const components::ParentEntity *_parent)->bool
       {
+        if (this->SkipSleepingChild(_ecm, _entity, _parent->Data(),
+              components::LinearAcceleration::typeId))
+        {
+          return true;
+        }
+
         if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
         {
           const auto entityFrameData =
@@ -2983,33 +4049,19 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
       });
   IGN_PROFILE_END();
 
-  // Clear reset components
+  // Clear reset components. Commands were reset as they were consumed.
   IGN_PROFILE_BEGIN("Clear / reset components");
-  std::vector<Entity> entitiesPositionReset;
-  _ecm.Each<components::JointPositionReset>(
-      [&](const Entity &_entity, components::JointPositionReset *) -> bool
-      {
-        entitiesPositionReset.push_back(_entity);
-        return true;
-      });
-
-  for (const auto entity : entitiesPositionReset)
+  for (const auto entity : this->jointPositionResetsToRemove)
   {
     _ecm.RemoveComponent<components::JointPositionReset>(entity);
   }
+  this->jointPositionResetsToRemove.clear();
 
-  std::vector<Entity> entitiesVelocityReset;
-  _ecm.Each<components::JointVelocityReset>(
-      [&](const Entity &_entity, components::JointVelocityReset *) -> bool
-      {
-        entitiesVelocityReset.push_back(_entity);
-        return true;
-      });
-
-  for (const auto entity : entitiesVelocityReset)
+  for (const auto entity : this->jointVelocityResetsToRemove)
   {
     _ecm.RemoveComponent<components::JointVelocityReset>(entity);
   }
+  this->jointVelocityResetsToRemove.clear();
 
   std::vector<Entity> entitiesCustomContactSurface;
   _ecm.Each<components::EnableContactSurfaceCustomization>(
@@ -3024,72 +4076,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   {
     _ecm.RemoveComponent<components::EnableContactSurfaceCustomization>(entity);
   }
-
-  // Clear pending commands
-  _ecm.Each<components::JointForceCmd>(
-      [&](const Entity &, components::JointForceCmd *_force) -> bool
-      {
-        std::fill(_force->Data().begin(), _force->Data().end(), 0.0);
-        return true;
-      });
-
-  _ecm.Each<components::ExternalWorldWrenchCmd >(
-      [&](const Entity &, components::ExternalWorldWrenchCmd *_wrench) -> bool
-      {
-        _wrench->Data().Clear();
-        return true;
-      });
-
-  _ecm.Each<components::JointPositionLimitsCmd>(
-      [&](const Entity &, components::JointPositionLimitsCmd *_limits) -> bool
-      {
-        _limits->Data().clear();
-        return true;
-      });
-
-  _ecm.Each<components::JointVelocityLimitsCmd>(
-      [&](const Entity &, components::JointVelocityLimitsCmd *_limits) -> bool
-      {
-        _limits->Data().clear();
-        return true;
-      });
-
-  _ecm.Each<components::JointEffortLimitsCmd>(
-      [&](const Entity &, components::JointEffortLimitsCmd *_limits) -> bool
-      {
-        _limits->Data().clear();
-        return true;
-      });
-
-  _ecm.Each<components::JointVelocityCmd>(
-      [&](const Entity &, components::JointVelocityCmd *_vel) -> bool
-      {
-        std::fill(_vel->Data().begin(), _vel->Data().end(), 0.0);
-        return true;
-      });
-
-  _ecm.Each<components::SlipComplianceCmd>(
-      [&](const Entity &, components::SlipComplianceCmd *_slip) -> bool
-      {
-        std::fill(_slip->Data().begin(), _slip->Data().end(), 0.0);
-        return true;
-      });
   IGN_PROFILE_END();
 
-  _ecm.Each<components::AngularVelocityCmd>(
-      [&](const Entity &, components::AngularVelocityCmd *_vel) -> bool
-      {
-        _vel->Data() = math::Vector3d::Zero;
-        return true;
-      });
-
-  _ecm.Each<components::LinearVelocityCmd>(
-      [&](const Entity &, components::LinearVelocityCmd *_vel) -> bool
-      {
-        _vel->Data() = math::Vector3d::Zero;
-        return true;
-      });
-
   // Update joint positions
   IGN_PROFILE_BEGIN("Joints");
   _ecm.Each<components::Joint, components::JointPosition>(
@@ -3214,19 +4202,13 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
 
   // Each contact object we get from ign-physics contains the EntityPtrs of the
   // two colliding entities and other data about the contact such as the
-  // position. This map groups contacts so that it is easy to query all the
-  // contacts of one entity.
-  using EntityContactMap = std::unordered_map<Entity,
-      std::deque<const WorldShapeType::ContactPoint *>>;
-
-  // This data structure is essentially a mapping between a pair of entities and
-  // a list of pointers to their contact object. We use a map inside a map to
-  // create msgs::Contact objects conveniently later on.
-  std::unordered_map<Entity, EntityContactMap> entityContactMap;
-
-  // Note that we are temporarily storing pointers to elements in this
-  // ("allContacts") container. Thus, we must make sure it doesn't get destroyed
-  // until the end of this function.
+  // position. Each contact is added twice to a flat buffer, once for each
+  // collision, which is then sorted so that all the contacts of one entity,
+  // grouped by the other entity, are contiguous. The buffer is kept across
+  // steps so its memory is reused.
+  auto &contacts = this->collisionContacts;
+  contacts.clear();
+
   auto allContacts = worldCollisionFeature->GetContactsFromLastStep();
   for (const auto &contactComposite : allContacts)
   {
@@ -3236,14 +4218,23 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
     auto coll2Entity =
       this->entityCollisionMap.Get(ShapePtrType(contact.collision2));
 
-
     if (coll1Entity != kNullEntity && coll2Entity != kNullEntity)
     {
-      entityContactMap[coll1Entity][coll2Entity].push_back(&contact);
-      entityContactMap[coll2Entity][coll1Entity].push_back(&contact);
+      const auto point = math::eigen3::convert(contact.point);
+      const auto order = contacts.size();
+      contacts.push_back({coll1Entity, coll2Entity, order, point});
+      contacts.push_back({coll2Entity, coll1Entity, order + 1, point});
     }
   }
 
+  // Keep the order in which the engine reported contacts within each pair
+  std::sort(contacts.begin(), contacts.end(),
+      [](const CollisionContact &_a, const CollisionContact &_b)
+      {
+        return std::tie(_a.collision1, _a.collision2, _a.order) <
+               std::tie(_b.collision1, _b.collision2, _b.order);
+      });
+
   // Go through each collision entity that has a ContactData component and
   // set the component value to the list of contacts that correspond to
   // the collision entity
@@ -3251,40 +4242,67 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
       [&](const Entity &_collEntity1, components::Collision *,
           components::ContactSensorData *_contacts) -> bool
       {
-        msgs::Contacts contactsComp;
-        if (entityContactMap.find(_collEntity1) == entityContactMap.end())
+        auto begin = std::lower_bound(contacts.begin(), contacts.end(),
+            _collEntity1, [](const CollisionContact &_contact, Entity _entity)
+            {
+              return _contact.collision1 < _entity;
+            });
+
+        if (begin == contacts.end() || begin->collision1 != _collEntity1)
         {
-          // Clear the last contact data
-          auto state = _contacts->SetData(contactsComp,
-            this->contactsEql) ?
-            ComponentState::PeriodicChange :
-            ComponentState::NoChange;
+          // Clear the last contact data, there's no need to build a message
+          // if it's already empty
+          auto state = ComponentState::NoChange;
+          if (_contacts->Data().contact_size() > 0)
+          {
+            _contacts->Data().Clear();
+            state = ComponentState::PeriodicChange;
+          }
           _ecm.SetChanged(
             _collEntity1, components::ContactSensorData::typeId, state);
           return true;
         }
 
-        const auto &contactMap = entityContactMap[_collEntity1];
+        // Reuse the same message for all collisions, so the memory of its
+        // repeated fields is reused as well
+        auto &contactsComp = this->contactsMsg;
+        contactsComp.Clear();
 
-        for (const auto &[collEntity2, contactData] : contactMap)
+        msgs::Contact *contactMsg{nullptr};
+        Entity collEntity2{kNullEntity};
+        std::size_t pairCount{0u};
+        for (auto it = begin;
+             it != contacts.end() && it->collision1 == _collEntity1; ++it)
         {
-          msgs::Contact *contactMsg = contactsComp.add_contact();
-          contactMsg->mutable_collision1()->set_id(_collEntity1);
-          contactMsg->mutable_collision2()->set_id(collEntity2);
-          if (this->contactsEntityNames)
+          if (nullptr == contactMsg || it->collision2 != collEntity2)
           {
-            contactMsg->mutable_collision1()->set_name(
-              removeParentScope(scopedName(_collEntity1, _ecm, "::", 0), "::"));
-            contactMsg->mutable_collision2()->set_name(
-              removeParentScope(scopedName(collEntity2, _ecm, "::", 0), "::"));
+            collEntity2 = it->collision2;
+            pairCount = 0u;
+            contactMsg = contactsComp.add_contact();
+            contactMsg->mutable_collision1()->set_id(_collEntity1);
+            contactMsg->mutable_collision2()->set_id(collEntity2);
+            if (this->contactsEntityNames)
+            {
+              contactMsg->mutable_collision1()->set_name(
+                removeParentScope(
+                scopedName(_collEntity1, _ecm, "::", 0), "::"));
+              contactMsg->mutable_collision2()->set_name(
+                removeParentScope(
+                scopedName(collEntity2, _ecm, "::", 0), "::"));
+            }
           }
-          for (const auto &contact : contactData)
+
+          if (this->maxContactsPerPair > 0u &&
+              pairCount >= this->maxContactsPerPair)
           {
-            auto *position = contactMsg->add_position();
-            position->set_x(contact->point.x());
-            position->set_y(contact->point.y());
-            position->set_z(contact->point.z());
+            continue;
           }
+          ++pairCount;
+
+          auto *position = contactMsg->add_position();
+          position->set_x(it->point.X());
+          position->set_y(it->point.Y());
+          position->set_z(it->point.Z());
         }
 
         auto state = _contacts->SetData(contactsComp,
@@ -3402,6 +4420,7 @@ void PhysicsPrivate::DisableContactSurfaceCustomization(const Entity &_world)
 IGNITION_ADD_PLUGIN(Physics,
                     ignition::gazebo::System,
                     Physics::ISystemConfigure,
+                    Physics::ISystemReset,
                     Physics::ISystemUpdate)
 
 IGNITION_ADD_PLUGIN_ALIAS(Physics, "ignition::gazebo::systems::Physics")
@@ -66,20 +66,73 @@ namespace systems
   /// \brief Base class for a System.
   /// Includes optional parameter : <include_entity_names>. When set
   /// to false, the name of colliding entities is not populated in
-  /// the contacts. Remains true by default. Usage :
+  /// the contacts. Remains true by default. The optional
+  /// <max_contacts_per_pair> limits the number of contact points reported
+  /// for each pair of colliding entities, 0 by default, which means there's
+  /// no limit. Usage :
   /// ```
   ///  <plugin
   ///    filename="ignition-gazebo-physics-system"
   ///    name="ignition::gazebo::systems::Physics">
   ///    <contacts>
   ///      <include_entity_names>false</include_entity_names>
+  ///      <max_contacts_per_pair>4</max_contacts_per_pair>
   ///    </contacts>
   ///  </plugin>
   ///  ```
+  ///
+  /// If the optional <sleeping> element is present, links which haven't
+  /// moved for a number of steps are marked with a
+  /// components::Sleeping set to true, and so are models whose top-level
+  /// model has no links awake. They're woken up as soon as they move. The
+  /// world poses and velocities of entities attached to sleeping links,
+  /// such as collisions and sensors, aren't recomputed, and other systems
+  /// can skip sleeping entities with EntityComponentManager::EachAwake.
+  /// The number of steps is set with <idle_steps>, 50 by default. Usage :
+  /// ```
+  ///  <plugin
+  ///    filename="ignition-gazebo-physics-system"
+  ///    name="ignition::gazebo::systems::Physics">
+  ///    <sleeping>
+  ///      <idle_steps>100</idle_steps>
+  ///    </sleeping>
+  ///  </plugin>
+  ///  ```
+  ///
+  /// Bounding boxes are computed for models with a
+  /// components::AxisAlignedBox, and only recomputed when the model moves,
+  /// or when another system writes the box.
+  /// The optional <bounding_boxes><update_rate> element limits how often,
+  /// in Hz of sim time, they're recomputed. By default they're recomputed
+  /// on every iteration. Usage :
+  /// ```
+  ///  <plugin
+  ///    filename="ignition-gazebo-physics-system"
+  ///    name="ignition::gazebo::systems::Physics">
+  ///    <bounding_boxes>
+  ///      <update_rate>10</update_rate>
+  ///    </bounding_boxes>
+  ///  </plugin>
+  ///  ```
+  ///
+  /// The optional <substeps> element sets the number of physics engine
+  /// steps taken on each simulation iteration, 1 by default. Each substep
+  /// lasts the world's step size divided by the number of substeps. Joint
+  /// force, joint velocity, wrench, and model and link velocity commands
+  /// are held during all substeps. This allows running stiff physics at a
+  /// higher rate than the rest of the simulation. Usage :
+  /// ```
+  ///  <plugin
+  ///    filename="ignition-gazebo-physics-system"
+  ///    name="ignition::gazebo::systems::Physics">
+  ///    <substeps>16</substeps>
+  ///  </plugin>
+  ///  ```
 
   class Physics:
     public System,
     public ISystemConfigure,
+    public ISystemReset,
     public ISystemUpdate
   {
     /// \brief Constructor
@@ -94,6 +147,10 @@ namespace systems
                            EntityComponentManager &_ecm,
                            EventManager &_eventMgr) final;
 
+    // Documentation inherited
+    public: void Reset(const UpdateInfo &_info,
+                EntityComponentManager &_ecm) final;
+
     /// Documentation inherited
     public: void Update(const UpdateInfo &_info,
                 EntityComponentManager &_ecm) final;
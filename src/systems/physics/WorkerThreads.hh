@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_PHYSICS_WORKER_THREADS_HH_
+#define IGNITION_GAZEBO_SYSTEMS_PHYSICS_WORKER_THREADS_HH_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition::gazebo
+{
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems::physics_system
+{
+  /// \brief Threads which are kept alive between calls to Run, so work can
+  /// be split across threads on every step without creating threads on
+  /// every step.
+  ///
+  /// Threads are created the first time they're needed, and are joined on
+  /// destruction. Run must only be called from one thread at a time.
+  class WorkerThreads
+  {
+    /// \brief Default constructor
+    public: WorkerThreads() = default;
+
+    /// \brief Not copyable, threads point to this object.
+    public: WorkerThreads(const WorkerThreads &) = delete;
+
+    /// \brief Not copyable, threads point to this object.
+    public: WorkerThreads &operator=(const WorkerThreads &) = delete;
+
+    /// \brief Destructor, stops and joins all threads.
+    public: ~WorkerThreads()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+      }
+      this->start.notify_all();
+      for (auto &thread : this->threads)
+        thread.join();
+    }
+
+    /// \brief Call a function on a number of threads, and wait for all of
+    /// them to return. The calling thread is one of them.
+    /// \param[in] _count Number of threads, including the calling thread.
+    /// \param[in] _work Function called with the index of each thread, from
+    /// 0 to _count - 1. Index 0 is the calling thread.
+    public: template <typename WorkT>
+            void Run(std::size_t _count, WorkT &_work)
+    {
+      if (_count <= 1u)
+      {
+        _work(0u);
+        return;
+      }
+
+      // Create missing threads. They haven't seen the next round yet.
+      while (this->threads.size() + 1u < _count)
+      {
+        this->threads.emplace_back(&WorkerThreads::Loop, this,
+            this->threads.size() + 1u, this->round);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->work = [](void *_data, std::size_t _index)
+        {
+          (*static_cast<WorkT *>(_data))(_index);
+        };
+        this->workData = &_work;
+        this->activeCount = _count;
+        this->pending = _count - 1u;
+        ++this->round;
+      }
+      this->start.notify_all();
+
+      _work(0u);
+
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->done.wait(lock, [this]
+      {
+        return this->pending == 0u;
+      });
+    }
+
+    /// \brief Number of threads created so far, not counting the calling
+    /// thread.
+    /// \return Number of threads.
+    public: std::size_t ThreadCount() const
+    {
+      return this->threads.size();
+    }
+
+    /// \brief Thread loop. Waits for new rounds of work, and takes part in
+    /// the ones which need its index.
+    /// \param[in] _index Index of the thread, starting at 1.
+    /// \param[in] _round Last round which the thread won't take part in.
+    private: void Loop(std::size_t _index, std::uint64_t _round)
+    {
+      std::uint64_t lastRound{_round};
+      while (true)
+      {
+        void (*workFunction)(void *, std::size_t){nullptr};
+        void *data{nullptr};
+        {
+          std::unique_lock<std::mutex> lock(this->mutex);
+          this->start.wait(lock, [&]
+          {
+            return this->stop || this->round != lastRound;
+          });
+          if (this->stop)
+            return;
+
+          lastRound = this->round;
+          if (_index >= this->activeCount)
+            continue;
+
+          workFunction = this->work;
+          data = this->workData;
+        }
+
+        workFunction(data, _index);
+
+        bool last{false};
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          last = --this->pending == 0u;
+        }
+        if (last)
+          this->done.notify_one();
+      }
+    }
+
+    /// \brief Calls the work function of the current round.
+    private: void (*work)(void *, std::size_t){nullptr};
+
+    /// \brief Work function of the current round.
+    private: void *workData{nullptr};
+
+    /// \brief Number of threads in the current round, including the calling
+    /// thread.
+    private: std::size_t activeCount{0u};
+
+    /// \brief Number of threads which haven't finished the current round,
+    /// not counting the calling thread.
+    private: std::size_t pending{0u};
+
+    /// \brief Incremented for each round of work.
+    private: std::uint64_t round{0u};
+
+    /// \brief Whether threads should exit.
+    private: bool stop{false};
+
+    /// \brief Protects the members above.
+    private: std::mutex mutex;
+
+    /// \brief Signaled when a round starts or threads should exit.
+    private: std::condition_variable start;
+
+    /// \brief Signaled when all threads have finished a round.
+    private: std::condition_variable done;
+
+    /// \brief Worker threads.
+    private: std::vector<std::thread> threads;
+  };
+}
+}
+}
+
+#endif
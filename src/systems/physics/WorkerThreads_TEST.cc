@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "WorkerThreads.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ignition;
+using namespace ignition::gazebo::systems::physics_system;
+
+/////////////////////////////////////////////////
+TEST(WorkerThreads, SingleThread)
+{
+  WorkerThreads workers;
+  std::vector<std::thread::id> ids;
+  auto work = [&](std::size_t _index)
+  {
+    EXPECT_EQ(0u, _index);
+    ids.push_back(std::this_thread::get_id());
+  };
+  workers.Run(1u, work);
+
+  // The calling thread does the work, no threads are created
+  ASSERT_EQ(1u, ids.size());
+  EXPECT_EQ(std::this_thread::get_id(), ids[0]);
+  EXPECT_EQ(0u, workers.ThreadCount());
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerThreads, ThreadsAreReused)
+{
+  WorkerThreads workers;
+  const std::size_t count{4u};
+
+  for (int round = 0; round < 100; ++round)
+  {
+    std::vector<int> calls(count, 0);
+    std::vector<std::thread::id> ids(count);
+    auto work = [&](std::size_t _index)
+    {
+      ASSERT_LT(_index, count);
+      ++calls[_index];
+      ids[_index] = std::this_thread::get_id();
+    };
+    workers.Run(count, work);
+
+    // Each index is called exactly once, on different threads, and the
+    // calling thread takes index 0
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_EQ(1, calls[i]) << round << " " << i;
+    EXPECT_EQ(std::this_thread::get_id(), ids[0]);
+    for (std::size_t i = 1; i < count; ++i)
+      EXPECT_NE(ids[0], ids[i]);
+
+    // Threads are only created once
+    EXPECT_EQ(count - 1u, workers.ThreadCount());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerThreads, VaryingCount)
+{
+  WorkerThreads workers;
+  for (std::size_t count : {2u, 5u, 1u, 3u, 5u, 2u})
+  {
+    std::atomic<std::size_t> calls{0u};
+    std::vector<std::atomic<int>> perIndex(count);
+    auto work = [&](std::size_t _index)
+    {
+      ++calls;
+      ++perIndex[_index];
+    };
+    workers.Run(count, work);
+
+    EXPECT_EQ(count, calls.load());
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_EQ(1, perIndex[i].load()) << count << " " << i;
+  }
+
+  // Only as many threads as the largest round needed
+  EXPECT_EQ(4u, workers.ThreadCount());
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerThreads, SplitWork)
+{
+  // Sum a range in parallel, the way the physics system splits links
+  std::vector<int> values(1000);
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<int>(i);
+
+  WorkerThreads workers;
+  const std::size_t count{3u};
+  std::vector<long> sums(count, 0);
+  std::atomic<std::size_t> next{0u};
+  auto work = [&](std::size_t _index)
+  {
+    for (auto i = next++; i < values.size(); i = next++)
+      sums[_index] += values[i];
+  };
+  workers.Run(count, work);
+
+  long total{0};
+  for (auto sum : sums)
+    total += sum;
+  EXPECT_EQ(999 * 1000 / 2, total);
+}
@@ -24,6 +24,7 @@
 #include <condition_variable>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <ignition/common/Profiler.hh>
@@ -52,6 +53,7 @@
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/RgbdCamera.hh"
 #include "ignition/gazebo/components/Sensor.hh"
+#include "ignition/gazebo/components/Sleeping.hh"
 #include "ignition/gazebo/components/Static.hh"
 #include "ignition/gazebo/components/ThermalCamera.hh"
 #include "ignition/gazebo/components/Visual.hh"
@@ -166,6 +168,18 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   public: void PoseUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_manager);
 
+  /// \brief Whether an entity can be left out of dynamic pose messages
+  /// because it's sleeping. Entities are only left out once they've been
+  /// sleeping for long enough that their final pose made it through the
+  /// publisher's throttling.
+  /// \param[in] _entity Model or link entity
+  /// \param[in] _manager The entity component manager
+  /// \param[in] _now Current wall-clock time
+  /// \return True if the entity should be left out.
+  public: bool SkipSleeping(const Entity _entity,
+    const EntityComponentManager &_manager,
+    const std::chrono::steady_clock::time_point &_now);
+
   /// \brief Transport node.
   public: std::unique_ptr<transport::Node> node{nullptr};
 
@@ -178,6 +192,11 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \brief Rate at which to publish dynamic poses
   public: int dyPoseHertz{60};
 
+  /// \brief Wall-clock time at which sleeping models and links were first
+  /// seen sleeping.
+  public: std::unordered_map<Entity, std::chrono::steady_clock::time_point>
+      sleepingSince;
+
   /// \brief Scene publisher
   public: transport::Node::Publisher scenePub;
 
@@ -372,6 +391,28 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
   }
 }
 
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::SkipSleeping(const Entity _entity,
+    const EntityComponentManager &_manager,
+    const std::chrono::steady_clock::time_point &_now)
+{
+  auto sleepingComp = _manager.Component<components::Sleeping>(_entity);
+  if (nullptr == sleepingComp || !sleepingComp->Data())
+  {
+    if (!this->sleepingSince.empty())
+      this->sleepingSince.erase(_entity);
+    return false;
+  }
+
+  // Keep publishing for a couple of publishing periods, because messages
+  // may be throttled
+  auto sleepingIt = this->sleepingSince.emplace(_entity, _now).first;
+  const auto gracePeriod = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(std::chrono::duration<double>(
+      2.0 / std::max(1, this->dyPoseHertz)));
+  return _now - sleepingIt->second > gracePeriod;
+}
+
 //////////////////////////////////////////////////
 void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_manager)
@@ -381,6 +422,17 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
   msgs::Pose_V poseMsg, dyPoseMsg;
   bool dyPoseConnections = this->dyPosePub.HasConnections();
   bool poseConnections = this->posePub.HasConnections();
+  const auto now = std::chrono::steady_clock::now();
+
+  if (!this->sleepingSince.empty())
+  {
+    _manager.EachRemoved<components::Sleeping>(
+        [&](const Entity &_entity, const components::Sleeping *) -> bool
+        {
+          this->sleepingSince.erase(_entity);
+          return true;
+        });
+  }
 
   // Models
   _manager.Each<components::Model, components::Name, components::Pose,
@@ -399,7 +451,8 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           pose->set_id(_entity);
         }
 
-        if (dyPoseConnections && !_staticComp->Data())
+        if (dyPoseConnections && !_staticComp->Data() &&
+            !this->SkipSleeping(_entity, _manager, now))
         {
           // Add to dynamic pose msg
           auto dyPose = dyPoseMsg.add_pose();
@@ -430,7 +483,8 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
         // Check whether parent model is static
         auto staticComp = _manager.Component<components::Static>(
           _parentComp->Data());
-        if (dyPoseConnections && !staticComp->Data())
+        if (dyPoseConnections && !staticComp->Data() &&
+            !this->SkipSleeping(_entity, _manager, now))
         {
           // Add to dynamic pose msg
           auto dyPose = dyPoseMsg.add_pose();
@@ -18,6 +18,7 @@
 #include "Sensors.hh"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <utility>
@@ -54,6 +55,7 @@
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/EntityComponentManagerSnapshot.hh"
 
 #include "ignition/gazebo/rendering/Events.hh"
 #include "ignition/gazebo/rendering/RenderUtil.hh"
@@ -132,6 +134,22 @@ class ignition::gazebo::systems::SensorsPrivate
   /// \brief Sensors to include in the next rendering iteration
   public: std::vector<sensors::RenderingSensor *> activeSensors;
 
+  /// \brief Snapshot of the simulation for the next rendering iteration,
+  /// taken on PostUpdate.
+  public: std::shared_ptr<const EntityComponentManagerSnapshot> snapshot;
+
+  /// \brief Update info matching the snapshot.
+  public: UpdateInfo snapshotInfo;
+
+  /// \brief Copy of the simulation ECM, updated from snapshots on the
+  /// rendering thread so that the scene can be updated from it without
+  /// blocking simulation. Only used by the rendering thread.
+  public: EntityComponentManager renderEcm;
+
+  /// \brief True once a snapshot was handed to the rendering thread. Only
+  /// used on PostUpdate.
+  public: bool snapshotSent{false};
+
   /// \brief Mutex to protect sensorMask
   public: std::mutex sensorMaskMutex;
 
@@ -166,7 +184,10 @@ class ignition::gazebo::systems::SensorsPrivate
   ///
   /// Once in steady state, a rendering operation is triggered by setting
   /// updateAvailable to true, and notifying via the renderCv.
-  /// The rendering operation is done in `RunOnce`.
+  /// The rendering operation is done in `RunOnce`. PostUpdate hands it a
+  /// snapshot of the simulation ECM, which is mirrored into renderEcm, so
+  /// the scene is updated from it on this thread instead of reading the
+  /// simulation ECM.
   ///
   /// The caller of PostUpdate will not be blocked if there is no
   /// rendering operation currently ongoing. Rendering will occur
@@ -239,6 +260,12 @@ void SensorsPrivate::RunOnce()
     return;
 
   IGN_PROFILE("SensorsPrivate::RunOnce");
+  {
+    IGN_PROFILE("UpdateFromECM");
+    this->renderEcm.Mirror(this->snapshot);
+    this->renderUtil.UpdateFromECM(this->snapshotInfo, this->renderEcm);
+  }
+
   {
     IGN_PROFILE("Update");
     this->renderUtil.Update();
@@ -515,8 +542,6 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
 
   if (this->dataPtr->running && this->dataPtr->initialized)
   {
-    this->dataPtr->renderUtil.UpdateFromECM(_info, _ecm);
-
     auto time = math::durationToSecNsec(_info.simTime);
     auto t = math::secNsecToDuration(time.first, time.second);
 
@@ -548,9 +573,16 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
     }
     this->dataPtr->sensorMaskMutex.unlock();
 
+    // The rendering thread updates the scene from a snapshot, so it also
+    // needs to run when entities were added or removed, for example to
+    // create new sensors
     if (!activeSensors.empty() ||
-        this->dataPtr->renderUtil.PendingSensors() > 0)
+        this->dataPtr->renderUtil.PendingSensors() > 0 ||
+        !this->dataPtr->snapshotSent || _ecm.HasNewEntities() ||
+        _ecm.HasEntitiesMarkedForRemoval())
     {
+      auto snapshot = _ecm.Snapshot();
+
       std::unique_lock<std::mutex> lock(this->dataPtr->renderMutex);
       this->dataPtr->renderCv.wait(lock, [this] {
         return !this->dataPtr->running || !this->dataPtr->updateAvailable; });
@@ -561,6 +593,9 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
       }
 
       this->dataPtr->activeSensors = std::move(activeSensors);
+      this->dataPtr->snapshot = std::move(snapshot);
+      this->dataPtr->snapshotInfo = _info;
+      this->dataPtr->snapshotSent = true;
       this->dataPtr->updateTime = t;
       this->dataPtr->updateAvailable = true;
       this->dataPtr->renderCv.notify_one();
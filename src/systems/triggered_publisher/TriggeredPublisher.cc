@@ -704,6 +704,18 @@ void TriggeredPublisher::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
 
   if (notify)
     this->newMatchSignal.notify_one();
+
+  // The delay is counted down by the dt of every iteration. Messages can
+  // arrive at any time, so keep counting even when the queue is empty.
+  if (this->delay > 0ms && this->wakeUp)
+    this->wakeUp->Wake();
+}
+
+//////////////////////////////////////////////////
+void TriggeredPublisher::ConfigureWakeUp(
+    const std::shared_ptr<SystemWakeUp> &_wakeUp)
+{
+  this->wakeUp = _wakeUp;
 }
 
 //////////////////////////////////////////////////
@@ -726,7 +738,8 @@ bool TriggeredPublisher::MatchInput(const transport::ProtoMsg &_inputMsg)
 IGNITION_ADD_PLUGIN(TriggeredPublisher,
                     ignition::gazebo::System,
                     TriggeredPublisher::ISystemConfigure,
-                    TriggeredPublisher::ISystemPreUpdate)
+                    TriggeredPublisher::ISystemPreUpdate,
+                    TriggeredPublisher::ISystemWakeUp)
 
 IGNITION_ADD_PLUGIN_ALIAS(TriggeredPublisher,
                           "ignition::gazebo::systems::TriggeredPublisher")
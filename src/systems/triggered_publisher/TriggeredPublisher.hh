@@ -160,7 +160,8 @@ namespace systems
   /// `field="f1.f2"`, `f1` cannot be a repeated field.
   class TriggeredPublisher : public System,
                              public ISystemConfigure,
-                             public ISystemPreUpdate
+                             public ISystemPreUpdate,
+                             public ISystemWakeUp
   {
     /// \brief Constructor
     public: TriggeredPublisher() = default;
@@ -179,6 +180,10 @@ namespace systems
                 const ignition::gazebo::UpdateInfo &_info,
                 ignition::gazebo::EntityComponentManager &_ecm) override;
 
+    // Documentation inherited
+    public: void ConfigureWakeUp(
+                const std::shared_ptr<SystemWakeUp> &_wakeUp) override;
+
     /// \brief Thread that handles publishing output messages
     public: void DoWork();
 
@@ -243,6 +248,10 @@ namespace systems
 
     /// \brief Mutex to synchronize access to publishQueue
     private: std::mutex publishQueueMutex;
+
+    /// \brief Keeps PreUpdate running on every iteration when there's a
+    /// delay to count down. Without a delay, PreUpdate has nothing to do.
+    private: std::shared_ptr<SystemWakeUp> wakeUp;
   };
   }
 }
@@ -492,6 +492,10 @@ class ignition::gazebo::systems::UserCommandsPrivate
   /// \return True if successful.
   public: bool VisualService(const msgs::Visual &_req, msgs::Boolean &_res);
 
+  /// \brief Queue a command for execution on the next PreUpdate.
+  /// \param[in] _cmd Command.
+  public: void QueueCommand(std::unique_ptr<UserCommandBase> _cmd);
+
   /// \brief Queue of commands pending execution.
   public: std::vector<std::unique_ptr<UserCommandBase>> pendingCmds;
 
@@ -503,6 +507,10 @@ class ignition::gazebo::systems::UserCommandsPrivate
 
   /// \brief Mutex to protect pending queue.
   public: std::mutex pendingMutex;
+
+  /// \brief Wakes up PreUpdate when commands are queued. Protected by
+  /// pendingMutex, because services are advertised before it's set.
+  public: std::shared_ptr<SystemWakeUp> wakeUp;
 };
 
 //////////////////////////////////////////////////
@@ -686,6 +694,22 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
   // TODO(louise) Clear redo list
 }
 
+//////////////////////////////////////////////////
+void UserCommands::ConfigureWakeUp(const std::shared_ptr<SystemWakeUp> &_wakeUp)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->pendingMutex);
+  this->dataPtr->wakeUp = _wakeUp;
+}
+
+//////////////////////////////////////////////////
+void UserCommandsPrivate::QueueCommand(std::unique_ptr<UserCommandBase> _cmd)
+{
+  std::lock_guard<std::mutex> lock(this->pendingMutex);
+  this->pendingCmds.push_back(std::move(_cmd));
+  if (this->wakeUp)
+    this->wakeUp->Wake();
+}
+
 //////////////////////////////////////////////////
 bool UserCommandsPrivate::CreateServiceMultiple(
     const msgs::EntityFactory_V &_req, msgs::Boolean &_res)
@@ -700,6 +724,8 @@ bool UserCommandsPrivate::CreateServiceMultiple(
     auto cmd = std::make_unique<CreateCommand>(msgCopy, this->iface);
     this->pendingCmds.push_back(std::move(cmd));
   }
+  if (this->wakeUp)
+    this->wakeUp->Wake();
 
   _res.set_data(true);
   return true;
@@ -715,10 +741,7 @@ bool UserCommandsPrivate::CreateService(const msgs::EntityFactory &_req,
   auto cmd = std::make_unique<CreateCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -734,10 +757,7 @@ bool UserCommandsPrivate::RemoveService(const msgs::Entity &_req,
   auto cmd = std::make_unique<RemoveCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -753,10 +773,7 @@ bool UserCommandsPrivate::LightService(const msgs::Light &_req,
   auto cmd = std::make_unique<LightCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -770,10 +787,7 @@ void UserCommandsPrivate::OnCmdLight(const msgs::Light &_msg)
   auto cmd = std::make_unique<LightCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 }
 
 
@@ -787,10 +801,7 @@ bool UserCommandsPrivate::PoseService(const msgs::Pose &_req,
   auto cmd = std::make_unique<PoseCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -806,10 +817,7 @@ bool UserCommandsPrivate::EnableCollisionService(const msgs::Entity &_req,
   auto cmd = std::make_unique<EnableCollisionCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -825,10 +833,7 @@ bool UserCommandsPrivate::DisableCollisionService(const msgs::Entity &_req,
   auto cmd = std::make_unique<DisableCollisionCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -843,10 +848,7 @@ bool UserCommandsPrivate::PhysicsService(const msgs::Physics &_req,
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<PhysicsCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -861,10 +863,7 @@ bool UserCommandsPrivate::VisualService(const msgs::Visual &_req,
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<VisualCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -879,10 +878,7 @@ bool UserCommandsPrivate::SphericalCoordinatesService(
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<SphericalCoordinatesCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->QueueCommand(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1618,7 +1614,8 @@ bool VisualCommand::Execute()
 
 IGNITION_ADD_PLUGIN(UserCommands, System,
   UserCommands::ISystemConfigure,
-  UserCommands::ISystemPreUpdate
+  UserCommands::ISystemPreUpdate,
+  UserCommands::ISystemWakeUp
 )
 
 IGNITION_ADD_PLUGIN_ALIAS(UserCommands,
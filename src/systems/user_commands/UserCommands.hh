@@ -57,7 +57,8 @@ namespace systems
   class UserCommands:
     public System,
     public ISystemConfigure,
-    public ISystemPreUpdate
+    public ISystemPreUpdate,
+    public ISystemWakeUp
   {
     /// \brief Constructor
     public: explicit UserCommands();
@@ -79,6 +80,11 @@ namespace systems
     public: void PreUpdate(const UpdateInfo &_info,
                            EntityComponentManager &_ecm) final;
 
+    /// \brief PreUpdate is only called when commands are received.
+    /// \param[in] _wakeUp Wake-up conditions of the system.
+    public: void ConfigureWakeUp(
+                const std::shared_ptr<SystemWakeUp> &_wakeUp) final;
+
     /// \brief Private data pointer.
     private: std::unique_ptr<UserCommandsPrivate> dataPtr;
   };
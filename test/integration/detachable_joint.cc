@@ -19,6 +19,7 @@
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
 #include <ignition/msgs/Utility.hh>
+#include <ignition/msgs/world_control.pb.h>
 #include <ignition/transport/Node.hh>
 #include <ignition/utilities/ExtraTestMacros.hh>
 
@@ -27,6 +28,7 @@
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/test_config.hh"
 
+#include "ignition/gazebo/components/DetachableJoint.hh"
 #include "ignition/gazebo/components/LinearAcceleration.hh"
 #include "ignition/gazebo/components/LinearVelocity.hh"
 #include "ignition/gazebo/components/Link.hh"
@@ -213,3 +215,76 @@ TEST_F(DetachableJointTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(LinksInSameModel))
   // the expected distance.
   EXPECT_GT(b2Poses.front().Pos().Z() - b2Poses.back().Pos().Z(), expDist);
 }
+
+/////////////////////////////////////////////////
+TEST_F(DetachableJointTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(ResetAll))
+{
+  using namespace std::chrono_literals;
+
+  this->StartServer("/test/worlds/detachable_joint.sdf");
+
+  // Record the pose of M2 and the number of detachable joints
+  std::vector<math::Pose3d> m2Poses;
+  std::vector<std::size_t> jointCounts;
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+      [&](const gazebo::UpdateInfo &,
+          const gazebo::EntityComponentManager &_ecm)
+      {
+        auto m2 = _ecm.EntityByComponents(components::Model(),
+            components::Name("M2"));
+        ASSERT_NE(kNullEntity, m2);
+        m2Poses.push_back(_ecm.Component<components::Pose>(m2)->Data());
+
+        std::size_t count{0u};
+        _ecm.Each<components::DetachableJoint>(
+            [&](const Entity &, const components::DetachableJoint *) -> bool
+            {
+              ++count;
+              return true;
+            });
+        jointCounts.push_back(count);
+      });
+  this->server->AddSystem(testSystem.systemPtr);
+
+  // The joint is created on the first iteration, after the initial state
+  this->server->Run(true, 20, false);
+  ASSERT_FALSE(m2Poses.empty());
+  const auto initialPose = m2Poses.front();
+  EXPECT_EQ(initialPose, m2Poses.back());
+  EXPECT_EQ(1u, jointCounts.back());
+
+  // Detach, and let M2 fall
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Empty>("/model/M1/detachable_joint/detach");
+  pub.Publish(msgs::Empty());
+  std::this_thread::sleep_for(250ms);
+
+  this->server->Run(true, 100, false);
+  EXPECT_EQ(0u, jointCounts.back());
+  EXPECT_LT(m2Poses.back().Pos().Z(), initialPose.Pos().Z() - 0.01);
+
+  // Reset the whole world
+  msgs::WorldControl req;
+  req.mutable_reset()->set_all(true);
+  msgs::Boolean rep;
+  bool result{false};
+  EXPECT_TRUE(node.Request("/world/detachable_joint/control", req, 1000u,
+      rep, result));
+  EXPECT_TRUE(result);
+
+  m2Poses.clear();
+  jointCounts.clear();
+  this->server->Run(true, 1, false);
+  ASSERT_EQ(1u, m2Poses.size());
+  EXPECT_EQ(initialPose, m2Poses.back());
+  EXPECT_EQ(1u, jointCounts.back());
+
+  // M2 is attached again, so it stays at rest
+  m2Poses.clear();
+  jointCounts.clear();
+  this->server->Run(true, 100, false);
+  ASSERT_EQ(100u, m2Poses.size());
+  EXPECT_EQ(initialPose, m2Poses.back());
+  EXPECT_EQ(1u, jointCounts.back());
+}
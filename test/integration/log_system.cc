@@ -20,10 +20,12 @@
 
 #include <algorithm>
 #include <climits>
+#include <fstream>
 #ifndef __APPLE__
 #include <filesystem>
 #endif
 #include <numeric>
+#include <set>
 #include <string>
 
 #include <ignition/common/Console.hh>
@@ -838,6 +840,87 @@ TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RecordAndPlayback))
   this->RemoveLogsDir();
 }
 
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RecordEntityFilter))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  // Record only the ground plane
+  {
+    const auto recordSdfPath = common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "worlds",
+      "log_record_dbl_pendulum.sdf");
+    std::ifstream sdfFile(recordSdfPath);
+    std::string sdfString((std::istreambuf_iterator<char>(sdfFile)),
+        std::istreambuf_iterator<char>());
+
+    const std::string pluginName{
+        "name=\"ignition::gazebo::systems::LogRecord\">"};
+    auto pos = sdfString.find(pluginName);
+    ASSERT_NE(std::string::npos, pos);
+    sdfString.insert(pos + pluginName.size(),
+        "<record_entity>ground_plane</record_entity>");
+
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(sdfString);
+    recordServerConfig.SetUseLogRecord(true);
+    recordServerConfig.SetLogRecordPath(this->logDir);
+
+    Server recordServer(recordServerConfig);
+    recordServer.Run(true, 10, false);
+  }
+
+  auto logFile = common::joinPaths(this->logDir, "state.tlog");
+  ASSERT_TRUE(common::exists(logFile));
+
+  transport::log::Log log;
+  ASSERT_TRUE(log.Open(logFile));
+
+  auto batch = log.QueryMessages(transport::log::TopicPattern(
+      std::regex(".*/changed_state")));
+  ASSERT_NE(batch.end(), batch.begin());
+
+  // Collect the names of all recorded entities
+  std::set<std::string> names;
+  std::size_t messageCount{0u};
+  for (const auto &msg : batch)
+  {
+    msgs::SerializedStateMap stateMsg;
+    ASSERT_TRUE(stateMsg.ParseFromString(msg.Data()));
+    ++messageCount;
+    for (const auto &entityIter : stateMsg.entities())
+    {
+      for (const auto &compIter : entityIter.second.components())
+      {
+        if (compIter.second.type() != components::Name::typeId)
+          continue;
+        components::Name name;
+        std::istringstream istr(compIter.second.component());
+        name.Deserialize(istr);
+        names.insert(name.Data());
+      }
+    }
+  }
+  EXPECT_EQ(10u, messageCount);
+
+  // The world and the selected model with its children are recorded
+  EXPECT_NE(names.end(), names.find("log_pendulum"));
+  EXPECT_NE(names.end(), names.find("ground_plane"));
+  EXPECT_NE(names.end(), names.find("link"));
+
+  // Other models and lights are not, even though they're children of the
+  // recorded world
+  EXPECT_EQ(names.end(), names.find("double_pendulum_with_base"));
+  EXPECT_EQ(names.end(), names.find("base"));
+  EXPECT_EQ(names.end(), names.find("upper_link"));
+  EXPECT_EQ(names.end(), names.find("lower_link"));
+  EXPECT_EQ(names.end(), names.find("model_00"));
+  EXPECT_EQ(names.end(), names.find("sun"));
+
+  this->RemoveLogsDir();
+}
+
 /////////////////////////////////////////////////
 TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(LogControl))
 {
@@ -18,6 +18,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -27,6 +32,7 @@
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
 #include <ignition/msgs/Utility.hh>
+#include <ignition/transport/Node.hh>
 #include <ignition/utilities/ExtraTestMacros.hh>
 #include <sdf/Collision.hh>
 #include <sdf/Cylinder.hh>
@@ -38,14 +44,19 @@
 #include <sdf/World.hh>
 
 #include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EventManager.hh"
+#include "ignition/gazebo/SdfEntityCreator.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/Util.hh"
 #include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
 
+#include "ignition/gazebo/components/AngularVelocity.hh"
 #include "ignition/gazebo/components/AxisAlignedBox.hh"
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/Collision.hh"
+#include "ignition/gazebo/components/ContactSensorData.hh"
+#include "ignition/gazebo/components/ExternalWorldWrenchCmd.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Inertial.hh"
 #include "ignition/gazebo/components/Joint.hh"
@@ -61,6 +72,7 @@
 #include "ignition/gazebo/components/JointVelocityReset.hh"
 #include "ignition/gazebo/components/Link.hh"
 #include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/LinearVelocityCmd.hh"
 #include "ignition/gazebo/components/Material.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
@@ -68,6 +80,7 @@
 #include "ignition/gazebo/components/Physics.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/PoseCmd.hh"
+#include "ignition/gazebo/components/Sleeping.hh"
 #include "ignition/gazebo/components/Static.hh"
 #include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/components/World.hh"
@@ -1286,6 +1299,304 @@ TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(GetBoundingBox))
 }
 
 
+/////////////////////////////////////////////////
+// Boxes of models which don't move are computed again when they're
+// recreated, or when another system overwrites them.
+TEST_F(PhysicsSystemFixture,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(GetBoundingBoxRecomputed))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/contact.sdf");
+  gazebo::Server server(serverConfig);
+  server.SetUpdatePeriod(1ns);
+
+  const math::AxisAlignedBox expected(
+      math::Vector3d(-1.25, -2, 0), math::Vector3d(-0.25, 2, 1));
+  const math::AxisAlignedBox bogus(
+      math::Vector3d(-1, -1, -1), math::Vector3d(1, 1, 1));
+
+  Entity box1{kNullEntity};
+  std::vector<std::optional<math::AxisAlignedBox>> boxes;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    {
+      if (kNullEntity == box1)
+      {
+        box1 = _ecm.EntityByComponents(components::Model(),
+            components::Name("box1"));
+      }
+      ASSERT_NE(kNullEntity, box1);
+
+      switch (_info.iterations)
+      {
+        case 1:
+        case 6:
+          _ecm.CreateComponent(box1, components::AxisAlignedBox());
+          break;
+        case 3:
+          _ecm.SetComponentData<components::AxisAlignedBox>(box1, bogus);
+          _ecm.SetChanged(box1, components::AxisAlignedBox::typeId,
+              ComponentState::OneTimeChange);
+          break;
+        case 5:
+          _ecm.RemoveComponent<components::AxisAlignedBox>(box1);
+          break;
+        default:
+          break;
+      }
+    });
+  testSystem.OnPostUpdate(
+    [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+    {
+      auto bboxComp = _ecm.Component<components::AxisAlignedBox>(box1);
+      boxes.push_back(bboxComp ?
+          std::optional<math::AxisAlignedBox>(bboxComp->Data()) :
+          std::nullopt);
+    });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 7, false);
+
+  ASSERT_EQ(7u, boxes.size());
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    // Removed on the 5th iteration
+    if (4u == i)
+    {
+      EXPECT_FALSE(boxes[i].has_value());
+      continue;
+    }
+    ASSERT_TRUE(boxes[i].has_value()) << i;
+    EXPECT_EQ(expected, *boxes[i]) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+// Bounding boxes of many models are computed. Nested models share engine
+// state with their parent, so this checks that both get correct boxes.
+TEST_F(PhysicsSystemFixture,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(GetBoundingBoxNestedModels))
+{
+  const int modelCount{40};
+  const std::string boxLink{R"(
+            <link name="link">
+              <collision name="collision">
+                <geometry>
+                  <box>
+                    <size>1 1 1</size>
+                  </box>
+                </geometry>
+              </collision>
+            </link>)"};
+
+  std::ostringstream sdfStr;
+  sdfStr << R"(
+    <sdf version="1.8">
+      <world name="bounding_boxes">
+        <plugin
+          filename="ignition-gazebo-physics-system"
+          name="ignition::gazebo::systems::Physics">
+        </plugin>)";
+  for (int i = 0; i < modelCount; ++i)
+  {
+    sdfStr << "<model name=\"model_" << i << "\">"
+           << "<static>true</static>"
+           << "<pose>" << i * 3 << " 0 0.5 0 0 0</pose>"
+           << boxLink
+           << "<model name=\"nested_" << i << "\">"
+           << "<static>true</static>"
+           << "<pose>0 0 2 0 0 0</pose>"
+           << boxLink
+           << "</model>"
+           << "</model>";
+  }
+  sdfStr << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfStr.str());
+  gazebo::Server server(serverConfig);
+
+  std::map<std::string, math::AxisAlignedBox> bbox;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+      [&](const gazebo::UpdateInfo &, gazebo::EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Model>(
+            [&](const Entity &_entity, const components::Model *) -> bool
+            {
+              if (!_ecm.EntityHasComponentType(_entity,
+                    components::AxisAlignedBox::typeId))
+              {
+                _ecm.CreateComponent(_entity, components::AxisAlignedBox());
+              }
+              return true;
+            });
+      });
+  testSystem.OnPostUpdate(
+      [&](const gazebo::UpdateInfo &,
+          const gazebo::EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Model, components::Name,
+                  components::AxisAlignedBox>(
+            [&](const Entity &, const components::Model *,
+                const components::Name *_name,
+                const components::AxisAlignedBox *_aabb) -> bool
+            {
+              bbox[_name->Data()] = _aabb->Data();
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 2, false);
+
+  ASSERT_EQ(static_cast<std::size_t>(modelCount * 2), bbox.size());
+  for (int i = 0; i < modelCount; ++i)
+  {
+    const double x = i * 3.0;
+    EXPECT_EQ(math::AxisAlignedBox(
+        math::Vector3d(x - 0.5, -0.5, 2), math::Vector3d(x + 0.5, 0.5, 3)),
+        bbox["nested_" + std::to_string(i)]) << i;
+
+    // The parent's box contains at least its own link
+    const auto &parentBox = bbox["model_" + std::to_string(i)];
+    EXPECT_TRUE(parentBox.Contains(math::Vector3d(x - 0.5, -0.5, 0))) << i;
+    EXPECT_TRUE(parentBox.Contains(math::Vector3d(x + 0.5, 0.5, 1))) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+// Many entities created in the same step, at load and at runtime, go through
+// reserved entity maps and take their top level model from their parent.
+// Nested bounding boxes are only updated when the top level model of their
+// links is known.
+TEST_F(PhysicsSystemFixture,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(ReservedEntityCreation))
+{
+  const int modelCount{40};
+  auto modelSdf = [](const std::string &_name, double _x, double _y)
+  {
+    const std::string boxLink{R"(
+            <link name="link">
+              <collision name="collision">
+                <geometry>
+                  <box>
+                    <size>1 1 1</size>
+                  </box>
+                </geometry>
+              </collision>
+            </link>)"};
+
+    std::ostringstream str;
+    str << "<model name=\"" << _name << "\">"
+        << "<pose>" << _x << " " << _y << " 0.5 0 0 0</pose>"
+        << boxLink
+        << "<model name=\"nested\">"
+        << "<pose>0 0 2 0 0 0</pose>"
+        << boxLink
+        << "</model>"
+        << "</model>";
+    return str.str();
+  };
+
+  std::ostringstream sdfStr;
+  sdfStr << R"(
+    <sdf version="1.8">
+      <world name="reserved_entities">
+        <plugin
+          filename="ignition-gazebo-physics-system"
+          name="ignition::gazebo::systems::Physics">
+        </plugin>)";
+  for (int i = 0; i < modelCount; ++i)
+    sdfStr << modelSdf("loaded_" + std::to_string(i), i * 3.0, 0.0);
+  sdfStr << "</world></sdf>";
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfStr.str());
+  gazebo::Server server(serverConfig);
+
+  // Bounding boxes of each top level model, and of its nested model
+  std::map<std::string, math::AxisAlignedBox> bbox;
+  std::map<std::string, math::AxisAlignedBox> nestedBbox;
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+      [&](const gazebo::UpdateInfo &, gazebo::EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+        _ecm.Each<components::Model>(
+            [&](const Entity &_entity, const components::Model *) -> bool
+            {
+              if (!_ecm.EntityHasComponentType(_entity,
+                    components::AxisAlignedBox::typeId))
+              {
+                _ecm.CreateComponent(_entity, components::AxisAlignedBox());
+              }
+              return true;
+            });
+      });
+  testSystem.OnPostUpdate(
+      [&](const gazebo::UpdateInfo &,
+          const gazebo::EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Model, components::Name,
+                  components::AxisAlignedBox, components::ParentEntity>(
+            [&](const Entity &, const components::Model *,
+                const components::Name *_name,
+                const components::AxisAlignedBox *_aabb,
+                const components::ParentEntity *_parent) -> bool
+            {
+              if (_name->Data() == "nested")
+              {
+                auto parentName =
+                    _ecm.Component<components::Name>(_parent->Data());
+                nestedBbox[parentName->Data()] = _aabb->Data();
+              }
+              else
+              {
+                bbox[_name->Data()] = _aabb->Data();
+              }
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(nullptr, ecm);
+
+  // Spawn as many models again in a single step, while the maps already
+  // hold the loaded ones
+  auto worldEntity = ecm->EntityByComponents(components::World());
+  ASSERT_NE(kNullEntity, worldEntity);
+
+  EventManager eventMgr;
+  SdfEntityCreator creator(*ecm, eventMgr);
+  for (int i = 0; i < modelCount; ++i)
+  {
+    sdf::Root root;
+    auto errors = root.LoadSdfString("<sdf version=\"1.8\">" +
+        modelSdf("spawned_" + std::to_string(i), i * 3.0, 5.0) + "</sdf>");
+    ASSERT_TRUE(errors.empty()) << errors[0];
+    ASSERT_NE(nullptr, root.Model());
+
+    auto modelEntity = creator.CreateEntities(root.Model());
+    creator.SetParent(modelEntity, worldEntity);
+  }
+
+  // Let the models fall
+  server.Run(true, 200, false);
+
+  ASSERT_EQ(static_cast<std::size_t>(modelCount * 2), bbox.size());
+  ASSERT_EQ(static_cast<std::size_t>(modelCount * 2), nestedBbox.size());
+  for (const auto &[name, box] : bbox)
+  {
+    // The top level model fell, and its nested model fell with it
+    EXPECT_LT(box.Min().Z(), -0.1) << name;
+    const auto &nested = nestedBbox[name];
+    EXPECT_NEAR(box.Min().Z() + 2.0, nested.Min().Z(), 1e-6) << name;
+    EXPECT_NEAR(box.Max().Z(), nested.Max().Z(), 1e-6) << name;
+  }
+}
+
 /////////////////////////////////////////////////
 // This tests whether nested models can be loaded correctly
 TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(NestedModel))
@@ -2196,3 +2507,603 @@ TEST_F(PhysicsSystemFixture,
     EXPECT_NEAR(0.0, wrench.torque().z(), 1e-3);
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(PhysicsSystemFixture,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(MaxContactsPerPair))
+{
+  // Get the largest number of contact points reported in any iteration for
+  // a box resting on the ground
+  auto maxPositions = [](int _limit) -> int
+  {
+    std::ostringstream sdfStr;
+    sdfStr << R"(
+    <sdf version="1.6">
+      <world name="max_contacts">
+        <physics name="1ms" type="ignored">
+          <max_step_size>0.001</max_step_size>
+          <real_time_factor>0</real_time_factor>
+        </physics>
+        <plugin
+          filename="ignition-gazebo-physics-system"
+          name="ignition::gazebo::systems::Physics">
+          <contacts>
+            <max_contacts_per_pair>)" << _limit << R"(</max_contacts_per_pair>
+          </contacts>
+        </plugin>
+        <model name="ground">
+          <static>true</static>
+          <link name="ground_link">
+            <collision name="ground_collision">
+              <geometry>
+                <plane>
+                  <normal>0 0 1</normal>
+                  <size>10 10</size>
+                </plane>
+              </geometry>
+            </collision>
+          </link>
+        </model>
+        <model name="box">
+          <pose>0 0 0.5 0 0 0</pose>
+          <link name="box_link">
+            <collision name="box_collision">
+              <geometry>
+                <box>
+                  <size>1 1 1</size>
+                </box>
+              </geometry>
+            </collision>
+          </link>
+        </model>
+      </world>
+    </sdf>)";
+
+    ServerConfig serverConfig;
+    serverConfig.SetSdfString(sdfStr.str());
+    gazebo::Server server(serverConfig);
+
+    test::Relay testSystem;
+    testSystem.OnPreUpdate(
+        [&](const gazebo::UpdateInfo &, gazebo::EntityComponentManager &_ecm)
+        {
+          auto collision = _ecm.EntityByComponents(components::Collision(),
+              components::Name("box_collision"));
+          if (!_ecm.EntityHasComponentType(collision,
+                components::ContactSensorData::typeId))
+          {
+            _ecm.CreateComponent(collision, components::ContactSensorData());
+          }
+        });
+
+    int maxCount{0};
+    testSystem.OnPostUpdate(
+        [&](const gazebo::UpdateInfo &,
+            const gazebo::EntityComponentManager &_ecm)
+        {
+          _ecm.Each<components::Collision, components::ContactSensorData>(
+              [&](const Entity &, const components::Collision *,
+                  const components::ContactSensorData *_contacts) -> bool
+              {
+                for (const auto &contact : _contacts->Data().contact())
+                  maxCount = std::max(maxCount, contact.position_size());
+                return true;
+              });
+        });
+    server.AddSystem(testSystem.systemPtr);
+    server.Run(true, 100, false);
+    return maxCount;
+  };
+
+  // The box touches the ground at several points
+  int unlimited = maxPositions(0);
+  ASSERT_GT(unlimited, 1);
+
+  EXPECT_EQ(1, maxPositions(1));
+  EXPECT_EQ(std::min(unlimited, 2), maxPositions(2));
+}
+
+/////////////////////////////////////////////////
+// Check that substeps integrate motion at the substep size, and that
+// commands are held during all substeps
+TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(Substeps))
+{
+  const double dt{0.004};
+  const int iterations{250};
+  const double gravity{9.8};
+  const double z0{10.0};
+
+  // Final poses of the falling, pushed and commanded models
+  struct Poses
+  {
+    math::Pose3d falling;
+    math::Pose3d pushed;
+    math::Pose3d commanded;
+  };
+
+  auto run = [&](unsigned int _substeps) -> Poses
+  {
+    const std::string link{R"(
+          <link name="link">
+            <inertial>
+              <mass>1</mass>
+            </inertial>
+          </link>)"};
+
+    std::ostringstream sdfStr;
+    sdfStr << R"(
+    <sdf version="1.8">
+      <world name="substeps">
+        <physics name="default" type="ignored">
+          <max_step_size>)" << dt << R"(</max_step_size>
+          <real_time_factor>0</real_time_factor>
+        </physics>
+        <plugin
+          filename="ignition-gazebo-physics-system"
+          name="ignition::gazebo::systems::Physics">
+          <substeps>)" << _substeps << R"(</substeps>
+        </plugin>
+        <model name="falling">
+          <pose>0 0 )" << z0 << R"( 0 0 0</pose>)" << link << R"(
+        </model>
+        <model name="pushed">
+          <pose>0 5 )" << z0 << R"( 0 0 0</pose>)" << link << R"(
+        </model>
+        <model name="commanded">
+          <pose>0 10 )" << z0 << R"( 0 0 0</pose>)" << link << R"(
+        </model>
+      </world>
+    </sdf>)";
+
+    ServerConfig serverConfig;
+    serverConfig.SetSdfString(sdfStr.str());
+    gazebo::Server server(serverConfig);
+
+    Poses poses;
+    test::Relay testSystem;
+    testSystem.OnPreUpdate(
+        [&](const gazebo::UpdateInfo &, gazebo::EntityComponentManager &_ecm)
+        {
+          // 1 N along X on the 1 kg pushed link, set on every iteration
+          auto pushedModel = _ecm.EntityByComponents(components::Model(),
+              components::Name("pushed"));
+          auto pushedLink = _ecm.ChildrenByComponents(pushedModel,
+              components::Link()).front();
+          msgs::Wrench wrench;
+          msgs::Set(wrench.mutable_force(), math::Vector3d::UnitX);
+          msgs::Set(wrench.mutable_torque(), math::Vector3d::Zero);
+          auto wrenchComp =
+              _ecm.Component<components::ExternalWorldWrenchCmd>(pushedLink);
+          if (nullptr == wrenchComp)
+          {
+            _ecm.CreateComponent(pushedLink,
+                components::ExternalWorldWrenchCmd(wrench));
+          }
+          else
+          {
+            wrenchComp->Data() = wrench;
+          }
+
+          // 1 m/s along X on the commanded model, set on every iteration
+          auto commandedModel = _ecm.EntityByComponents(components::Model(),
+              components::Name("commanded"));
+          auto velComp =
+              _ecm.Component<components::LinearVelocityCmd>(commandedModel);
+          if (nullptr == velComp)
+          {
+            _ecm.CreateComponent(commandedModel,
+                components::LinearVelocityCmd(math::Vector3d::UnitX));
+          }
+          else
+          {
+            velComp->Data() = math::Vector3d::UnitX;
+          }
+        });
+    testSystem.OnPostUpdate(
+        [&](const gazebo::UpdateInfo &,
+            const gazebo::EntityComponentManager &_ecm)
+        {
+          _ecm.Each<components::Model, components::Name, components::Pose>(
+              [&](const Entity &, const components::Model *,
+                  const components::Name *_name,
+                  const components::Pose *_pose) -> bool
+              {
+                if (_name->Data() == "falling")
+                  poses.falling = _pose->Data();
+                else if (_name->Data() == "pushed")
+                  poses.pushed = _pose->Data();
+                else if (_name->Data() == "commanded")
+                  poses.commanded = _pose->Data();
+                return true;
+              });
+        });
+    server.AddSystem(testSystem.systemPtr);
+    server.Run(true, iterations, false);
+    return poses;
+  };
+
+  const unsigned int substeps{4u};
+  const Poses single = run(1u);
+  const Poses substepped = run(substeps);
+
+  // Free fall integrated with smaller steps is closer to the exact solution
+  const double t = dt * iterations;
+  const double exactZ = z0 - 0.5 * gravity * t * t;
+  EXPECT_NEAR(exactZ, substepped.falling.Pos().Z(), 0.01);
+  EXPECT_LT(std::abs(exactZ - substepped.falling.Pos().Z()),
+            std::abs(exactZ - single.falling.Pos().Z()));
+
+  // The wrench is applied during all substeps, so the link accelerates at
+  // 1 m/s^2 for the whole time. If it were only applied on the first
+  // substep, it would only cover a quarter of the distance.
+  EXPECT_NEAR(0.5 * t * t, single.pushed.Pos().X(), 0.01);
+  EXPECT_NEAR(0.5 * t * t, substepped.pushed.Pos().X(), 0.01);
+
+  // The velocity command is applied during all substeps, so gravity only
+  // accelerates the model during one substep at a time.
+  const double substepDt = dt / substeps;
+  EXPECT_NEAR(t, substepped.commanded.Pos().X(), 0.01);
+  EXPECT_LT(z0 - substepped.commanded.Pos().Z(),
+            1.5 * iterations * gravity * substepDt * dt);
+  EXPECT_LT(z0 - substepped.commanded.Pos().Z(),
+            z0 - single.commanded.Pos().Z());
+}
+
+/////////////////////////////////////////////////
+// Check that links at rest fall asleep, that they wake up on contact and
+// on commands, and that sleeping models are left out of dynamic poses
+TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(Sleeping))
+{
+  // Without gravity, boxes stay at rest until they're commanded or hit
+  const std::string sdfStr{R"(
+    <sdf version="1.8">
+      <world name="sleeping">
+        <gravity>0 0 0</gravity>
+        <physics name="default" type="ignored">
+          <max_step_size>0.001</max_step_size>
+          <real_time_factor>1</real_time_factor>
+        </physics>
+        <plugin
+          filename="ignition-gazebo-physics-system"
+          name="ignition::gazebo::systems::Physics">
+          <sleeping>
+            <idle_steps>10</idle_steps>
+          </sleeping>
+        </plugin>
+        <plugin
+          filename="ignition-gazebo-scene-broadcaster-system"
+          name="ignition::gazebo::systems::SceneBroadcaster">
+          <dynamic_pose_hertz>100</dynamic_pose_hertz>
+        </plugin>
+        <model name="sleeper">
+          <pose>0 0 0 0 0 0</pose>
+          <link name="sleeper_link">
+            <collision name="collision">
+              <geometry><box><size>1 1 1</size></box></geometry>
+            </collision>
+          </link>
+        </model>
+        <model name="bullet">
+          <pose>-3 0 0 0 0 0</pose>
+          <link name="bullet_link">
+            <collision name="collision">
+              <geometry><box><size>1 1 1</size></box></geometry>
+            </collision>
+          </link>
+        </model>
+        <model name="commanded">
+          <pose>0 5 0 0 0 0</pose>
+          <link name="commanded_link">
+            <collision name="collision">
+              <geometry><box><size>1 1 1</size></box></geometry>
+            </collision>
+          </link>
+        </model>
+      </world>
+    </sdf>)"};
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfStr);
+  gazebo::Server server(serverConfig);
+
+  // Names of the entities in each dynamic pose message, by sim time
+  std::mutex mutex;
+  std::map<std::chrono::steady_clock::duration, std::set<std::string>>
+      dynamicPoses;
+  std::function<void(const msgs::Pose_V &)> cb =
+      [&](const msgs::Pose_V &_msg)
+      {
+        std::set<std::string> names;
+        for (const auto &pose : _msg.pose())
+          names.insert(pose.name());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        dynamicPoses[math::secNsecToDuration(_msg.header().stamp().sec(),
+            _msg.header().stamp().nsec())] = names;
+      };
+  transport::Node node;
+  node.Subscribe("/world/sleeping/dynamic_pose/info", cb);
+
+  // Whether each model and link is sleeping, by iteration
+  std::map<std::string, std::vector<bool>> sleeping;
+  std::map<std::string, double> xPositions;
+
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+      [&](const gazebo::UpdateInfo &_info,
+          gazebo::EntityComponentManager &_ecm)
+      {
+        auto setVel = [&](const std::string &_name, const math::Vector3d &_v)
+        {
+          auto model = _ecm.EntityByComponents(components::Model(),
+              components::Name(_name));
+          auto velComp = _ecm.Component<components::LinearVelocityCmd>(model);
+          if (nullptr == velComp)
+            _ecm.CreateComponent(model, components::LinearVelocityCmd(_v));
+          else
+            velComp->Data() = _v;
+        };
+
+        // The bullet keeps moving towards the sleeper, and reaches it
+        // after about 200 iterations
+        setVel("bullet", 10 * math::Vector3d::UnitX);
+
+        // The commanded model starts moving after 100 iterations
+        if (_info.iterations > 100)
+          setVel("commanded", math::Vector3d::UnitZ);
+      });
+  testSystem.OnPostUpdate(
+      [&](const gazebo::UpdateInfo &,
+          const gazebo::EntityComponentManager &_ecm)
+      {
+        auto record = [&](const Entity &_entity, const std::string &_name)
+        {
+          auto sleepingComp = _ecm.Component<components::Sleeping>(_entity);
+          sleeping[_name].push_back(
+              nullptr != sleepingComp && sleepingComp->Data());
+        };
+        _ecm.Each<components::Model, components::Name, components::Pose>(
+            [&](const Entity &_entity, const components::Model *,
+                const components::Name *_name,
+                const components::Pose *_pose) -> bool
+            {
+              record(_entity, _name->Data());
+              xPositions[_name->Data()] = _pose->Data().Pos().X();
+              return true;
+            });
+        _ecm.Each<components::Link, components::Name>(
+            [&](const Entity &_entity, const components::Link *,
+                const components::Name *_name) -> bool
+            {
+              record(_entity, _name->Data());
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  const std::size_t iterations{400u};
+  server.Run(true, iterations, false);
+
+  for (const auto &name : {"sleeper", "sleeper_link", "bullet",
+      "bullet_link", "commanded", "commanded_link"})
+  {
+    ASSERT_EQ(iterations, sleeping[name].size()) << name;
+  }
+
+  // Entities which don't move fall asleep after the idle steps
+  for (const auto &name : {"sleeper", "sleeper_link", "commanded",
+      "commanded_link"})
+  {
+    EXPECT_FALSE(sleeping[name][0]) << name;
+    EXPECT_TRUE(sleeping[name][50]) << name;
+    EXPECT_TRUE(sleeping[name][95]) << name;
+  }
+
+  // Moving entities never sleep
+  for (const auto &name : {"bullet", "bullet_link"})
+  {
+    for (std::size_t i = 0; i < iterations; ++i)
+      EXPECT_FALSE(sleeping[name][i]) << name << " " << i;
+  }
+
+  // A velocity command wakes the model up
+  for (const auto &name : {"commanded", "commanded_link"})
+  {
+    for (std::size_t i = 110; i < iterations; ++i)
+      EXPECT_FALSE(sleeping[name][i]) << name << " " << i;
+  }
+
+  // Contact with the bullet wakes the sleeper up and pushes it
+  for (const auto &name : {"sleeper", "sleeper_link"})
+  {
+    EXPECT_TRUE(sleeping[name][150]) << name;
+    EXPECT_FALSE(sleeping[name].back()) << name;
+  }
+  EXPECT_LT(0.1, xPositions["sleeper"]);
+
+  // Wait for the last messages
+  IGN_SLEEP_MS(100);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  bool checkedAsleep{false};
+  bool checkedAwake{false};
+  for (const auto &[time, names] : dynamicPoses)
+  {
+    // Sleeping models are left out once they've been sleeping for a couple
+    // of publishing periods
+    if (time >= 60ms && time <= 95ms)
+    {
+      EXPECT_EQ(0u, names.count("sleeper"));
+      EXPECT_EQ(0u, names.count("sleeper_link"));
+      EXPECT_EQ(0u, names.count("commanded"));
+      EXPECT_EQ(1u, names.count("bullet"));
+      EXPECT_EQ(1u, names.count("bullet_link"));
+      checkedAsleep = true;
+    }
+    // Once they're woken up, they're published again
+    else if (time >= 350ms)
+    {
+      EXPECT_EQ(1u, names.count("sleeper"));
+      EXPECT_EQ(1u, names.count("sleeper_link"));
+      EXPECT_EQ(1u, names.count("commanded"));
+      EXPECT_EQ(1u, names.count("bullet"));
+      checkedAwake = true;
+    }
+  }
+  EXPECT_TRUE(checkedAsleep);
+  EXPECT_TRUE(checkedAwake);
+}
+
+/////////////////////////////////////////////////
+// Check that link states written back in parallel, which happens when many
+// links change, match the ones written back serially
+TEST_F(PhysicsSystemFixture,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(ParallelLinkWriteBack))
+{
+  // State of each pendulum arm link
+  struct ArmState
+  {
+    math::Pose3d pose;
+    math::Pose3d worldPose;
+    math::Vector3d linVel;
+    math::Vector3d angVel;
+  };
+
+  const std::size_t iterations{50u};
+  const double spacing{2.0};
+
+  // Returns the states of each pendulum's arm on each iteration, by
+  // pendulum index
+  auto run = [&](int _count) -> std::vector<std::vector<ArmState>>
+  {
+    std::ostringstream sdfStr;
+    sdfStr << R"(
+    <sdf version="1.8">
+      <world name="write_back">
+        <physics name="default" type="ignored">
+          <max_step_size>0.001</max_step_size>
+          <real_time_factor>0</real_time_factor>
+        </physics>
+        <plugin
+          filename="ignition-gazebo-physics-system"
+          name="ignition::gazebo::systems::Physics">
+        </plugin>)";
+    for (int i = 0; i < _count; ++i)
+    {
+      sdfStr << "<model name=\"pendulum_" << i << "\">"
+             << "<pose>" << i * spacing << R"( 0 2 0 0 0</pose>
+          <link name="base">
+            <inertial><mass>1</mass></inertial>
+          </link>
+          <link name="arm">
+            <pose>0.5 0 0 0 0 0</pose>
+            <inertial>
+              <mass>1</mass>
+              <inertia>
+                <ixx>0.01</ixx>
+                <iyy>0.01</iyy>
+                <izz>0.01</izz>
+              </inertia>
+            </inertial>
+          </link>
+          <joint name="fixed" type="fixed">
+            <parent>world</parent>
+            <child>base</child>
+          </joint>
+          <joint name="hinge" type="revolute">
+            <parent>base</parent>
+            <child>arm</child>
+            <axis><xyz>0 1 0</xyz></axis>
+          </joint>
+        </model>)";
+    }
+    sdfStr << "</world></sdf>";
+
+    ServerConfig serverConfig;
+    serverConfig.SetSdfString(sdfStr.str());
+    gazebo::Server server(serverConfig);
+
+    std::vector<std::vector<ArmState>> states(_count);
+    test::Relay testSystem;
+    testSystem.OnPreUpdate(
+        [&](const gazebo::UpdateInfo &, gazebo::EntityComponentManager &_ecm)
+        {
+          _ecm.Each<components::Link>(
+              [&](const Entity &_entity, const components::Link *) -> bool
+              {
+                if (!_ecm.Component<components::WorldPose>(_entity))
+                {
+                  _ecm.CreateComponent(_entity, components::WorldPose());
+                  _ecm.CreateComponent(_entity,
+                      components::WorldLinearVelocity());
+                  _ecm.CreateComponent(_entity,
+                      components::WorldAngularVelocity());
+                }
+                return true;
+              });
+        });
+    testSystem.OnPostUpdate(
+        [&](const gazebo::UpdateInfo &,
+            const gazebo::EntityComponentManager &_ecm)
+        {
+          _ecm.Each<components::Link, components::Name, components::Pose,
+                    components::WorldPose, components::WorldLinearVelocity,
+                    components::WorldAngularVelocity,
+                    components::ParentEntity>(
+              [&](const Entity &, const components::Link *,
+                  const components::Name *_name,
+                  const components::Pose *_pose,
+                  const components::WorldPose *_worldPose,
+                  const components::WorldLinearVelocity *_linVel,
+                  const components::WorldAngularVelocity *_angVel,
+                  const components::ParentEntity *_parent) -> bool
+              {
+                if (_name->Data() != "arm")
+                  return true;
+
+                auto modelName =
+                    _ecm.Component<components::Name>(_parent->Data());
+                auto index = std::stoi(modelName->Data().substr(
+                    std::string("pendulum_").size()));
+                states[index].push_back({_pose->Data(),
+                    _worldPose->Data(), _linVel->Data(), _angVel->Data()});
+                return true;
+              });
+        });
+    server.AddSystem(testSystem.systemPtr);
+    server.Run(true, iterations, false);
+    return states;
+  };
+
+  // A single arm is written back serially. With 80 arms changing on every
+  // step, they're written back by several threads if there are enough
+  // cores.
+  const auto serial = run(1);
+  const auto parallel = run(80);
+
+  ASSERT_EQ(1u, serial.size());
+  ASSERT_EQ(80u, parallel.size());
+  ASSERT_EQ(iterations, serial[0].size());
+
+  // The arm swings
+  EXPECT_NE(serial[0].front().pose, serial[0].back().pose);
+  EXPECT_LT(0.1, serial[0].back().angVel.Length());
+
+  for (std::size_t p = 0; p < parallel.size(); ++p)
+  {
+    ASSERT_EQ(iterations, parallel[p].size()) << p;
+    const math::Vector3d offset(p * spacing, 0, 0);
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      const auto &expected = serial[0][i];
+      const auto &actual = parallel[p][i];
+      EXPECT_EQ(expected.pose, actual.pose) << p << " " << i;
+      EXPECT_EQ(expected.worldPose.Pos() + offset, actual.worldPose.Pos())
+          << p << " " << i;
+      EXPECT_EQ(expected.worldPose.Rot(), actual.worldPose.Rot())
+          << p << " " << i;
+      EXPECT_EQ(expected.linVel, actual.linVel) << p << " " << i;
+      EXPECT_EQ(expected.angVel, actual.angVel) << p << " " << i;
+    }
+  }
+}
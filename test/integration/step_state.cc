@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <ignition/msgs/serialized_map.pb.h>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/World.hh"
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/StepStateClient.hh"
+#include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
+
+#include "../helpers/EnvTestFixture.hh"
+#include "../helpers/Relay.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+class StepState : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+std::string customExecStr(std::string _cmd)
+{
+  _cmd += " 2>&1";
+  FILE *pipe = popen(_cmd.c_str(), "r");
+
+  if (!pipe)
+    return "ERROR";
+
+  char buffer[128];
+  std::string result = "";
+
+  while (!feof(pipe))
+  {
+    if (fgets(buffer, 128, pipe) != nullptr)
+      result += buffer;
+  }
+
+  pclose(pipe);
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepState, IGN_UTILS_TEST_DISABLED_ON_WIN32(StepAndObserve))
+{
+  ServerConfig serverConfig;
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  // Keep track of the iterations which were run and of the world entity
+  uint64_t updates{0u};
+  Entity worldEntity{kNullEntity};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &_info, EntityComponentManager &_ecm)
+    {
+      if (!_info.paused)
+        ++updates;
+      worldEntity = _ecm.EntityByComponents(components::World());
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(false, 0, true);
+
+  // Requests are only accepted once the simulation thread is running
+  for (int sleep = 0; !*server.Running(0) && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(10ms);
+  ASSERT_TRUE(*server.Running(0));
+
+  StepStateClient client("default");
+
+  // Observe without stepping
+  auto res = client.Step(0u);
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(0u, res->stats().iterations());
+  EXPECT_TRUE(res->stats().paused());
+  EXPECT_EQ(0u, updates);
+  ASSERT_NE(kNullEntity, worldEntity);
+  EXPECT_NE(res->state().entities().end(),
+      res->state().entities().find(worldEntity));
+
+  // Step, and simulation is paused again once the reply is received
+  res = client.Step(10u);
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(10u, res->stats().iterations());
+  EXPECT_TRUE(res->stats().paused());
+  EXPECT_EQ(10u, updates);
+
+  res = client.Step(5u);
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(15u, res->stats().iterations());
+  EXPECT_EQ(15u, updates);
+
+  // Filter entities and component types
+  client.SetEntities({worldEntity});
+  client.SetComponentTypes({components::Name::typeId});
+  res = client.Step(1u);
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(16u, res->stats().iterations());
+  ASSERT_EQ(1, res->state().entities().size());
+  const auto &entityMsg = res->state().entities().begin()->second;
+  EXPECT_EQ(worldEntity, entityMsg.id());
+  ASSERT_EQ(1, entityMsg.components().size());
+  EXPECT_EQ(static_cast<int64_t>(components::Name::typeId),
+      entityMsg.components().begin()->second.type());
+
+  // Unknown worlds time out
+  StepStateClient badClient("missing");
+  EXPECT_FALSE(badClient.Step(1u, 200u).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepState, IGN_UTILS_TEST_DISABLED_ON_WIN32(ClientTimeout))
+{
+  ServerConfig serverConfig;
+  Server server(serverConfig);
+
+  // Slow iterations, so the request can't be done in time
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &, EntityComponentManager &)
+    {
+      std::this_thread::sleep_for(5ms);
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(false, 0, true);
+  for (int sleep = 0; !*server.Running(0) && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(10ms);
+  ASSERT_TRUE(*server.Running(0));
+
+  // The server stops stepping once the client gives up, instead of after
+  // its own default timeout
+  StepStateClient client("default");
+  EXPECT_FALSE(client.Step(2000u, 500u).has_value());
+  std::this_thread::sleep_for(500ms);
+  const auto iterations = *server.IterationCount();
+  EXPECT_LT(iterations, 500u);
+  EXPECT_TRUE(*server.Paused());
+
+  // Nothing is left pending
+  std::this_thread::sleep_for(200ms);
+  EXPECT_EQ(iterations, *server.IterationCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepState, IGN_UTILS_TEST_DISABLED_ON_WIN32(NotRunning))
+{
+  ServerConfig serverConfig;
+  Server server(serverConfig);
+
+  // Requests are rejected right away instead of waiting for a run
+  StepStateClient client("default");
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(client.Step(1u, 4000u).has_value());
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 3s);
+
+  // Nothing was left queued for the next run
+  server.Run(true, 5, false);
+  EXPECT_EQ(5u, *server.IterationCount());
+}
+
+/////////////////////////////////////////////////
+// \todo(anyone) Enable tests for OSX once command line works there
+TEST_F(StepState, IGN_UTILS_TEST_DISABLED_ON_MAC(OtherProcess))
+{
+  ServerConfig serverConfig;
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  uint64_t updates{0u};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+    [&](const UpdateInfo &_info, EntityComponentManager &)
+    {
+      if (!_info.paused)
+        ++updates;
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(false, 0, true);
+
+  // Requests are only accepted once the simulation thread is running
+  for (int sleep = 0; !*server.Running(0) && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(10ms);
+  ASSERT_TRUE(*server.Running(0));
+
+  // The service thread waits for the simulation thread while the other
+  // process waits for the reply
+  const std::string cmd =
+      "ign service -s /world/default/control/step_state "
+      "--reqtype ignition.msgs.WorldControlState "
+      "--reptype ignition.msgs.SerializedStepMap "
+      "--timeout 5000 --req 'world_control: {multi_step: 3}'";
+  const auto output = customExecStr(cmd);
+
+  EXPECT_NE(std::string::npos, output.find("iterations: 3")) << output;
+  EXPECT_EQ(3u, updates);
+  EXPECT_TRUE(*server.Running(0));
+}